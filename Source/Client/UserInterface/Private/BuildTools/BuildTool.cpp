@@ -3,6 +3,9 @@
 #include "Network.h"
 #include "Transforms.h"
 #include "SDLHelpers.h"
+#include "TileExtentEdit.h"
+#include <algorithm>
+#include <cstdlib>
 
 namespace AM
 {
@@ -17,6 +20,8 @@ BuildTool::BuildTool(World& inWorld, Network& inNetwork)
 , mouseWorldPoint{}
 , mouseTilePosition{}
 , isActive{false}
+, isDragging{false}
+, dragStartTilePosition{}
 , phantomSprites{}
 , spriteColorMods{}
 {
@@ -80,9 +85,47 @@ void BuildTool::onMouseMove(const SDL_Point& cursorPosition)
 void BuildTool::onMouseLeave()
 {
     isActive = false;
+    isDragging = false;
     phantomSprites.clear();
     spriteColorMods.clear();
 }
 
+void BuildTool::beginDrag()
+{
+    isDragging = true;
+    dragStartTilePosition = mouseTilePosition;
+}
+
+TileExtent BuildTool::endDrag()
+{
+    TileExtent dragExtent{getDragExtent()};
+    isDragging = false;
+
+    return dragExtent;
+}
+
+TileExtent BuildTool::getDragExtent() const
+{
+    // Note: The extent is anchored at the start tile, so the side that gets
+    //       clamped is the one that's furthest from it.
+    constexpr int MAX_LENGTH{TileExtentEdit::MAX_EXTENT_LENGTH};
+    TileExtent dragExtent{dragStartTilePosition.x, dragStartTilePosition.y,
+                          dragStartTilePosition.z, 1, 1, 1};
+
+    int xDistance{mouseTilePosition.x - dragStartTilePosition.x};
+    dragExtent.xLength = std::min((std::abs(xDistance) + 1), MAX_LENGTH);
+    if (xDistance < 0) {
+        dragExtent.x -= (dragExtent.xLength - 1);
+    }
+
+    int yDistance{mouseTilePosition.y - dragStartTilePosition.y};
+    dragExtent.yLength = std::min((std::abs(yDistance) + 1), MAX_LENGTH);
+    if (yDistance < 0) {
+        dragExtent.y -= (dragExtent.yLength - 1);
+    }
+
+    return dragExtent;
+}
+
 } // End namespace Client
 } // End namespace AM
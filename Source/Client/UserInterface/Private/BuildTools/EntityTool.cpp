@@ -4,6 +4,7 @@
 #include "GraphicData.h"
 #include "WorldObjectLocator.h"
 #include "EntityInitRequest.h"
+#include "BulkSpawnRequest.h"
 #include "IsClientEntity.h"
 #include "GraphicState.h"
 #include "QueuedEvents.h"
@@ -87,12 +88,22 @@ void EntityTool::onMouseDown(AUI::MouseButtonType buttonType,
         // If a template is selected in the content panel.
         if (selectedTemplateGraphicState.graphicSetID
             != NULL_ENTITY_GRAPHIC_SET_ID) {
-            // Tell the sim to create an object based on the template.
-            Rotation rotation{static_cast<Rotation::Direction>(
-                validTemplateGraphicIndices.at(selectedTemplateGraphicIndex))};
-            network.serializeAndSend(EntityInitRequest{
-                entt::null, selectedTemplateName, mouseWorldPoint, rotation,
-                selectedTemplateGraphicState});
+            // If shift is held, tell the sim to create a group of
+            // lookalikes with the template's name and graphic state. If ctrl
+            // is also held, the group will walk around.
+            SDL_Keymod modState{SDL_GetModState()};
+            if (modState & KMOD_SHIFT) {
+                requestLookalikeSpawn((modState & KMOD_CTRL) != 0);
+            }
+            else {
+                // Tell the sim to create an object based on the template.
+                Rotation rotation{static_cast<Rotation::Direction>(
+                    validTemplateGraphicIndices.at(
+                        selectedTemplateGraphicIndex))};
+                network.serializeAndSend(EntityInitRequest{
+                    entt::null, selectedTemplateName, mouseWorldPoint,
+                    rotation, selectedTemplateGraphicState});
+            }
 
             // To deter users from placing a million entities, we deselect after
             // placement. This also makes it faster if the user's next goal is
@@ -196,6 +207,36 @@ void EntityTool::onMouseLeave()
     }
 }
 
+void EntityTool::requestLookalikeSpawn(bool addRandomWalkerAI)
+{
+    // Scatter the group around the clicked tile, staying within the map.
+    TileExtent spawnExtent{(mouseTilePosition.x - BULK_SPAWN_RADIUS),
+                           (mouseTilePosition.y - BULK_SPAWN_RADIUS),
+                           mouseTilePosition.z,
+                           ((BULK_SPAWN_RADIUS * 2) + 1),
+                           ((BULK_SPAWN_RADIUS * 2) + 1),
+                           1};
+    spawnExtent.intersectWith(mapTileExtent);
+
+    BulkSpawnRequest bulkSpawnRequest{};
+    bulkSpawnRequest.name = selectedTemplateName;
+    bulkSpawnRequest.graphicState = selectedTemplateGraphicState;
+    bulkSpawnRequest.tileExtent = spawnExtent;
+    bulkSpawnRequest.spawnCount = BULK_SPAWN_COUNT;
+
+    // Note: The server doesn't run templates' init scripts for bulk spawned
+    //       entities, so the user picks whether the group gets a default
+    //       random walker behavior.
+    if (addRandomWalkerAI) {
+        bulkSpawnRequest.addRandomWalkerAI = true;
+        bulkSpawnRequest.timeToWalk = 2;
+        bulkSpawnRequest.timeToWait = 2;
+        bulkSpawnRequest.timeTillDirectionChange = 1;
+    }
+
+    network.serializeAndSend(bulkSpawnRequest);
+}
+
 void EntityTool::trySelectEntity(entt::entity entity)
 {
     // If this isn't a client entity and it isn't already selected, select it.
@@ -2,6 +2,7 @@
 #include "World.h"
 #include "Network.h"
 #include "TileAddLayer.h"
+#include "TileExtentEdit.h"
 #include "QueuedEvents.h"
 
 namespace AM
@@ -46,11 +47,40 @@ void FloorTool::onMouseDown(AUI::MouseButtonType buttonType, const SDL_Point&)
     // graphic.
     if (isActive && (buttonType == AUI::MouseButtonType::Left)
         && (selectedGraphicSet != nullptr)) {
-        // Tell the server to add the layer.
+        // Start dragging. The layers are added when the mouse is released.
+        beginDrag();
+    }
+}
+
+void FloorTool::onMouseUp(AUI::MouseButtonType buttonType, const SDL_Point&)
+{
+    // If we aren't dragging or it wasn't a left click, do nothing.
+    if (!isDragging || (buttonType != AUI::MouseButtonType::Left)
+        || (selectedGraphicSet == nullptr)) {
+        return;
+    }
+
+    TileExtent dragExtent{endDrag()};
+    Uint8 graphicValue{
+        static_cast<Uint8>(validGraphicIndices[selectedGraphicIndex])};
+    if ((dragExtent.xLength == 1) && (dragExtent.yLength == 1)) {
+        // Single tile. Tell the server to add the layer.
         network.serializeAndSend(TileAddLayer{
-            mouseTilePosition, selectedTileOffset, TileLayer::Type::Floor,
-            selectedGraphicSet->numericID,
-            static_cast<Uint8>(validGraphicIndices[selectedGraphicIndex])});
+            dragStartTilePosition, selectedTileOffset, TileLayer::Type::Floor,
+            selectedGraphicSet->numericID, graphicValue});
+    }
+    else {
+        // Tell the server to add the layer to the whole extent.
+        network.serializeAndSend(TileExtentEdit{
+            TileExtentEdit::Operation::AddLayer, dragExtent,
+            selectedTileOffset, TileLayer::Type::Floor,
+            selectedGraphicSet->numericID, graphicValue});
+    }
+
+    // Reset the phantoms to the single hovered tile.
+    phantomSprites.clear();
+    if (isActive) {
+        addPhantoms();
     }
 }
 
@@ -85,10 +115,7 @@ void FloorTool::onMouseWheel(int amountScrolled)
 
     // Set the newly selected graphic as a phantom at the current location.
     phantomSprites.clear();
-    phantomSprites.emplace_back(
-        mouseTilePosition, selectedTileOffset, TileLayer::Type::Floor,
-        Wall::Type::None, Position{}, selectedGraphicSet,
-        static_cast<Uint8>(validGraphicIndices[selectedGraphicIndex]));
+    addPhantoms();
 }
 
 void FloorTool::onMouseMove(const SDL_Point& cursorPosition)
@@ -138,7 +165,8 @@ void FloorTool::onMouseMove(const SDL_Point& cursorPosition)
 
         // If our tile position changed, default our Z offset to line up with 
         // the new tile.
-        if (mouseTilePosition != oldMouseTilePosition) {
+        // Note: While dragging, we keep the offset from the start tile.
+        if (!isDragging && (mouseTilePosition != oldMouseTilePosition)) {
             // First reset the Z offset, in case the new tile doesn't exist 
             // or it doesn't have a terrain layer.
             selectedTileOffset.z = 0;
@@ -156,10 +184,30 @@ void FloorTool::onMouseMove(const SDL_Point& cursorPosition)
     }
 
     // Set the selected sprite as a phantom at the new location.
-    phantomSprites.emplace_back(
-        mouseTilePosition, selectedTileOffset, TileLayer::Type::Floor,
-        Wall::Type::None, Position{}, selectedGraphicSet,
-        static_cast<Uint8>(validGraphicIndices[selectedGraphicIndex]));
+    addPhantoms();
+}
+
+void FloorTool::addPhantoms()
+{
+    Uint8 graphicValue{
+        static_cast<Uint8>(validGraphicIndices[selectedGraphicIndex])};
+    if (!isDragging) {
+        phantomSprites.emplace_back(
+            mouseTilePosition, selectedTileOffset, TileLayer::Type::Floor,
+            Wall::Type::None, Position{}, selectedGraphicSet, graphicValue);
+        return;
+    }
+
+    TileExtent dragExtent{getDragExtent()};
+    for (int y{dragExtent.y}; y < (dragExtent.y + dragExtent.yLength); ++y) {
+        for (int x{dragExtent.x}; x < (dragExtent.x + dragExtent.xLength);
+             ++x) {
+            phantomSprites.emplace_back(
+                TilePosition{x, y, dragExtent.z}, selectedTileOffset,
+                TileLayer::Type::Floor, Wall::Type::None, Position{},
+                selectedGraphicSet, graphicValue);
+        }
+    }
 }
 
 } // End namespace Client
@@ -19,6 +19,7 @@ RemoveTool::RemoveTool(World& inWorld,
 : BuildTool(inWorld, inNetwork)
 , worldObjectLocator{inWorldObjectLocator}
 , highlightColor{255, 220, 0, 255}
+, dragEdit{}
 {
 }
 
@@ -34,28 +35,64 @@ void RemoveTool::onMouseDown(AUI::MouseButtonType buttonType,
             worldObjectLocator.getObjectUnderPoint(cursorPosition)};
 
         // If we hit a removable object, tell the sim to remove it.
+        // Note: Objects and entities are removed immediately. Other tile
+        //       layers start a drag, and are removed when it ends.
         if (TileLayerID* layer{std::get_if<TileLayerID>(&objectID)}) {
-            requestRemoveTileLayer(layer->tilePosition, layer->tileOffset,
-                                   layer->type, layer->graphicSetID,
-                                   layer->graphicValue);
+            if (layer->type == TileLayer::Type::Object) {
+                requestRemoveTileLayer(layer->tilePosition, layer->tileOffset,
+                                       layer->type, layer->graphicSetID,
+                                       layer->graphicValue);
+                return;
+            }
+
+            // If the layer can't be removed directly, do nothing.
+            Uint8 graphicValue{layer->graphicValue};
+            if (!toRemovedGraphicValue(layer->type, graphicValue)) {
+                return;
+            }
+
+            // Start the drag on the layer's tile.
+            beginDrag();
+            dragStartTilePosition = layer->tilePosition;
+            dragEdit = {TileExtentEdit::Operation::RemoveLayer, TileExtent{},
+                        layer->tileOffset, layer->type, layer->graphicSetID,
+                        graphicValue};
         }
         else if (entt::entity* entity{std::get_if<entt::entity>(&objectID)}) {
             network.serializeAndSend(EntityDeleteRequest{*entity});
         }
         else {
-            // Didn't hit a removable object, must be terrain. Tell the sim to 
+            // Didn't hit a removable object, must be terrain. Start a drag to
             // remove the terrain.
-            network.serializeAndSend(
-                TileRemoveLayer{mouseTilePosition, TileOffset{},
-                                TileLayer::Type::Terrain, 0, 0});
+            beginDrag();
+            dragEdit = {TileExtentEdit::Operation::RemoveLayer, TileExtent{},
+                        TileOffset{}, TileLayer::Type::Terrain, 0, 0};
         }
     }
 }
 
-void RemoveTool::onMouseUp(AUI::MouseButtonType, const SDL_Point&)
+void RemoveTool::onMouseUp(AUI::MouseButtonType buttonType, const SDL_Point&)
 {
-    // TODO: Add support for click-and-drag to remove an extent instead of a
-    //       single layer.
+    // If we aren't dragging or it wasn't a left click, do nothing.
+    if (!isDragging || (buttonType != AUI::MouseButtonType::Left)) {
+        return;
+    }
+
+    dragEdit.tileExtent = getRemoveExtent();
+    endDrag();
+    if ((dragEdit.tileExtent.xLength == 1)
+        && (dragEdit.tileExtent.yLength == 1)) {
+        // Single tile. Tell the sim to remove the layer.
+        requestRemoveTileLayer(dragStartTilePosition, dragEdit.tileOffset,
+                               dragEdit.layerType, dragEdit.graphicSetID,
+                               dragEdit.graphicValue);
+    }
+    else {
+        // Tell the sim to remove the layer from the whole extent.
+        network.serializeAndSend(dragEdit);
+    }
+
+    spriteColorMods.clear();
 }
 
 void RemoveTool::onMouseDoubleClick(AUI::MouseButtonType buttonType,
@@ -75,6 +112,13 @@ void RemoveTool::onMouseMove(const SDL_Point& cursorPosition)
         // Clear any old color mods.
         spriteColorMods.clear();
 
+        // If we're dragging, highlight the dragged layer instead of the
+        // hovered object.
+        if (isDragging) {
+            addDragColorMods();
+            return;
+        }
+
         // Get the first world object under the mouse.
         WorldObjectID objectID{
             worldObjectLocator.getObjectUnderPoint(cursorPosition)};
@@ -102,27 +146,88 @@ void RemoveTool::requestRemoveTileLayer(const TilePosition& tilePosition,
                                         TileLayer::Type layerType,
                                         Uint16 graphicSetID, Uint8 graphicIndex)
 {
-    if (layerType == TileLayer::Type::Wall) {
-        Wall::Type wallType{graphicIndex};
+    // If the layer can't be removed directly, do nothing.
+    if (!toRemovedGraphicValue(layerType, graphicIndex)) {
+        return;
+    }
 
-        // Ignore NW gap fills (they'll be removed when one of the adjoined
-        // walls is removed.
-        if (wallType == Wall::Type::NorthWestGapFill) {
-            return;
-        }
+    network.serializeAndSend(TileRemoveLayer{tilePosition, tileOffset,
+                                             layerType, graphicSetID,
+                                             graphicIndex});
+}
 
-        // If it's a NE gap fill, push a North instead (the tile map handles
-        // gap fills).
-        if (wallType == Wall::Type::NorthEastGapFill) {
-            wallType = Wall::Type::North;
-        }
+bool RemoveTool::toRemovedGraphicValue(TileLayer::Type layerType,
+                                       Uint8& graphicValue)
+{
+    if (layerType != TileLayer::Type::Wall) {
+        return true;
+    }
 
-        network.serializeAndSend(TileRemoveLayer{
-            tilePosition, tileOffset, layerType, graphicSetID, wallType});
+    // Ignore NW gap fills (they'll be removed when one of the adjoined walls
+    // is removed).
+    if (graphicValue == Wall::Type::NorthWestGapFill) {
+        return false;
     }
-    else {
-        network.serializeAndSend(TileRemoveLayer{
-            tilePosition, tileOffset, layerType, graphicSetID, graphicIndex});
+
+    // If it's a NE gap fill, request a North instead (the tile map handles
+    // gap fills).
+    if (graphicValue == Wall::Type::NorthEastGapFill) {
+        graphicValue = Wall::Type::North;
+    }
+
+    return true;
+}
+
+TileExtent RemoveTool::getRemoveExtent() const
+{
+    TileExtent removeExtent{getDragExtent()};
+    if (dragEdit.layerType == TileLayer::Type::Wall) {
+        // North walls form rows, and West walls form columns.
+        if (dragEdit.graphicValue == Wall::Type::North) {
+            removeExtent.y = dragStartTilePosition.y;
+            removeExtent.yLength = 1;
+        }
+        else {
+            removeExtent.x = dragStartTilePosition.x;
+            removeExtent.xLength = 1;
+        }
+    }
+
+    return removeExtent;
+}
+
+void RemoveTool::addDragColorMods()
+{
+    TileExtent removeExtent{getRemoveExtent()};
+    for (int y{removeExtent.y}; y < (removeExtent.y + removeExtent.yLength);
+         ++y) {
+        for (int x{removeExtent.x};
+             x < (removeExtent.x + removeExtent.xLength); ++x) {
+            TileLayerID layerID{};
+            layerID.tilePosition = {x, y, removeExtent.z};
+            layerID.tileOffset = dragEdit.tileOffset;
+            layerID.type = dragEdit.layerType;
+            layerID.graphicSetID = dragEdit.graphicSetID;
+            layerID.graphicValue = dragEdit.graphicValue;
+
+            // Terrain is removed regardless of its graphic, so match the
+            // highlight to whatever terrain is on the tile.
+            if (dragEdit.layerType == TileLayer::Type::Terrain) {
+                const Tile* tile{world.tileMap.cgetTile(layerID.tilePosition)};
+                const TileLayer* terrain{
+                    tile ? tile->findLayer(TileLayer::Type::Terrain)
+                         : nullptr};
+                if (!terrain) {
+                    continue;
+                }
+                layerID.graphicSetID = terrain->graphicSet.get().numericID;
+                layerID.graphicValue = terrain->graphicValue;
+            }
+
+            // Note: If the layer isn't on the tile, this is still safe (the
+            //       color mod just won't be used).
+            spriteColorMods.emplace_back(layerID, highlightColor);
+        }
     }
 }
 
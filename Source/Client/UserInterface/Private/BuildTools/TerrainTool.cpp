@@ -2,6 +2,7 @@
 #include "World.h"
 #include "Network.h"
 #include "TileAddLayer.h"
+#include "TileExtentEdit.h"
 #include "QueuedEvents.h"
 #include "AMAssert.h"
 
@@ -48,13 +49,39 @@ void TerrainTool::onMouseDown(AUI::MouseButtonType buttonType,
     // graphic.
     if (isActive && (buttonType == AUI::MouseButtonType::Left)
         && (selectedGraphicSet != nullptr)) {
-        // Tell the sim to add the layer.
-        Terrain::Height height{
-            static_cast<Terrain::Height>(validHeights[selectedHeightIndex])};
+        // Start dragging. The layers are added when the mouse is released.
+        beginDrag();
+    }
+}
+
+void TerrainTool::onMouseUp(AUI::MouseButtonType buttonType,
+                            const SDL_Point&)
+{
+    // If we aren't dragging or it wasn't a left click, do nothing.
+    if (!isDragging || (buttonType != AUI::MouseButtonType::Left)
+        || (selectedGraphicSet == nullptr)) {
+        return;
+    }
+
+    TileExtent dragExtent{endDrag()};
+    if ((dragExtent.xLength == 1) && (dragExtent.yLength == 1)) {
+        // Single tile. Tell the sim to add the layer.
         network.serializeAndSend(TileAddLayer{
-            mouseTilePosition, TileOffset{}, TileLayer::Type::Terrain,
-            selectedGraphicSet->numericID,
-            Terrain::toValue(height, selectedStartHeight)});
+            dragStartTilePosition, TileOffset{}, TileLayer::Type::Terrain,
+            selectedGraphicSet->numericID, getSelectedValue()});
+    }
+    else {
+        // Tell the sim to add the layer to the whole extent.
+        network.serializeAndSend(TileExtentEdit{
+            TileExtentEdit::Operation::AddLayer, dragExtent, TileOffset{},
+            TileLayer::Type::Terrain, selectedGraphicSet->numericID,
+            getSelectedValue()});
+    }
+
+    // Reset the phantoms to the single hovered tile.
+    phantomSprites.clear();
+    if (isActive) {
+        addPhantoms();
     }
 }
 
@@ -103,14 +130,8 @@ void TerrainTool::onMouseWheel(int amountScrolled)
     }
 
     // Set the newly selected graphic as a phantom at the current location.
-    Terrain::Value value{Terrain::toValue(
-        static_cast<Terrain::Height>(validHeights[selectedHeightIndex]),
-        selectedStartHeight)};
     phantomSprites.clear();
-    phantomSprites.emplace_back(mouseTilePosition, TileOffset{},
-                                TileLayer::Type::Terrain, Wall::Type::None,
-                                Position{}, selectedGraphicSet,
-                                static_cast<Uint8>(value));
+    addPhantoms();
 }
 
 void TerrainTool::onMouseMove(const SDL_Point& cursorPosition)
@@ -124,13 +145,36 @@ void TerrainTool::onMouseMove(const SDL_Point& cursorPosition)
     // If this tool is active and we have a selected sprite.
     if (isActive && (selectedGraphicSet != nullptr)) {
         // Set the selected graphic as a phantom at the new location.
-        Terrain::Value value{Terrain::toValue(
-            static_cast<Terrain::Height>(validHeights[selectedHeightIndex]),
-            selectedStartHeight)};
+        addPhantoms();
+    }
+}
+
+Terrain::Value TerrainTool::getSelectedValue() const
+{
+    return Terrain::toValue(
+        static_cast<Terrain::Height>(validHeights[selectedHeightIndex]),
+        selectedStartHeight);
+}
+
+void TerrainTool::addPhantoms()
+{
+    Uint8 value{static_cast<Uint8>(getSelectedValue())};
+    if (!isDragging) {
         phantomSprites.emplace_back(mouseTilePosition, TileOffset{},
                                     TileLayer::Type::Terrain, Wall::Type::None,
-                                    Position{}, selectedGraphicSet,
-                                    static_cast<Uint8>(value));
+                                    Position{}, selectedGraphicSet, value);
+        return;
+    }
+
+    TileExtent dragExtent{getDragExtent()};
+    for (int y{dragExtent.y}; y < (dragExtent.y + dragExtent.yLength); ++y) {
+        for (int x{dragExtent.x}; x < (dragExtent.x + dragExtent.xLength);
+             ++x) {
+            phantomSprites.emplace_back(
+                TilePosition{x, y, dragExtent.z}, TileOffset{},
+                TileLayer::Type::Terrain, Wall::Type::None, Position{},
+                selectedGraphicSet, value);
+        }
     }
 }
 
@@ -2,6 +2,7 @@
 #include "World.h"
 #include "Network.h"
 #include "TileAddLayer.h"
+#include "TileExtentEdit.h"
 #include "Transforms.h"
 #include "QueuedEvents.h"
 #include <cmath>
@@ -32,46 +33,39 @@ void WallTool::onMouseDown(AUI::MouseButtonType buttonType, const SDL_Point&)
     // graphic.
     if (isActive && (buttonType == AUI::MouseButtonType::Left)
         && (selectedGraphicSet != nullptr)) {
-        // Iterate the phantom tiles and tell the sim to add them for real.
-        for (const auto& phantomInfo : phantomSprites) {
-            // Skip NorthWest gap fills since the tile map will auto-add them.
-            if ((phantomInfo.wallType == Wall::Type::NorthWestGapFill)) {
-                continue;
-            }
-
-            // We don't want to push NE fills when adding West walls (the map
-            // will auto-add them). But we do want to push them when adding
-            // North walls (to tiles with a West wall).
-            Wall::Type wallType{phantomInfo.wallType};
-            if (phantomInfo.wallType == Wall::Type::NorthEastGapFill) {
-                // Check if there's a phantom West wall.
-                auto it = std::find_if(
-                    phantomSprites.begin(), phantomSprites.end(),
-                    [](const auto& phantomInfo) {
-                        return phantomInfo.wallType == Wall::Type::West;
-                    });
-                if (it != phantomSprites.end()) {
-                    // Found a West wall, skip this NorthEast phantom.
-                    continue;
-                }
-                else {
-                    // No West wall, push a North (the map will handle turnin
-                    // it into a NorthEast fill).
-                    wallType = Wall::Type::North;
-                }
-            }
-
-            network.serializeAndSend(TileAddLayer{
-                phantomInfo.tilePosition, TileOffset{}, TileLayer::Type::Wall,
-                selectedGraphicSet->numericID, wallType});
-        }
+        // Start dragging. The walls are added when the mouse is released.
+        beginDrag();
     }
 }
 
-void WallTool::onMouseUp(AUI::MouseButtonType, const SDL_Point&)
+void WallTool::onMouseUp(AUI::MouseButtonType buttonType, const SDL_Point&)
 {
-    // TODO: Add support for click-and-drag to set an extent instead of a
-    //       single tile.
+    // If we aren't dragging or it wasn't a left click, do nothing.
+    if (!isDragging || (buttonType != AUI::MouseButtonType::Left)
+        || (selectedGraphicSet == nullptr)) {
+        return;
+    }
+
+    TileExtent dragExtent{endDrag()};
+    if ((dragExtent.xLength == 1) && (dragExtent.yLength == 1)) {
+        // Single tile. Add the phantom walls that the user is looking at.
+        requestPhantomWalls();
+    }
+    else {
+        // Tell the sim to add the whole line of walls.
+        Wall::Type wallType{Wall::Type::None};
+        TileExtent wallLine{getWallLine(dragExtent, wallType)};
+        network.serializeAndSend(TileExtentEdit{
+            TileExtentEdit::Operation::AddLayer, wallLine, TileOffset{},
+            TileLayer::Type::Wall, selectedGraphicSet->numericID,
+            static_cast<Uint8>(wallType)});
+
+        // Reset the phantoms to the single hovered tile.
+        phantomSprites.clear();
+        if (isActive) {
+            addPhantomWalls();
+        }
+    }
 }
 
 void WallTool::onMouseDoubleClick(AUI::MouseButtonType buttonType,
@@ -91,8 +85,81 @@ void WallTool::onMouseMove(const SDL_Point& cursorPosition)
 
     // If this tool is active and we have a selected graphic.
     if (isActive && selectedGraphicSet) {
-        // Add the appropriate phantom walls.
-        addPhantomWalls();
+        // If we're dragging over more than 1 tile, add a line of walls.
+        // Otherwise, add the appropriate phantom walls for this tile.
+        TileExtent dragExtent{getDragExtent()};
+        if (isDragging
+            && ((dragExtent.xLength > 1) || (dragExtent.yLength > 1))) {
+            addPhantomWallLine();
+        }
+        else {
+            addPhantomWalls();
+        }
+    }
+}
+
+void WallTool::requestPhantomWalls()
+{
+    // Iterate the phantom tiles and tell the sim to add them for real.
+    for (const auto& phantomInfo : phantomSprites) {
+        // Skip NorthWest gap fills since the tile map will auto-add them.
+        if ((phantomInfo.wallType == Wall::Type::NorthWestGapFill)) {
+            continue;
+        }
+
+        // We don't want to push NE fills when adding West walls (the map
+        // will auto-add them). But we do want to push them when adding
+        // North walls (to tiles with a West wall).
+        Wall::Type wallType{phantomInfo.wallType};
+        if (phantomInfo.wallType == Wall::Type::NorthEastGapFill) {
+            // Check if there's a phantom West wall.
+            auto it = std::find_if(
+                phantomSprites.begin(), phantomSprites.end(),
+                [](const auto& phantomInfo) {
+                    return phantomInfo.wallType == Wall::Type::West;
+                });
+            if (it != phantomSprites.end()) {
+                // Found a West wall, skip this NorthEast phantom.
+                continue;
+            }
+            else {
+                // No West wall, push a North (the map will handle turnin
+                // it into a NorthEast fill).
+                wallType = Wall::Type::North;
+            }
+        }
+
+        network.serializeAndSend(TileAddLayer{
+            phantomInfo.tilePosition, TileOffset{}, TileLayer::Type::Wall,
+            selectedGraphicSet->numericID, wallType});
+    }
+}
+
+TileExtent WallTool::getWallLine(const TileExtent& dragExtent,
+                                 Wall::Type& outWallType) const
+{
+    // If the drag is wider than it is tall, it's a row of North walls.
+    // Otherwise, it's a column of West walls.
+    if (dragExtent.xLength >= dragExtent.yLength) {
+        outWallType = Wall::Type::North;
+        return {dragExtent.x, dragStartTilePosition.y, dragExtent.z,
+                dragExtent.xLength, 1, 1};
+    }
+    else {
+        outWallType = Wall::Type::West;
+        return {dragStartTilePosition.x, dragExtent.y, dragExtent.z, 1,
+                dragExtent.yLength, 1};
+    }
+}
+
+void WallTool::addPhantomWallLine()
+{
+    Wall::Type wallType{Wall::Type::None};
+    TileExtent wallLine{getWallLine(getDragExtent(), wallType)};
+    for (int y{wallLine.y}; y < (wallLine.y + wallLine.yLength); ++y) {
+        for (int x{wallLine.x}; x < (wallLine.x + wallLine.xLength); ++x) {
+            pushPhantomWall({x, y, wallLine.z}, wallType, *selectedGraphicSet);
+        }
     }
 }
 
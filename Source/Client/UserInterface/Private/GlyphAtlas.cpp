@@ -0,0 +1,286 @@
+#include "GlyphAtlas.h"
+#include "PerformanceProfiler.h"
+#include "AUI/ScalingHelpers.h"
+#include "Log.h"
+#include <SDL_render.h>
+#include <SDL_ttf.h>
+#include <algorithm>
+
+namespace AM
+{
+namespace Client
+{
+GlyphAtlas::GlyphAtlas(SDL_Renderer* inSdlRenderer,
+                       const std::string& inFontPath, int inLogicalFontSize)
+: sdlRenderer{inSdlRenderer}
+, fontPath{inFontPath}
+, logicalFontSize{inLogicalFontSize}
+, actualFontSize{0}
+, font{nullptr}
+, lineHeight{0}
+, asciiGlyphs{}
+, extraGlyphs{}
+, nextPosition{0, 0}
+, rowHeight{0}
+, atlasSurface{nullptr}
+, texture{nullptr}
+, textureHeight{0}
+{
+    refresh();
+}
+
+GlyphAtlas::~GlyphAtlas()
+{
+    if (font != nullptr) {
+        TTF_CloseFont(font);
+    }
+}
+
+bool GlyphAtlas::refresh()
+{
+    // If we're already rasterized at the current scale, do nothing.
+    int newFontSize{AUI::ScalingHelpers::logicalToActual(logicalFontSize)};
+    if (texture && (newFontSize == actualFontSize)) {
+        return false;
+    }
+
+    if (font != nullptr) {
+        TTF_CloseFont(font);
+    }
+    font = TTF_OpenFont(fontPath.c_str(), newFontSize);
+    if (font == nullptr) {
+        LOG_FATAL("Failed to open font: %s", TTF_GetError());
+    }
+    lineHeight = TTF_FontLineSkip(font);
+
+    // Start a new, empty atlas. We'll create the texture once the ASCII
+    // glyphs are packed, instead of uploading them one at a time.
+    texture = nullptr;
+    textureHeight = 0;
+    atlasSurface = nullptr;
+    nextPosition = {0, 0};
+    rowHeight = 0;
+    extraGlyphs.clear();
+    if (!growAtlasSurface(lineHeight)) {
+        LOG_FATAL("Font is too large for the glyph atlas.");
+    }
+
+    // Rasterize each printable ASCII glyph.
+    for (std::size_t i{0}; i < ASCII_GLYPH_COUNT; ++i) {
+        Uint32 character{static_cast<Uint32>(FIRST_CHARACTER + i)};
+        if (!rasterizeGlyph(character, asciiGlyphs[i])) {
+            asciiGlyphs[i] = {};
+        }
+    }
+
+    createTexture();
+    actualFontSize = newFontSize;
+
+    return true;
+}
+
+const GlyphAtlas::Glyph& GlyphAtlas::getGlyph(Uint32 codepoint)
+{
+    static constexpr Uint32 FIRST{static_cast<Uint32>(FIRST_CHARACTER)};
+    static constexpr Uint32 LAST{static_cast<Uint32>(LAST_CHARACTER)};
+    const Glyph& fallbackGlyph{asciiGlyphs['?' - FIRST_CHARACTER]};
+    if ((codepoint >= FIRST) && (codepoint <= LAST)) {
+        return asciiGlyphs[codepoint - FIRST];
+    }
+
+    // If we've already handled this codepoint, return it.
+    auto glyphIt{extraGlyphs.find(codepoint)};
+    if (glyphIt != extraGlyphs.end()) {
+        return glyphIt->second;
+    }
+
+    // Try to add it to the atlas. If we can't, remember the fallback.
+    // Note: unordered_map references stay valid as elements are added.
+    Glyph glyph{};
+    if (!rasterizeGlyph(codepoint, glyph)) {
+        glyph = fallbackGlyph;
+    }
+
+    return extraGlyphs.emplace(codepoint, glyph).first->second;
+}
+
+int GlyphAtlas::getLineHeight() const
+{
+    return lineHeight;
+}
+
+SDL_Texture* GlyphAtlas::getTexture() const
+{
+    return texture.get();
+}
+
+Uint32 GlyphAtlas::decodeUtf8(std::string_view text, std::size_t& index)
+{
+    auto byteAt = [&](std::size_t byteIndex) {
+        return static_cast<Uint32>(static_cast<unsigned char>(text[byteIndex]));
+    };
+
+    // Determine the sequence's length and the lead byte's payload.
+    Uint32 leadByte{byteAt(index)};
+    std::size_t length{0};
+    Uint32 codepoint{0};
+    if (leadByte < 0x80) {
+        index++;
+        return leadByte;
+    }
+    else if ((leadByte & 0xE0) == 0xC0) {
+        length = 2;
+        codepoint = (leadByte & 0x1F);
+    }
+    else if ((leadByte & 0xF0) == 0xE0) {
+        length = 3;
+        codepoint = (leadByte & 0x0F);
+    }
+    else if ((leadByte & 0xF8) == 0xF0) {
+        length = 4;
+        codepoint = (leadByte & 0x07);
+    }
+    else {
+        index++;
+        return REPLACEMENT_CHARACTER;
+    }
+
+    // Add each continuation byte's payload.
+    if ((index + length) > text.size()) {
+        index++;
+        return REPLACEMENT_CHARACTER;
+    }
+    for (std::size_t i{1}; i < length; ++i) {
+        Uint32 continuationByte{byteAt(index + i)};
+        if ((continuationByte & 0xC0) != 0x80) {
+            index++;
+            return REPLACEMENT_CHARACTER;
+        }
+        codepoint = (codepoint << 6) | (continuationByte & 0x3F);
+    }
+
+    // Reject overlong encodings, surrogates, and out-of-range values.
+    static constexpr Uint32 MIN_CODEPOINTS[5]{0, 0, 0x80, 0x800, 0x10000};
+    if ((codepoint < MIN_CODEPOINTS[length])
+        || ((codepoint >= 0xD800) && (codepoint <= 0xDFFF))
+        || (codepoint > 0x10FFFF)) {
+        index++;
+        return REPLACEMENT_CHARACTER;
+    }
+
+    index += length;
+    return codepoint;
+}
+
+bool GlyphAtlas::rasterizeGlyph(Uint32 codepoint, Glyph& outGlyph)
+{
+    if (!TTF_GlyphIsProvided32(font, codepoint)) {
+        return false;
+    }
+
+    int advance{0};
+    TTF_GlyphMetrics32(font, codepoint, nullptr, nullptr, nullptr, nullptr,
+                       &advance);
+
+    // Note: Glyphs without any pixels (e.g. space) still get an advance.
+    SDL_Surface* glyphSurface{
+        TTF_RenderGlyph32_Blended(font, codepoint, {255, 255, 255, 255})};
+    if (glyphSurface == nullptr) {
+        outGlyph = {{0, 0, 0, 0}, advance};
+        return true;
+    }
+
+    // If this glyph doesn't fit in the current row, start a new one.
+    if ((nextPosition.x + glyphSurface->w) > MAX_ATLAS_WIDTH) {
+        nextPosition.x = 0;
+        nextPosition.y += rowHeight;
+        rowHeight = 0;
+    }
+
+    // If the glyph doesn't fit in the surface, grow it.
+    int glyphBottom{nextPosition.y + glyphSurface->h};
+    if ((glyphSurface->w > MAX_ATLAS_WIDTH)
+        || ((glyphBottom > atlasSurface->h)
+            && !growAtlasSurface(glyphBottom))) {
+        SDL_FreeSurface(glyphSurface);
+        return false;
+    }
+
+    // Copy the glyph into the atlas.
+    // Note: Blending is disabled so the glyph's alpha is copied as-is,
+    //       instead of being blended onto the empty atlas.
+    SDL_Rect sourceExtent{nextPosition.x, nextPosition.y, glyphSurface->w,
+                          glyphSurface->h};
+    SDL_SetSurfaceBlendMode(glyphSurface, SDL_BLENDMODE_NONE);
+    SDL_BlitSurface(glyphSurface, nullptr, atlasSurface.get(), &sourceExtent);
+    SDL_FreeSurface(glyphSurface);
+
+    outGlyph = {sourceExtent, advance};
+    nextPosition.x += sourceExtent.w;
+    rowHeight = std::max(rowHeight, sourceExtent.h);
+
+    // If we have a texture, upload the glyph to it. If the surface has
+    // outgrown it, re-create it.
+    if (texture) {
+        if (atlasSurface->h > textureHeight) {
+            createTexture();
+        }
+        else {
+            const Uint8* pixels{static_cast<const Uint8*>(atlasSurface->pixels)
+                                + (sourceExtent.y * atlasSurface->pitch)
+                                + (sourceExtent.x * 4)};
+            SDL_UpdateTexture(texture.get(), &sourceExtent, pixels,
+                              atlasSurface->pitch);
+        }
+    }
+
+    return true;
+}
+
+bool GlyphAtlas::growAtlasSurface(int minHeight)
+{
+    if (minHeight > MAX_ATLAS_HEIGHT) {
+        return false;
+    }
+
+    // Double the height, so growing is rare.
+    int oldHeight{atlasSurface ? atlasSurface->h : 0};
+    int newHeight{std::clamp(std::max(minHeight, (oldHeight * 2)), 1,
+                             MAX_ATLAS_HEIGHT)};
+    SDL_Surface* rawSurface{SDL_CreateRGBSurfaceWithFormat(
+        0, MAX_ATLAS_WIDTH, newHeight, 32, SDL_PIXELFORMAT_ARGB8888)};
+    if (rawSurface == nullptr) {
+        LOG_FATAL("Failed to create surface: %s", SDL_GetError());
+    }
+
+    if (atlasSurface) {
+        SDL_SetSurfaceBlendMode(atlasSurface.get(), SDL_BLENDMODE_NONE);
+        SDL_BlitSurface(atlasSurface.get(), nullptr, rawSurface, nullptr);
+    }
+    atlasSurface = std::shared_ptr<SDL_Surface>(
+        rawSurface, [](SDL_Surface* p) { SDL_FreeSurface(p); });
+
+    return true;
+}
+
+void GlyphAtlas::createTexture()
+{
+    // Note: We use the surface's format, so rasterizeGlyph() can upload
+    //       glyphs straight from the surface.
+    SDL_Texture* rawTexture{SDL_CreateTexture(
+        sdlRenderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC,
+        atlasSurface->w, atlasSurface->h)};
+    if (rawTexture == nullptr) {
+        LOG_FATAL("Failed to create texture: %s", SDL_GetError());
+    }
+    PerformanceProfiler::countTextureCreation();
+    texture = std::shared_ptr<SDL_Texture>(
+        rawTexture, [](SDL_Texture* p) { SDL_DestroyTexture(p); });
+    SDL_UpdateTexture(texture.get(), nullptr, atlasSurface->pixels,
+                      atlasSurface->pitch);
+    SDL_SetTextureBlendMode(texture.get(), SDL_BLENDMODE_BLEND);
+    textureHeight = atlasSurface->h;
+}
+
+} // End namespace Client
+} // End namespace AM
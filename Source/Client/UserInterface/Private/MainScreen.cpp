@@ -17,27 +17,33 @@ namespace AM
 {
 namespace Client
 {
-MainScreen::MainScreen(const UserInterfaceExDependencies& deps)
+MainScreen::MainScreen(const UserInterfaceExDependencies& deps,
+                       PerformanceProfiler& profiler)
 : AUI::Screen("MainScreen")
 , world{deps.simulation.getWorld()}
 , viewModel{}
 , interactionManager{deps.simulation.getWorld(), deps.network, deps.itemData,
                      *this, viewModel}
 , playerIsInBuildArea{false}
+, regionWatcher{}
 , dialogueResponseQueue{deps.network.getEventDispatcher()}
-, mainOverlay{world, deps.worldObjectLocator, deps.network, viewModel,
-              interactionManager}
-, chatWindow{deps.simulation, deps.network, deps.sdlRenderer}
-, dialogueWindow{world, deps.network}
-, inventoryWindow{deps.simulation, deps.network, deps.itemData,
-                  deps.iconData,   viewModel,    interactionManager}
-, hotbarWindow{world, *this, viewModel}
-, buildOverlay{deps.simulation, deps.worldObjectLocator, deps.network,
-               deps.graphicData}
-, buildPanel{deps.simulation, deps.network,  deps.graphicData,
-             deps.itemData,   deps.iconData, buildOverlay}
-, rightClickMenu{}
-, tooltipWindow{}
+, thumbnailAtlas{deps.graphicData, deps.iconData}
+, mainOverlay{profiler, "MainOverlay", world, deps.worldObjectLocator,
+              deps.network, viewModel, interactionManager}
+, chatWindow{profiler, "ChatWindow", deps.simulation, deps.network,
+             deps.sdlRenderer}
+, dialogueWindow{profiler, "DialogueWindow", world, deps.network}
+, inventoryWindow{profiler,       "InventoryWindow", deps.simulation,
+                  deps.network,   deps.itemData,     deps.iconData,
+                  thumbnailAtlas, viewModel,         interactionManager}
+, hotbarWindow{profiler, "HotbarWindow", world, *this, viewModel}
+, buildOverlay{profiler, "BuildOverlay", deps.simulation,
+               deps.worldObjectLocator, deps.network, deps.graphicData}
+, buildPanel{profiler,      "BuildPanel",     deps.simulation,
+             deps.network,  deps.graphicData, deps.itemData,
+             deps.iconData, thumbnailAtlas,   buildOverlay}
+, rightClickMenu{profiler, "RightClickMenu"}
+, tooltipWindow{profiler, "TooltipWindow"}
 {
     // Add our windows so they're included in rendering, etc.
     windows.push_back(mainOverlay);
@@ -61,8 +67,12 @@ MainScreen::MainScreen(const UserInterfaceExDependencies& deps)
     // If world changes are restricted, we need to know when the player enters
     // or exits the build area.
     if (SharedConfig::RESTRICT_WORLD_CHANGES) {
-        world.registry.on_update<Position>()
-            .connect<&MainScreen::onPositionChanged>(*this);
+        RegionWatcher::RegionID buildAreaID{
+            regionWatcher.addRegion(BUILD_MODE_AREA_EXTENTS)};
+        regionWatcher.watch(world.playerEntity, buildAreaID,
+                            [this](bool playerIsInside) {
+                                onBuildAreaChanged(playerIsInside);
+                            });
     }
     else {
         // World changes are unrestricted, so the player is always in the build
@@ -181,6 +191,9 @@ void MainScreen::tick(double timestepS)
     // Do the normal tick processing.
     Screen::tick(timestepS);
 
+    // Check if the player entered or exited the build area.
+    regionWatcher.update(world.registry);
+
     // Pass any waiting dialogue messages to DialogueWindow for processing.
     DialogueResponse dialogueResponse{};
     while (dialogueResponseQueue.pop(dialogueResponse)) {
@@ -195,31 +208,15 @@ void MainScreen::tick(double timestepS)
     }
 }
 
-void MainScreen::onPositionChanged(entt::registry& registry,
-                                   entt::entity entity)
+void MainScreen::onBuildAreaChanged(bool playerIsInside)
 {
-    // We only care about updates to the player entity.
-    if (entity != world.playerEntity) {
-        return;
-    }
-
-    // If the new position is within the build area, make the hint text visible.
-    const Position& position{registry.get<Position>(entity)};
-    for (const TileExtent& extent : BUILD_MODE_AREA_EXTENTS) {
-        if (extent.contains(TilePosition(position))) {
-            if (!playerIsInBuildArea) {
-                // The player just entered the build area.
-                mainOverlay.setBuildModeHintVisibility(true);
-
-                playerIsInBuildArea = true;
-            }
+    if (playerIsInside) {
+        // The player just entered the build area. Make the hint text visible.
+        mainOverlay.setBuildModeHintVisibility(true);
 
-            return;
-        }
+        playerIsInBuildArea = true;
     }
-
-    // The player is not in the build area. Check if they just left.
-    if (playerIsInBuildArea) {
+    else {
         // The player just left the build area.
         mainOverlay.setBuildModeHintVisibility(false);
 
@@ -0,0 +1,131 @@
+#include "PerformanceOverlay.h"
+#include "PerformanceProfiler.h"
+#include "Paths.h"
+#include <SDL_render.h>
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+
+namespace AM
+{
+namespace Client
+{
+PerformanceOverlay::PerformanceOverlay(SDL_Renderer* inSdlRenderer,
+                                       const PerformanceProfiler& inProfiler)
+: sdlRenderer{inSdlRenderer}
+, profiler{inProfiler}
+, glyphAtlas{inSdlRenderer, (Paths::FONT_DIR + "Cagliostro-Regular.ttf"), 16}
+, updateTimer{}
+, lines{}
+, lineCount{0}
+, backgroundExtent{0, 0, 0, 0}
+{
+}
+
+void PerformanceOverlay::update()
+{
+    // If the UI scale changed, re-rasterize our glyphs and re-size our
+    // background to match.
+    bool atlasWasRefreshed{glyphAtlas.refresh()};
+
+    // If it isn't time to update the text, do nothing.
+    if (!atlasWasRefreshed && (lineCount > 0)
+        && (updateTimer.getTime() < UPDATE_PERIOD_S)) {
+        return;
+    }
+    updateTimer.reset();
+
+    // Format a line for each section.
+    lineCount = 0;
+    addLine("UI times in ms, avg/max of last %zu frames (F4: export CSV)",
+            STAT_FRAME_COUNT);
+    for (std::size_t i{0}; i < profiler.getSectionCount(); ++i) {
+        auto sectionID{static_cast<PerformanceProfiler::SectionID>(i)};
+        PerformanceProfiler::SectionStats stats{
+            profiler.getSectionStats(sectionID, STAT_FRAME_COUNT)};
+        std::array<double, (PerformanceProfiler::STAGE_COUNT * 2)> timesMs{};
+        for (std::size_t stage{0}; stage < PerformanceProfiler::STAGE_COUNT;
+             ++stage) {
+            timesMs[stage * 2] = (stats.averageTimesS[stage] * 1000);
+            timesMs[(stage * 2) + 1] = (stats.maxTimesS[stage] * 1000);
+        }
+        addLine("%-16.16s tick %5.2f/%5.2f  layout %5.2f/%5.2f  "
+                "render %5.2f/%5.2f  widgets %u",
+                profiler.getSectionName(sectionID).c_str(), timesMs[0],
+                timesMs[1], timesMs[2], timesMs[3], timesMs[4], timesMs[5],
+                static_cast<unsigned int>(stats.widgetCount));
+    }
+    addLine("Textures created: %zu", profiler.getTextureCreationCount());
+
+    // Fit the background to the text.
+    int maxLineWidth{0};
+    for (std::size_t i{0}; i < lineCount; ++i) {
+        int lineWidth{0};
+        for (const char* character{lines[i].data()}; *character != '\0';
+             ++character) {
+            lineWidth += glyphAtlas.getGlyph(*character).advance;
+        }
+        maxLineWidth = std::max(maxLineWidth, lineWidth);
+    }
+    backgroundExtent
+        = {0, 0, (maxLineWidth + (PADDING * 2)),
+           ((glyphAtlas.getLineHeight() * static_cast<int>(lineCount))
+            + (PADDING * 2))};
+}
+
+void PerformanceOverlay::render()
+{
+    // Draw a translucent background so the text is readable over anything.
+    SDL_BlendMode previousBlendMode{};
+    SDL_GetRenderDrawBlendMode(sdlRenderer, &previousBlendMode);
+    SDL_Color previousDrawColor{};
+    SDL_GetRenderDrawColor(sdlRenderer, &previousDrawColor.r,
+                           &previousDrawColor.g, &previousDrawColor.b,
+                           &previousDrawColor.a);
+
+    SDL_SetRenderDrawBlendMode(sdlRenderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(sdlRenderer, 0, 0, 0, 180);
+    SDL_RenderFillRect(sdlRenderer, &backgroundExtent);
+
+    SDL_SetRenderDrawBlendMode(sdlRenderer, previousBlendMode);
+    SDL_SetRenderDrawColor(sdlRenderer, previousDrawColor.r,
+                           previousDrawColor.g, previousDrawColor.b,
+                           previousDrawColor.a);
+
+    // Draw each line, glyph by glyph.
+    SDL_Texture* atlasTexture{glyphAtlas.getTexture()};
+    SDL_Point pen{PADDING, PADDING};
+    for (std::size_t i{0}; i < lineCount; ++i) {
+        pen.x = PADDING;
+        for (const char* character{lines[i].data()}; *character != '\0';
+             ++character) {
+            const GlyphAtlas::Glyph& glyph{glyphAtlas.getGlyph(*character)};
+            if (glyph.sourceExtent.w > 0) {
+                SDL_Rect finalExtent{pen.x, pen.y, glyph.sourceExtent.w,
+                                     glyph.sourceExtent.h};
+                SDL_RenderCopy(sdlRenderer, atlasTexture,
+                               &(glyph.sourceExtent), &finalExtent);
+            }
+            pen.x += glyph.advance;
+        }
+        pen.y += glyphAtlas.getLineHeight();
+    }
+}
+
+void PerformanceOverlay::addLine(const char* format, ...)
+{
+    if (lineCount == MAX_LINES) {
+        return;
+    }
+
+    // Note: vsnprintf truncates to fit, so long lines are cut off instead
+    //       of overflowing.
+    std::va_list args;
+    va_start(args, format);
+    std::vsnprintf(lines[lineCount].data(), MAX_LINE_LENGTH, format, args);
+    va_end(args);
+    lineCount++;
+}
+
+} // End namespace Client
+} // End namespace AM
@@ -0,0 +1,171 @@
+#include "PerformanceProfiler.h"
+#include "AMAssert.h"
+#include <SDL_stdinc.h>
+#include <algorithm>
+#include <fstream>
+
+namespace AM
+{
+namespace Client
+{
+Uint16 PerformanceProfiler::currentTextureCount{0};
+
+PerformanceProfiler::PerformanceProfiler()
+: sectionNames{}
+, currentSamples{}
+, sampleHistory{}
+, textureCountHistory{}
+, nextHistoryIndex{0}
+, frameCount{0}
+, totalFrameCount{0}
+{
+    sectionNames.reserve(MAX_SECTIONS);
+    currentSamples.reserve(MAX_SECTIONS);
+}
+
+PerformanceProfiler::SectionID
+    PerformanceProfiler::addSection(std::string_view name)
+{
+    AM_ASSERT(sectionNames.size() < MAX_SECTIONS, "Too many sections.");
+    sectionNames.emplace_back(name);
+    currentSamples.emplace_back();
+    sampleHistory.resize(sampleHistory.size() + HISTORY_LENGTH);
+
+    return static_cast<SectionID>(sectionNames.size() - 1);
+}
+
+void PerformanceProfiler::addTime(SectionID sectionID, Stage stage,
+                                  double timeS)
+{
+    currentSamples[sectionID].stageTimesS[static_cast<std::size_t>(stage)]
+        += static_cast<float>(timeS);
+}
+
+void PerformanceProfiler::setWidgetCount(SectionID sectionID,
+                                         std::size_t widgetCount)
+{
+    currentSamples[sectionID].widgetCount = static_cast<Uint16>(
+        std::min(widgetCount, static_cast<std::size_t>(SDL_MAX_UINT16)));
+}
+
+void PerformanceProfiler::countTextureCreation()
+{
+    if (currentTextureCount < SDL_MAX_UINT16) {
+        currentTextureCount++;
+    }
+}
+
+void PerformanceProfiler::endFrame()
+{
+    // Move each section's sample into its history and reset its times.
+    // Note: Widget counts carry over, since sections only update them when
+    //       they're visible.
+    for (std::size_t i{0}; i < currentSamples.size(); ++i) {
+        SectionSample& currentSample{currentSamples[i]};
+        sampleHistory[(i * HISTORY_LENGTH) + nextHistoryIndex]
+            = currentSample;
+        currentSample.stageTimesS.fill(0);
+    }
+    textureCountHistory[nextHistoryIndex] = currentTextureCount;
+    currentTextureCount = 0;
+
+    nextHistoryIndex = (nextHistoryIndex + 1) % HISTORY_LENGTH;
+    frameCount = std::min((frameCount + 1), HISTORY_LENGTH);
+    totalFrameCount++;
+}
+
+std::size_t PerformanceProfiler::getFrameCount() const
+{
+    return frameCount;
+}
+
+std::size_t PerformanceProfiler::getSectionCount() const
+{
+    return sectionNames.size();
+}
+
+const std::string&
+    PerformanceProfiler::getSectionName(SectionID sectionID) const
+{
+    return sectionNames[sectionID];
+}
+
+PerformanceProfiler::SectionStats
+    PerformanceProfiler::getSectionStats(SectionID sectionID,
+                                         std::size_t frameAge) const
+{
+    SectionStats stats{};
+    std::size_t statFrameCount{frameCount};
+    if ((frameAge != 0) && (frameAge < statFrameCount)) {
+        statFrameCount = frameAge;
+    }
+    if (statFrameCount == 0) {
+        return stats;
+    }
+
+    const SectionSample* history{
+        &(sampleHistory[sectionID * HISTORY_LENGTH])};
+    for (std::size_t i{0}; i < statFrameCount; ++i) {
+        const SectionSample& sample{history[getHistoryIndex(i)]};
+        for (std::size_t stage{0}; stage < STAGE_COUNT; ++stage) {
+            double timeS{sample.stageTimesS[stage]};
+            stats.averageTimesS[stage] += timeS;
+            stats.maxTimesS[stage] = std::max(stats.maxTimesS[stage], timeS);
+        }
+    }
+    for (double& averageTimeS : stats.averageTimesS) {
+        averageTimeS /= static_cast<double>(statFrameCount);
+    }
+    stats.widgetCount = history[getHistoryIndex(0)].widgetCount;
+
+    return stats;
+}
+
+std::size_t PerformanceProfiler::getTextureCreationCount() const
+{
+    std::size_t textureCount{0};
+    for (std::size_t i{0}; i < frameCount; ++i) {
+        textureCount += textureCountHistory[getHistoryIndex(i)];
+    }
+
+    return textureCount;
+}
+
+bool PerformanceProfiler::exportCsv(const std::string& filePath) const
+{
+    std::ofstream file{filePath};
+    if (!file) {
+        return false;
+    }
+
+    file << "frame,section,tickMs,layoutMs,renderMs,widgetCount,"
+            "texturesCreated\n";
+    Uint64 firstFrame{totalFrameCount - frameCount};
+    for (std::size_t i{0}; i < frameCount; ++i) {
+        // Walk from oldest to newest.
+        std::size_t framesAgo{frameCount - 1 - i};
+        std::size_t historyIndex{getHistoryIndex(framesAgo)};
+        for (std::size_t sectionID{0}; sectionID < sectionNames.size();
+             ++sectionID) {
+            const SectionSample& sample{
+                sampleHistory[(sectionID * HISTORY_LENGTH) + historyIndex]};
+            file << (firstFrame + i) << ',' << sectionNames[sectionID];
+            for (float stageTimeS : sample.stageTimesS) {
+                file << ',' << (stageTimeS * 1000.0);
+            }
+            file << ',' << sample.widgetCount << ','
+                 << textureCountHistory[historyIndex] << '\n';
+        }
+    }
+
+    return static_cast<bool>(file);
+}
+
+std::size_t PerformanceProfiler::getHistoryIndex(std::size_t framesAgo) const
+{
+    return ((nextHistoryIndex + HISTORY_LENGTH - 1 - framesAgo)
+            % HISTORY_LENGTH);
+}
+
+} // End namespace Client
+} // End namespace AM
@@ -0,0 +1,114 @@
+#include "RegionWatcher.h"
+#include "Position.h"
+#include "AMAssert.h"
+#include "entt/entity/registry.hpp"
+#include <algorithm>
+
+namespace AM
+{
+namespace Client
+{
+RegionWatcher::RegionID
+    RegionWatcher::addRegion(std::span<const TileExtent> extents)
+{
+    AM_ASSERT(regions.size() < SDL_MAX_UINT8, "Too many regions.");
+    Region& region{regions.emplace_back()};
+    if (extents.empty()) {
+        return static_cast<RegionID>(regions.size() - 1);
+    }
+
+    // Find the bounding extent of all the given extents.
+    int minX{extents[0].x};
+    int minY{extents[0].y};
+    int minZ{extents[0].z};
+    int maxX{extents[0].x + extents[0].xLength};
+    int maxY{extents[0].y + extents[0].yLength};
+    int maxZ{extents[0].z + extents[0].zLength};
+    for (const TileExtent& extent : extents) {
+        minX = std::min(minX, extent.x);
+        minY = std::min(minY, extent.y);
+        minZ = std::min(minZ, extent.z);
+        maxX = std::max(maxX, (extent.x + extent.xLength));
+        maxY = std::max(maxY, (extent.y + extent.yLength));
+        maxZ = std::max(maxZ, (extent.z + extent.zLength));
+    }
+    region.bounds = {minX,          minY,          minZ,
+                     (maxX - minX), (maxY - minY), (maxZ - minZ)};
+
+    // Mark each tile that's in one of the extents.
+    region.membership.assign(static_cast<std::size_t>(
+                                 region.bounds.xLength * region.bounds.yLength
+                                 * region.bounds.zLength),
+                             0);
+    for (const TileExtent& extent : extents) {
+        for (int z{extent.z}; z < (extent.z + extent.zLength); ++z) {
+            for (int y{extent.y}; y < (extent.y + extent.yLength); ++y) {
+                for (int x{extent.x}; x < (extent.x + extent.xLength); ++x) {
+                    std::size_t index{static_cast<std::size_t>(
+                        (((z - minZ) * region.bounds.yLength) + (y - minY))
+                            * region.bounds.xLength
+                        + (x - minX))};
+                    region.membership[index] = 1;
+                }
+            }
+        }
+    }
+
+    return static_cast<RegionID>(regions.size() - 1);
+}
+
+void RegionWatcher::watch(const entt::entity& entity, RegionID regionID,
+                          std::function<void(bool)> onChanged)
+{
+    AM_ASSERT(regionID < regions.size(), "Invalid region ID.");
+    watches.push_back(Watch{.entity{&entity},
+                            .regionID{regionID},
+                            .onChanged{std::move(onChanged)}});
+}
+
+void RegionWatcher::update(const entt::registry& registry)
+{
+    for (Watch& watch : watches) {
+        // If the entity doesn't exist (e.g. we haven't connected yet), skip
+        // it.
+        entt::entity entity{*(watch.entity)};
+        if (!(registry.valid(entity)) || !(registry.all_of<Position>(entity))) {
+            continue;
+        }
+
+        // If the entity is on the same tile as last time, nothing changed.
+        TilePosition tilePosition(registry.get<Position>(entity));
+        if ((entity == watch.lastEntity)
+            && (tilePosition == watch.lastTilePosition)) {
+            continue;
+        }
+        watch.lastEntity = entity;
+        watch.lastTilePosition = tilePosition;
+
+        // If the entity entered or left the region, call the callback.
+        bool isInside{regions[watch.regionID].contains(tilePosition)};
+        if (isInside != watch.isInside) {
+            watch.isInside = isInside;
+            if (watch.onChanged) {
+                watch.onChanged(isInside);
+            }
+        }
+    }
+}
+
+bool RegionWatcher::Region::contains(const TilePosition& tilePosition) const
+{
+    if (!(bounds.contains(tilePosition))) {
+        return false;
+    }
+
+    std::size_t index{static_cast<std::size_t>(
+        (((tilePosition.z - bounds.z) * bounds.yLength)
+         + (tilePosition.y - bounds.y))
+            * bounds.xLength
+        + (tilePosition.x - bounds.x))};
+    return (membership[index] != 0);
+}
+
+} // End namespace Client
+} // End namespace AM
@@ -0,0 +1,291 @@
+#include "SearchIndex.h"
+#include <algorithm>
+#include <iterator>
+#include <cctype>
+
+namespace AM
+{
+namespace Client
+{
+void SearchIndex::setEntry(Uint32 entryID, std::string_view displayName,
+                           std::string_view stringID)
+{
+    // If the entry already exists, remove its old grams.
+    removeEntry(entryID);
+
+    Entry& entry{entries[entryID]};
+    normalize(displayName, entry.displayName);
+    normalize(stringID, entry.stringID);
+
+    // Collect the entry's unique grams and prefix grams.
+    addGrams(entry.displayName, entry.grams);
+    addGrams(entry.stringID, entry.grams);
+    sortUnique(entry.grams);
+    addPrefixGrams(entry.displayName, entry.prefixGrams);
+    addPrefixGrams(entry.stringID, entry.prefixGrams);
+    sortUnique(entry.prefixGrams);
+
+    // Add the entry to each gram's lists.
+    addToPostingLists(postingLists, entry.grams, entryID);
+    addToPostingLists(prefixPostingLists, entry.prefixGrams, entryID);
+}
+
+void SearchIndex::removeEntry(Uint32 entryID)
+{
+    auto entryIt{entries.find(entryID)};
+    if (entryIt == entries.end()) {
+        return;
+    }
+
+    // Remove the entry from each of its grams' lists.
+    const Entry& entry{entryIt->second};
+    removeFromPostingLists(postingLists, entry.grams, entryID);
+    removeFromPostingLists(prefixPostingLists, entry.prefixGrams, entryID);
+
+    entries.erase(entryIt);
+}
+
+void SearchIndex::clear()
+{
+    entries.clear();
+    postingLists.clear();
+    prefixPostingLists.clear();
+}
+
+std::size_t SearchIndex::size() const
+{
+    return entries.size();
+}
+
+void SearchIndex::search(std::string_view query,
+                         std::vector<Uint32>& outResults) const
+{
+    outResults.clear();
+
+    // If the query is empty, return every entry.
+    normalize(query, normalizedQuery);
+    if (normalizedQuery.empty()) {
+        outResults.reserve(entries.size());
+        for (const auto& [entryID, entry] : entries) {
+            outResults.push_back(entryID);
+        }
+        std::sort(outResults.begin(), outResults.end());
+        return;
+    }
+
+    // If the query is short enough to be a gram, its lists are the result.
+    // Note: The prefix list is a sorted subset of the full list, so the
+    //       results come out in order without checking any entry's fields.
+    if (normalizedQuery.size() <= MAX_GRAM_LENGTH) {
+        Uint32 gram{packGram(normalizedQuery)};
+        const std::vector<Uint32>* postingList{
+            getPostingList(postingLists, gram)};
+        if (!postingList) {
+            return;
+        }
+
+        const std::vector<Uint32>* prefixList{
+            getPostingList(prefixPostingLists, gram)};
+        if (!prefixList) {
+            outResults = *postingList;
+            return;
+        }
+
+        // Prefix matches first, then the remaining substring matches.
+        outResults.reserve(postingList->size());
+        outResults.assign(prefixList->begin(), prefixList->end());
+        std::set_difference(postingList->begin(), postingList->end(),
+                            prefixList->begin(), prefixList->end(),
+                            std::back_inserter(outResults));
+        return;
+    }
+
+    // Gather the lists for each of the query's trigrams, shortest first.
+    std::vector<const std::vector<Uint32>*> postingListsToMatch{};
+    for (std::size_t i{0}; (i + MAX_GRAM_LENGTH) <= normalizedQuery.size();
+         ++i) {
+        std::string_view trigram{
+            std::string_view{normalizedQuery}.substr(i, MAX_GRAM_LENGTH)};
+        const std::vector<Uint32>* postingList{
+            getPostingList(postingLists, packGram(trigram))};
+        if (!postingList) {
+            // No entry contains this trigram, so nothing can match.
+            return;
+        }
+        postingListsToMatch.push_back(postingList);
+    }
+    std::sort(postingListsToMatch.begin(), postingListsToMatch.end(),
+              [](const auto* a, const auto* b) {
+                  return a->size() < b->size();
+              });
+
+    // Intersect the lists, starting from the shortest.
+    outResults = *(postingListsToMatch[0]);
+    for (std::size_t i{1};
+         (i < postingListsToMatch.size()) && !(outResults.empty()); ++i) {
+        const std::vector<Uint32>& postingList{*(postingListsToMatch[i])};
+        std::erase_if(outResults, [&](Uint32 entryID) {
+            return !std::binary_search(postingList.begin(),
+                                       postingList.end(), entryID);
+        });
+    }
+
+    // Sharing every trigram doesn't guarantee that the entry contains
+    // the query, so confirm each candidate.
+    std::erase_if(outResults, [&](Uint32 entryID) {
+        return getMatchType(entries.at(entryID), normalizedQuery)
+               == MatchType::None;
+    });
+
+    // Move the prefix matches to the front.
+    std::stable_partition(
+        outResults.begin(), outResults.end(), [&](Uint32 entryID) {
+            return getMatchType(entries.at(entryID), normalizedQuery)
+                   == MatchType::Prefix;
+        });
+}
+
+SearchIndex::MatchType SearchIndex::getMatchType(Uint32 entryID,
+                                                 std::string_view query) const
+{
+    auto entryIt{entries.find(entryID)};
+    if (entryIt == entries.end()) {
+        return MatchType::None;
+    }
+
+    normalize(query, normalizedQuery);
+    return getMatchType(entryIt->second, normalizedQuery);
+}
+
+std::size_t SearchIndex::findResultPosition(const std::vector<Uint32>& results,
+                                            std::string_view query,
+                                            Uint32 entryID,
+                                            MatchType matchType) const
+{
+    // Results are sorted by match type, then by ID. Find the range that has
+    // the given match type.
+    normalize(query, normalizedQuery);
+    auto getRank = [&](Uint32 resultID) {
+        // Note: The given entry may have already been updated, so we use the
+        //       given type instead of checking it.
+        if (resultID == entryID) {
+            return matchType;
+        }
+        return getMatchType(entries.at(resultID), normalizedQuery);
+    };
+    auto rangeBegin{std::partition_point(
+        results.begin(), results.end(),
+        [&](Uint32 resultID) { return getRank(resultID) < matchType; })};
+    auto rangeEnd{std::partition_point(
+        rangeBegin, results.end(),
+        [&](Uint32 resultID) { return getRank(resultID) == matchType; })};
+
+    // Find the entry's place within the range.
+    return static_cast<std::size_t>(
+        std::lower_bound(rangeBegin, rangeEnd, entryID) - results.begin());
+}
+
+void SearchIndex::normalize(std::string_view string, std::string& outString)
+{
+    outString.assign(string);
+    for (char& character : outString) {
+        character = static_cast<char>(
+            std::tolower(static_cast<unsigned char>(character)));
+    }
+}
+
+SearchIndex::MatchType
+    SearchIndex::getMatchType(const Entry& entry, std::string_view query)
+{
+    if (entry.displayName.starts_with(query)
+        || entry.stringID.starts_with(query)) {
+        return MatchType::Prefix;
+    }
+    else if ((entry.displayName.find(query) != std::string::npos)
+             || (entry.stringID.find(query) != std::string::npos)) {
+        return MatchType::Substring;
+    }
+
+    return MatchType::None;
+}
+
+Uint32 SearchIndex::packGram(std::string_view characters)
+{
+    Uint32 gram{static_cast<Uint32>(characters.size()) << 24};
+    for (std::size_t i{0}; i < characters.size(); ++i) {
+        gram |= static_cast<Uint32>(static_cast<unsigned char>(characters[i]))
+                << (8 * i);
+    }
+
+    return gram;
+}
+
+void SearchIndex::addGrams(std::string_view string,
+                           std::vector<Uint32>& outGrams)
+{
+    for (std::size_t length{1}; length <= MAX_GRAM_LENGTH; ++length) {
+        for (std::size_t i{0}; (i + length) <= string.size(); ++i) {
+            outGrams.push_back(packGram(string.substr(i, length)));
+        }
+    }
+}
+
+void SearchIndex::addPrefixGrams(std::string_view string,
+                                 std::vector<Uint32>& outGrams)
+{
+    for (std::size_t length{1};
+         (length <= MAX_GRAM_LENGTH) && (length <= string.size()); ++length) {
+        outGrams.push_back(packGram(string.substr(0, length)));
+    }
+}
+
+void SearchIndex::sortUnique(std::vector<Uint32>& grams)
+{
+    std::sort(grams.begin(), grams.end());
+    grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+}
+
+void SearchIndex::addToPostingLists(PostingListMap& postingListMap,
+                                    const std::vector<Uint32>& grams,
+                                    Uint32 entryID)
+{
+    // Add the entry to each gram's list, keeping them sorted.
+    for (Uint32 gram : grams) {
+        std::vector<Uint32>& postingList{postingListMap[gram]};
+        postingList.insert(
+            std::lower_bound(postingList.begin(), postingList.end(), entryID),
+            entryID);
+    }
+}
+
+void SearchIndex::removeFromPostingLists(PostingListMap& postingListMap,
+                                         const std::vector<Uint32>& grams,
+                                         Uint32 entryID)
+{
+    for (Uint32 gram : grams) {
+        auto listIt{postingListMap.find(gram)};
+        std::vector<Uint32>& postingList{listIt->second};
+        auto idIt{
+            std::lower_bound(postingList.begin(), postingList.end(), entryID)};
+        postingList.erase(idIt);
+
+        if (postingList.empty()) {
+            postingListMap.erase(listIt);
+        }
+    }
+}
+
+const std::vector<Uint32>*
+    SearchIndex::getPostingList(const PostingListMap& postingListMap,
+                                Uint32 gram)
+{
+    auto listIt{postingListMap.find(gram)};
+    if (listIt == postingListMap.end()) {
+        return nullptr;
+    }
+
+    return &(listIt->second);
+}
+
+} // End namespace Client
+} // End namespace AM
@@ -0,0 +1,455 @@
+#include "ThumbnailAtlas.h"
+#include "GraphicData.h"
+#include "IconData.h"
+#include "Rotation.h"
+#include "Paths.h"
+#include "Log.h"
+#include "AUI/Image.h"
+#include "nlohmann/json.hpp"
+#include <SDL_image.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <tuple>
+
+namespace AM
+{
+namespace Client
+{
+/** The file that describes the cached atlas pages. */
+static const std::string MANIFEST_FILE_NAME{"ThumbnailAtlas.json"};
+
+const std::vector<std::string> ThumbnailAtlas::BACKGROUND_IMAGE_NAMES{
+    "Thumbnail/Active.png", "Thumbnail/Backdrop.png", "Thumbnail/Hovered.png",
+    "Thumbnail/Selected.png"};
+
+/**
+ * Returns the directory that the atlas is cached in.
+ */
+static std::string getCacheDir()
+{
+    return Paths::BASE_PATH + "Cache/";
+}
+
+/**
+ * Hashes the given bytes into the given FNV-1a hash.
+ */
+static void hashBytes(const void* data, std::size_t size, Uint64& hash)
+{
+    const Uint8* bytes{static_cast<const Uint8*>(data)};
+    for (std::size_t i{0}; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 0x100000001B3;
+    }
+}
+
+ThumbnailAtlas::ThumbnailAtlas(GraphicData& inGraphicData,
+                               IconData& inIconData)
+: entries{}
+{
+    std::vector<Source> sources{};
+    gatherSources(inGraphicData, inIconData, sources);
+
+    // If we have an up-to-date atlas cached, use it. Otherwise, pack a new
+    // one.
+    Uint64 signature{calcSignature(sources)};
+    if (!loadCache(signature)) {
+        LOG_INFO("Packing thumbnail atlas (%zu images).", sources.size());
+        pack(sources, signature);
+    }
+}
+
+void ThumbnailAtlas::setSimpleImage(AUI::Image& image,
+                                    const std::string& imagePath,
+                                    const SDL_Rect& textureExtent) const
+{
+    if (const Entry* entry{findEntry(imagePath, &textureExtent)}) {
+        SDL_Rect atlasExtent{
+            (entry->atlasPosition.x + textureExtent.x - entry->sourceExtent.x),
+            (entry->atlasPosition.y + textureExtent.y - entry->sourceExtent.y),
+            textureExtent.w, textureExtent.h};
+        image.setSimpleImage(getPagePath(entry->pageIndex), atlasExtent);
+    }
+    else {
+        image.setSimpleImage(imagePath, textureExtent);
+    }
+}
+
+void ThumbnailAtlas::setSimpleImage(AUI::Image& image,
+                                    const std::string& imagePath,
+                                    const SDL_Rect& textureExtent,
+                                    SDL_ScaleMode scaleMode) const
+{
+    if (const Entry* entry{findEntry(imagePath, &textureExtent)}) {
+        SDL_Rect atlasExtent{
+            (entry->atlasPosition.x + textureExtent.x - entry->sourceExtent.x),
+            (entry->atlasPosition.y + textureExtent.y - entry->sourceExtent.y),
+            textureExtent.w, textureExtent.h};
+        image.setSimpleImage(getPagePath(entry->pageIndex), atlasExtent,
+                             scaleMode);
+    }
+    else {
+        image.setSimpleImage(imagePath, textureExtent, scaleMode);
+    }
+}
+
+void ThumbnailAtlas::setSimpleImage(AUI::Image& image,
+                                    const std::string& imagePath) const
+{
+    if (const Entry* entry{findEntry(imagePath, nullptr)}) {
+        SDL_Rect atlasExtent{entry->atlasPosition.x, entry->atlasPosition.y,
+                             entry->sourceExtent.w, entry->sourceExtent.h};
+        image.setSimpleImage(getPagePath(entry->pageIndex), atlasExtent);
+    }
+    else {
+        image.setSimpleImage(imagePath);
+    }
+}
+
+void ThumbnailAtlas::gatherSources(GraphicData& graphicData,
+                                   IconData& iconData,
+                                   std::vector<Source>& outSources)
+{
+    // Add the backgrounds that every thumbnail draws.
+    for (const std::string& imageName : BACKGROUND_IMAGE_NAMES) {
+        outSources.push_back({Paths::TEXTURE_DIR + imageName, {}, true});
+    }
+
+    // Add the sprite that each graphic set's thumbnail shows.
+    // Note: These match the sprites that the build panel picks.
+    auto addSprite = [&](const Sprite& sprite) {
+        if (sprite.numericID == NULL_SPRITE_ID) {
+            return;
+        }
+        const SpriteRenderData& renderData{
+            graphicData.getSpriteRenderData(sprite.numericID)};
+        outSources.push_back(
+            {renderData.spriteSheetRelPath, renderData.textureExtent, false});
+    };
+    auto addFirstSprite = [&](const auto& graphicSet) {
+        for (const GraphicRef& graphic : graphicSet.graphics) {
+            if (graphic.getGraphicID() != NULL_GRAPHIC_ID) {
+                addSprite(graphic.getFirstSprite());
+                return;
+            }
+        }
+    };
+    for (const TerrainGraphicSet& graphicSet :
+         graphicData.getAllTerrainGraphicSets()) {
+        addFirstSprite(graphicSet);
+    }
+    for (const FloorGraphicSet& graphicSet :
+         graphicData.getAllFloorGraphicSets()) {
+        addFirstSprite(graphicSet);
+    }
+    for (const WallGraphicSet& graphicSet :
+         graphicData.getAllWallGraphicSets()) {
+        addSprite(graphicSet.graphics[0].getFirstSprite());
+    }
+    for (const ObjectGraphicSet& graphicSet :
+         graphicData.getAllObjectGraphicSets()) {
+        addFirstSprite(graphicSet);
+    }
+    for (const EntityGraphicSet& graphicSet :
+         graphicData.getAllEntityGraphicSets()) {
+        // Note: Idle South is guaranteed to be present in every entity
+        //       graphic set (though it may be the null sprite).
+        const auto& graphicArr{graphicSet.graphics.at(EntityGraphicType::Idle)};
+        addSprite(graphicArr.at(Rotation::Direction::South).getFirstSprite());
+    }
+
+    // Add every item icon.
+    for (const Icon& icon : iconData.getAllIcons()) {
+        const IconRenderData& renderData{
+            iconData.getRenderData(icon.numericID)};
+        outSources.push_back(
+            {renderData.iconSheetRelPath, renderData.textureExtent, false});
+    }
+
+    // Remove any duplicates (e.g. graphic sets that share a sprite).
+    auto getKey = [](const Source& source) {
+        return std::tie(source.imagePath, source.isWholeImage,
+                        source.sourceExtent.x, source.sourceExtent.y,
+                        source.sourceExtent.w, source.sourceExtent.h);
+    };
+    std::sort(outSources.begin(), outSources.end(),
+              [&](const Source& a, const Source& b) {
+                  return getKey(a) < getKey(b);
+              });
+    outSources.erase(std::unique(outSources.begin(), outSources.end(),
+                                 [&](const Source& a, const Source& b) {
+                                     return getKey(a) == getKey(b);
+                                 }),
+                     outSources.end());
+}
+
+Uint64 ThumbnailAtlas::calcSignature(const std::vector<Source>& sources)
+{
+    Uint64 hash{0xCBF29CE484222325};
+    const std::string* previousPath{nullptr};
+    for (const Source& source : sources) {
+        hashBytes(source.imagePath.data(), source.imagePath.size(), hash);
+        hashBytes(&(source.sourceExtent), sizeof(source.sourceExtent), hash);
+        hashBytes(&(source.isWholeImage), sizeof(source.isWholeImage), hash);
+
+        // Hash each source file's size and modification time once, so we
+        // notice when it changes.
+        // Note: Sources are sorted by path, so each file's sources are
+        //       contiguous.
+        if (!previousPath || (*previousPath != source.imagePath)) {
+            std::error_code errorCode{};
+            Uint64 fileSize{
+                std::filesystem::file_size(source.imagePath, errorCode)};
+            Sint64 writeTime{static_cast<Sint64>(
+                std::filesystem::last_write_time(source.imagePath, errorCode)
+                    .time_since_epoch()
+                    .count())};
+            hashBytes(&fileSize, sizeof(fileSize), hash);
+            hashBytes(&writeTime, sizeof(writeTime), hash);
+            previousPath = &(source.imagePath);
+        }
+    }
+
+    return hash;
+}
+
+bool ThumbnailAtlas::loadCache(Uint64 signature)
+{
+    std::ifstream manifestFile{getCacheDir() + MANIFEST_FILE_NAME};
+    if (!(manifestFile.is_open())) {
+        return false;
+    }
+
+    try {
+        nlohmann::json json = nlohmann::json::parse(manifestFile);
+        if (json.at("signature").get<Uint64>() != signature) {
+            return false;
+        }
+
+        // If any of the pages are missing, the cache is unusable.
+        std::size_t cachedPageCount{json.at("pageCount").get<std::size_t>()};
+        for (std::size_t i{0}; i < cachedPageCount; ++i) {
+            if (!(std::filesystem::exists(getPagePath(i)))) {
+                return false;
+            }
+        }
+
+        for (const nlohmann::json& entryJson : json.at("entries")) {
+            Entry entry{};
+            entry.sourceExtent = {entryJson.at("x").get<int>(),
+                                  entryJson.at("y").get<int>(),
+                                  entryJson.at("w").get<int>(),
+                                  entryJson.at("h").get<int>()};
+            entry.isWholeImage = entryJson.at("isWholeImage").get<bool>();
+            entry.pageIndex = entryJson.at("pageIndex").get<std::size_t>();
+            if (entry.pageIndex >= cachedPageCount) {
+                entries.clear();
+                return false;
+            }
+            entry.atlasPosition = {entryJson.at("atlasX").get<int>(),
+                                   entryJson.at("atlasY").get<int>()};
+            entries[entryJson.at("imagePath").get<std::string>()].push_back(
+                entry);
+        }
+    } catch (nlohmann::json::exception& e) {
+        LOG_INFO("Failed to parse %s: %s", MANIFEST_FILE_NAME.c_str(),
+                 e.what());
+        entries.clear();
+        return false;
+    }
+
+    return true;
+}
+
+void ThumbnailAtlas::pack(const std::vector<Source>& sources,
+                          Uint64 signature)
+{
+    // Load each source file once, and resolve each source's extent.
+    std::unordered_map<std::string, SDL_Surface*> surfaces{};
+    std::vector<std::pair<const Source*, SDL_Rect>> packables{};
+    for (const Source& source : sources) {
+        auto surfaceIt{surfaces.find(source.imagePath)};
+        if (surfaceIt == surfaces.end()) {
+            SDL_Surface* surface{IMG_Load(source.imagePath.c_str())};
+            if (surface == nullptr) {
+                LOG_INFO("Failed to load thumbnail image: %s",
+                         source.imagePath.c_str());
+            }
+            surfaceIt = surfaces.emplace(source.imagePath, surface).first;
+        }
+        SDL_Surface* surface{surfaceIt->second};
+        if (surface == nullptr) {
+            continue;
+        }
+
+        SDL_Rect sourceExtent{source.isWholeImage
+                                  ? SDL_Rect{0, 0, surface->w, surface->h}
+                                  : source.sourceExtent};
+        bool isInBounds{(sourceExtent.x >= 0) && (sourceExtent.y >= 0)
+                        && ((sourceExtent.x + sourceExtent.w) <= surface->w)
+                        && ((sourceExtent.y + sourceExtent.h) <= surface->h)};
+        bool isTooLarge{(sourceExtent.w > MAX_SOURCE_SIZE)
+                        || (sourceExtent.h > MAX_SOURCE_SIZE)};
+        if (isInBounds && !isTooLarge && (sourceExtent.w > 0)
+            && (sourceExtent.h > 0)) {
+            packables.emplace_back(&source, sourceExtent);
+        }
+    }
+
+    // Pack the images into shelves, tallest first.
+    std::sort(packables.begin(), packables.end(),
+              [](const auto& a, const auto& b) {
+                  if (a.second.h != b.second.h) {
+                      return a.second.h > b.second.h;
+                  }
+                  return a.second.w > b.second.w;
+              });
+    std::vector<Entry> packedEntries{};
+    std::vector<int> pageHeights{};
+    SDL_Point nextPosition{PADDING, PADDING};
+    int shelfHeight{0};
+    for (const auto& [source, sourceExtent] : packables) {
+        if (pageHeights.empty()) {
+            pageHeights.push_back(0);
+        }
+
+        // If this image doesn't fit on the current shelf, start a new one.
+        if ((nextPosition.x + sourceExtent.w + PADDING) > PAGE_SIZE) {
+            nextPosition.x = PADDING;
+            nextPosition.y += (shelfHeight + PADDING);
+            shelfHeight = 0;
+        }
+
+        // If the new shelf doesn't fit on the current page, start a new one.
+        if ((nextPosition.y + sourceExtent.h + PADDING) > PAGE_SIZE) {
+            pageHeights.push_back(0);
+            nextPosition = {PADDING, PADDING};
+            shelfHeight = 0;
+        }
+
+        Entry entry{};
+        entry.sourceExtent = sourceExtent;
+        entry.isWholeImage = source->isWholeImage;
+        entry.pageIndex = pageHeights.size() - 1;
+        entry.atlasPosition = nextPosition;
+        packedEntries.push_back(entry);
+
+        nextPosition.x += (sourceExtent.w + PADDING);
+        shelfHeight = std::max(shelfHeight, sourceExtent.h);
+        pageHeights.back() = std::max(
+            pageHeights.back(), (nextPosition.y + shelfHeight + PADDING));
+    }
+
+    // Copy the images into the pages and save them.
+    std::filesystem::create_directories(getCacheDir());
+    bool saveSucceeded{true};
+    for (std::size_t pageIndex{0}; pageIndex < pageHeights.size();
+         ++pageIndex) {
+        SDL_Surface* pageSurface{SDL_CreateRGBSurfaceWithFormat(
+            0, PAGE_SIZE, pageHeights[pageIndex], 32,
+            SDL_PIXELFORMAT_ARGB8888)};
+        if (pageSurface == nullptr) {
+            LOG_FATAL("Failed to create surface: %s", SDL_GetError());
+        }
+
+        for (std::size_t i{0}; i < packedEntries.size(); ++i) {
+            const Entry& entry{packedEntries[i]};
+            if (entry.pageIndex != pageIndex) {
+                continue;
+            }
+
+            // Note: Blending is disabled so the image's alpha is copied
+            //       as-is, instead of being blended onto the empty page.
+            SDL_Surface* surface{surfaces[packables[i].first->imagePath]};
+            SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_NONE);
+            SDL_Rect sourceExtent{entry.sourceExtent};
+            SDL_Rect destinationExtent{entry.atlasPosition.x,
+                                       entry.atlasPosition.y, sourceExtent.w,
+                                       sourceExtent.h};
+            SDL_BlitSurface(surface, &sourceExtent, pageSurface,
+                            &destinationExtent);
+        }
+
+        if (IMG_SavePNG(pageSurface, getPagePath(pageIndex).c_str()) != 0) {
+            LOG_INFO("Failed to save thumbnail atlas page: %s",
+                     IMG_GetError());
+            saveSucceeded = false;
+        }
+        SDL_FreeSurface(pageSurface);
+    }
+
+    for (auto& [imagePath, surface] : surfaces) {
+        SDL_FreeSurface(surface);
+    }
+
+    // If we failed to save the pages, leave the atlas empty. Thumbnails will
+    // use their own textures.
+    if (!saveSucceeded) {
+        return;
+    }
+
+    // Save the entries, and write the manifest.
+    nlohmann::json json{};
+    json["signature"] = signature;
+    json["pageCount"] = pageHeights.size();
+    json["entries"] = nlohmann::json::array();
+    for (std::size_t i{0}; i < packedEntries.size(); ++i) {
+        const Entry& entry{packedEntries[i]};
+        const std::string& imagePath{packables[i].first->imagePath};
+        entries[imagePath].push_back(entry);
+
+        json["entries"].push_back({{"imagePath", imagePath},
+                                   {"x", entry.sourceExtent.x},
+                                   {"y", entry.sourceExtent.y},
+                                   {"w", entry.sourceExtent.w},
+                                   {"h", entry.sourceExtent.h},
+                                   {"isWholeImage", entry.isWholeImage},
+                                   {"pageIndex", entry.pageIndex},
+                                   {"atlasX", entry.atlasPosition.x},
+                                   {"atlasY", entry.atlasPosition.y}});
+    }
+
+    std::ofstream manifestFile{getCacheDir() + MANIFEST_FILE_NAME};
+    manifestFile << json.dump(4);
+}
+
+const ThumbnailAtlas::Entry*
+    ThumbnailAtlas::findEntry(const std::string& imagePath,
+                              const SDL_Rect* textureExtent) const
+{
+    auto entriesIt{entries.find(imagePath)};
+    if (entriesIt == entries.end()) {
+        return nullptr;
+    }
+
+    // Look for an entry that contains the requested sub-image.
+    for (const Entry& entry : entriesIt->second) {
+        if (!textureExtent) {
+            if (entry.isWholeImage) {
+                return &entry;
+            }
+            continue;
+        }
+
+        const SDL_Rect& sourceExtent{entry.sourceExtent};
+        if ((textureExtent->x >= sourceExtent.x)
+            && (textureExtent->y >= sourceExtent.y)
+            && ((textureExtent->x + textureExtent->w)
+                <= (sourceExtent.x + sourceExtent.w))
+            && ((textureExtent->y + textureExtent->h)
+                <= (sourceExtent.y + sourceExtent.h))) {
+            return &entry;
+        }
+    }
+
+    return nullptr;
+}
+
+std::string ThumbnailAtlas::getPagePath(std::size_t pageIndex) const
+{
+    return getCacheDir() + "ThumbnailAtlas_" + std::to_string(pageIndex)
+           + ".png";
+}
+
+} // End namespace Client
+} // End namespace AM
@@ -8,9 +8,11 @@ namespace Client
 {
 TitleScreen::TitleScreen(UserInterfaceExtension& inUserInterface,
                          Simulation& inSimulation,
-                         EventDispatcher& inUiEventDispatcher)
+                         EventDispatcher& inUiEventDispatcher,
+                         PerformanceProfiler& profiler)
 : AUI::Screen("TitleScreen")
-, titleWindow{inUserInterface, inSimulation, inUiEventDispatcher}
+, titleWindow{profiler, "TitleWindow", inUserInterface, inSimulation,
+              inUiEventDispatcher}
 {
     // Add our windows so they're included in rendering, etc.
     windows.push_back(titleWindow);
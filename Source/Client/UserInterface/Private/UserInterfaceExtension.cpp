@@ -9,6 +9,7 @@
 #include "UserConfig.h"
 #include "Transforms.h"
 #include "ClientTransforms.h"
+#include "Paths.h"
 #include "Log.h"
 #include "AUI/Core.h"
 
@@ -23,9 +24,15 @@ UserInterfaceExtension::UserInterfaceExtension(
                  {Config::LOGICAL_SCREEN_WIDTH, Config::LOGICAL_SCREEN_HEIGHT},
                  {UserConfig::get().getWindowSize().w,
                   UserConfig::get().getWindowSize().h}}
-, titleScreen{*this, deps.simulation, deps.uiEventDispatcher}
-, mainScreen{deps}
+, profiler{}
+, titleScreenSectionID{profiler.addSection("TitleScreen")}
+, mainScreenSectionID{profiler.addSection("MainScreen")}
+, screenTimer{}
+, titleScreen{*this, deps.simulation, deps.uiEventDispatcher, profiler}
+, mainScreen{deps, profiler}
 , currentScreen{&titleScreen}
+, performanceOverlay{deps.sdlRenderer, profiler}
+, performanceOverlayIsVisible{false}
 {
 }
 
@@ -70,19 +77,75 @@ std::vector<SpriteColorModInfo>
 
 bool UserInterfaceExtension::handleOSEvent(SDL_Event& event)
 {
+    // Handle the performance overlay's hotkeys.
+    if ((event.type == SDL_KEYDOWN) && (event.key.repeat == 0)) {
+        if (event.key.keysym.sym == SDLK_F3) {
+            performanceOverlayIsVisible = !performanceOverlayIsVisible;
+            return true;
+        }
+        else if (event.key.keysym.sym == SDLK_F4) {
+            exportPerformanceTrace();
+            return true;
+        }
+    }
+
     return currentScreen->handleOSEvent(event);
 }
 
 void UserInterfaceExtension::tick(double timestepS)
 {
+    PerformanceProfiler::SectionID sectionID{getCurrentScreenSectionID()};
+
+    screenTimer.reset();
     currentScreen->tick(timestepS);
+    profiler.addTime(sectionID, PerformanceProfiler::Stage::Tick,
+                     screenTimer.getTime());
 }
 
 void UserInterfaceExtension::render(const Camera& camera)
 {
     mainScreen.setCamera(camera);
 
+    // Note: The screen's layout happens during its render, so its render
+    //       time includes its windows' layout times.
+    PerformanceProfiler::SectionID sectionID{getCurrentScreenSectionID()};
+    screenTimer.reset();
     currentScreen->render();
+    profiler.addTime(sectionID, PerformanceProfiler::Stage::Render,
+                     screenTimer.getTime());
+
+    // Each render is a frame, so end the profiler's frame.
+    profiler.endFrame();
+
+    // Note: The overlay is drawn after the frame ends, so it doesn't count
+    //       towards any section's times.
+    if (performanceOverlayIsVisible) {
+        performanceOverlay.update();
+        performanceOverlay.render();
+    }
+}
+
+PerformanceProfiler::SectionID
+    UserInterfaceExtension::getCurrentScreenSectionID() const
+{
+    if (currentScreen == &mainScreen) {
+        return mainScreenSectionID;
+    }
+    else {
+        return titleScreenSectionID;
+    }
+}
+
+void UserInterfaceExtension::exportPerformanceTrace()
+{
+    std::string filePath{Paths::BASE_PATH + PERFORMANCE_TRACE_FILE_NAME};
+    if (profiler.exportCsv(filePath)) {
+        LOG_INFO("Exported %zu frames of UI times to %s.",
+                 profiler.getFrameCount(), filePath.c_str());
+    }
+    else {
+        LOG_INFO("Failed to export UI times to %s.", filePath.c_str());
+    }
 }
 
 } // End namespace Client
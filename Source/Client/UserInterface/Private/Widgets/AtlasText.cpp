@@ -0,0 +1,131 @@
+#include "AtlasText.h"
+#include "GlyphAtlas.h"
+#include "AUI/Core.h"
+#include "AUI/ScalingHelpers.h"
+#include <SDL_render.h>
+
+namespace AM
+{
+namespace Client
+{
+AtlasText::AtlasText(GlyphAtlas& inGlyphAtlas,
+                     const SDL_Rect& inLogicalExtent,
+                     const std::string& inDebugName)
+: Widget(inLogicalExtent, inDebugName)
+, glyphAtlas{inGlyphAtlas}
+, text{}
+, glyphQuads{}
+{
+}
+
+void AtlasText::setText(std::string_view inText)
+{
+    // Note: assign() re-uses our existing capacity, so recycled widgets
+    //       stop allocating once they've held a long enough string.
+    text.assign(inText);
+    refreshLayout();
+}
+
+void AtlasText::refreshLayout()
+{
+    glyphQuads.clear();
+
+    int wrapWidth{AUI::ScalingHelpers::logicalToActual(logicalExtent.w)};
+    int lineHeight{glyphAtlas.getLineHeight()};
+
+    // Place each glyph, greedily wrapping at spaces.
+    SDL_Point pen{0, 0};
+    std::size_t lineStartIndex{0};
+    // The index of the first quad after the latest space on this line.
+    std::size_t breakIndex{SIZE_MAX};
+    for (std::size_t textIndex{0}; textIndex < text.size();) {
+        Uint32 codepoint{GlyphAtlas::decodeUtf8(text, textIndex)};
+
+        // Draw whitespace control characters as spaces.
+        if ((codepoint == '\t') || (codepoint == '\n')
+            || (codepoint == '\r')) {
+            codepoint = ' ';
+        }
+
+        const GlyphAtlas::Glyph& glyph{glyphAtlas.getGlyph(codepoint)};
+        if (codepoint == ' ') {
+            pen.x += glyph.advance;
+            breakIndex = glyphQuads.size();
+            continue;
+        }
+
+        // If this glyph would overflow the line, wrap.
+        if (((pen.x + glyph.advance) > wrapWidth) && (pen.x > 0)) {
+            if ((breakIndex > lineStartIndex)
+                && (breakIndex < glyphQuads.size())) {
+                // Move the word after the latest space to the next line.
+                int shift{glyphQuads[breakIndex].destinationExtent.x};
+                for (std::size_t i{breakIndex}; i < glyphQuads.size(); ++i) {
+                    glyphQuads[i].destinationExtent.x -= shift;
+                    glyphQuads[i].destinationExtent.y += lineHeight;
+                }
+                pen.x -= shift;
+                lineStartIndex = breakIndex;
+            }
+            else {
+                // No space to wrap at (or the space ends the line), so
+                // break before this glyph.
+                pen.x = 0;
+                lineStartIndex = glyphQuads.size();
+            }
+            pen.y += lineHeight;
+            breakIndex = SIZE_MAX;
+        }
+
+        if (glyph.sourceExtent.w > 0) {
+            glyphQuads.push_back(
+                {glyph.sourceExtent,
+                 {pen.x, pen.y, glyph.sourceExtent.w, glyph.sourceExtent.h}});
+        }
+        pen.x += glyph.advance;
+    }
+
+    // Fit our height to the text.
+    int textHeight{text.empty() ? 0 : (pen.y + lineHeight)};
+    SDL_Rect newLogicalExtent{logicalExtent};
+    newLogicalExtent.h = AUI::ScalingHelpers::actualToLogical(textHeight);
+    if (newLogicalExtent.h != logicalExtent.h) {
+        setLogicalExtent(newLogicalExtent);
+    }
+}
+
+void AtlasText::render(const SDL_Point& windowTopLeft)
+{
+    SDL_Renderer* renderer{AUI::Core::getRenderer()};
+    SDL_Texture* atlasTexture{glyphAtlas.getTexture()};
+    SDL_Point origin{(windowTopLeft.x + clippedExtent.x),
+                     (windowTopLeft.y + clippedExtent.y)};
+
+    // Clip to our extent, so long words and partially visible lines don't
+    // draw outside of it. If a clip rect is already set, stay within it.
+    SDL_Rect clipExtent{origin.x, origin.y, clippedExtent.w, clippedExtent.h};
+    SDL_Rect previousClipExtent{};
+    bool clipWasEnabled{SDL_RenderIsClipEnabled(renderer) == SDL_TRUE};
+    if (clipWasEnabled) {
+        SDL_RenderGetClipRect(renderer, &previousClipExtent);
+        if (!SDL_IntersectRect(&clipExtent, &previousClipExtent,
+                               &clipExtent)) {
+            return;
+        }
+    }
+    SDL_RenderSetClipRect(renderer, &clipExtent);
+
+    for (const GlyphQuad& glyphQuad : glyphQuads) {
+        SDL_Rect finalExtent{glyphQuad.destinationExtent};
+        finalExtent.x += origin.x;
+        finalExtent.y += origin.y;
+        SDL_RenderCopy(renderer, atlasTexture, &(glyphQuad.sourceExtent),
+                       &finalExtent);
+    }
+
+    SDL_RenderSetClipRect(renderer,
+                          (clipWasEnabled ? &previousClipExtent : nullptr));
+}
+
+} // End namespace Client
+} // End namespace AM
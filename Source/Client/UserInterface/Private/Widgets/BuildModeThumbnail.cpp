@@ -1,18 +1,24 @@
 #include "BuildModeThumbnail.h"
+#include "ThumbnailAtlas.h"
 #include "Paths.h"
 
 namespace AM
 {
 namespace Client
 {
-BuildModeThumbnail::BuildModeThumbnail(const std::string& inDebugName)
+BuildModeThumbnail::BuildModeThumbnail(const ThumbnailAtlas& thumbnailAtlas,
+                                       const std::string& inDebugName)
 : AUI::Thumbnail({0, 0, 108, 109}, inDebugName)
 {
     // Add our backgrounds.
-    hoveredImage.setSimpleImage(Paths::TEXTURE_DIR + "Thumbnail/Hovered.png");
-    activeImage.setSimpleImage(Paths::TEXTURE_DIR + "Thumbnail/Active.png");
-    backdropImage.setSimpleImage(Paths::TEXTURE_DIR + "Thumbnail/Backdrop.png");
-    selectedImage.setSimpleImage(Paths::TEXTURE_DIR + "Thumbnail/Selected.png");
+    thumbnailAtlas.setSimpleImage(hoveredImage, Paths::TEXTURE_DIR
+                                                    + "Thumbnail/Hovered.png");
+    thumbnailAtlas.setSimpleImage(activeImage,
+                                  Paths::TEXTURE_DIR + "Thumbnail/Active.png");
+    thumbnailAtlas.setSimpleImage(
+        backdropImage, Paths::TEXTURE_DIR + "Thumbnail/Backdrop.png");
+    thumbnailAtlas.setSimpleImage(
+        selectedImage, Paths::TEXTURE_DIR + "Thumbnail/Selected.png");
 
     // Move our thumbnail image to the right position.
     thumbnailImage.setLogicalExtent({6, 4, 96, 96});
@@ -4,6 +4,7 @@
 #include "GraphicData.h"
 #include "BuildPanel.h"
 #include "BuildModeThumbnail.h"
+#include "ThumbnailAtlas.h"
 #include "EntityTool.h"
 #include "Name.h"
 #include "Position.h"
@@ -28,6 +29,7 @@ namespace Client
 {
 EntityPanelContent::EntityPanelContent(World& inWorld, Network& inNetwork,
                                        GraphicData& inGraphicData,
+                                       const ThumbnailAtlas& inThumbnailAtlas,
                                        BuildPanel& inBuildPanel,
                                        const SDL_Rect& inScreenExtent,
                                        const std::string& inDebugName)
@@ -35,6 +37,7 @@ EntityPanelContent::EntityPanelContent(World& inWorld, Network& inNetwork,
 , world{inWorld}
 , network{inNetwork}
 , graphicData{inGraphicData}
+, thumbnailAtlas{inThumbnailAtlas}
 , buildPanel{inBuildPanel}
 , hasRequestedTemplates{false}
 , currentView{ViewType::Template}
@@ -42,6 +45,9 @@ EntityPanelContent::EntityPanelContent(World& inWorld, Network& inNetwork,
 , editingEntityID{entt::null}
 , editingEntityInitScript{""}
 , selectedSpriteThumbnail{nullptr}
+, spriteSetThumbnailData{}
+, spriteSetSearchIndex{}
+, spriteSetSearchResults{}
 , entityTemplatesQueue{inNetwork.getEventDispatcher()}
 , entityInitScriptQueue{inNetwork.getEventDispatcher()}
 // Note: These dimensions are based on the top left that BuildPanel gives us.
@@ -55,8 +61,9 @@ EntityPanelContent::EntityPanelContent(World& inWorld, Network& inNetwork,
 , saveTemplateButton{{686, 117, 188, 36},
                      "Save as Template",
                      "SaveTemplateButton"}
-, graphicSetContainer{{0, 0, logicalExtent.w, logicalExtent.h},
-                     "GraphicSetContainer"}
+, graphicSetContainer{thumbnailAtlas,
+                      {0, 0, logicalExtent.w, logicalExtent.h},
+                      "GraphicSetContainer"}
 {
     // Add our children so they're included in rendering, etc.
     children.push_back(templateContainer);
@@ -79,7 +86,7 @@ EntityPanelContent::EntityPanelContent(World& inWorld, Network& inNetwork,
     nameLabel.setText("Entity Name");
 
     /* Containers */
-    auto setContainerStyle = [](AUI::VerticalGridContainer& container) {
+    auto setContainerStyle = [](auto& container) {
         container.setNumColumns(11);
         container.setCellWidth(108);
         container.setCellHeight(109 + 1);
@@ -178,6 +185,12 @@ void EntityPanelContent::setBuildTool(EntityTool* inEntityTool)
     }
 }
 
+void EntityPanelContent::setSearchQuery(std::string_view query)
+{
+    spriteSetSearchIndex.search(query, spriteSetSearchResults);
+    graphicSetContainer.setItemCount(spriteSetSearchResults.size());
+}
+
 void EntityPanelContent::setIsVisible(bool inIsVisible)
 {
     // The first time we're made visible, request the latest entity templates
@@ -310,7 +323,8 @@ void EntityPanelContent::addDefaultTemplateThumbnail()
 {
     // Construct the new thumbnail.
     std::unique_ptr<AUI::Widget> thumbnailPtr{
-        std::make_unique<BuildModeThumbnail>("EntityThumbnail")};
+        std::make_unique<BuildModeThumbnail>(thumbnailAtlas,
+                                             "EntityThumbnail")};
     BuildModeThumbnail& thumbnail{
         static_cast<BuildModeThumbnail&>(*thumbnailPtr)};
     thumbnail.setText("");
@@ -331,8 +345,8 @@ void EntityPanelContent::addDefaultTemplateThumbnail()
     SDL_Rect textureExtent{calcSquareTexExtent(renderData)};
 
     // Load the sprite's image.
-    thumbnail.thumbnailImage.setSimpleImage(renderData.spriteSheetRelPath,
-                                            textureExtent);
+    thumbnailAtlas.setSimpleImage(thumbnail.thumbnailImage,
+                                  renderData.spriteSheetRelPath, textureExtent);
 
     // Add the callback.
     thumbnail.setOnSelected([this](AUI::Thumbnail* selectedThumb) {
@@ -356,7 +370,8 @@ void EntityPanelContent::addTemplateThumbnails(
     for (const auto& entityData : entityTemplates.templates) {
         // Construct the new thumbnail.
         std::unique_ptr<AUI::Widget> thumbnailPtr{
-            std::make_unique<BuildModeThumbnail>("EntityThumbnail")};
+            std::make_unique<BuildModeThumbnail>(thumbnailAtlas,
+                                                 "EntityThumbnail")};
         BuildModeThumbnail& thumbnail{
             static_cast<BuildModeThumbnail&>(*thumbnailPtr)};
         thumbnail.setText("");
@@ -379,8 +394,9 @@ void EntityPanelContent::addTemplateThumbnails(
 
         // If the sprite is non-null, load its image as the template thumbnail.
         if (sprite.numericID != NULL_SPRITE_ID) {
-            thumbnail.thumbnailImage.setSimpleImage(renderData.spriteSheetRelPath,
-                                                    textureExtent);
+            thumbnailAtlas.setSimpleImage(thumbnail.thumbnailImage,
+                                          renderData.spriteSheetRelPath,
+                                          textureExtent);
         }
         else {
             // Sprite is null. Use the engine default icon instead.
@@ -405,7 +421,9 @@ void EntityPanelContent::addTemplateThumbnails(
 
 void EntityPanelContent::addSpriteSetThumbnails()
 {
-    // Add thumbnails for all entity graphic sets.
+    // Gather all entity graphic sets and index their names.
+    spriteSetThumbnailData.clear();
+    spriteSetSearchIndex.clear();
     for (const EntityGraphicSet& graphicSet :
          graphicData.getAllEntityGraphicSets()) {
         // Skip the null set.
@@ -413,47 +431,54 @@ void EntityPanelContent::addSpriteSetThumbnails()
             continue;
         }
 
-        // Construct the new thumbnail.
-        std::unique_ptr<AUI::Widget> thumbnailPtr{
-            std::make_unique<BuildModeThumbnail>("EntityThumbnail")};
-        BuildModeThumbnail& thumbnail{
-            static_cast<BuildModeThumbnail&>(*thumbnailPtr)};
-        thumbnail.setText("");
-        thumbnail.setIsActivateable(false);
+        spriteSetSearchIndex.setEntry(
+            static_cast<Uint32>(spriteSetThumbnailData.size()),
+            graphicSet.displayName, graphicSet.stringID);
+        spriteSetThumbnailData.push_back(&graphicSet);
+    }
 
-        // Calc a square texture extent that shows the bottom of the graphic
-        // (so we don't have to squash it).
-        // Note: Idle South is guaranteed to be present in every entity graphic
-        //       set (though it may be the null sprite).
-        const auto& graphicArr{graphicSet.graphics.at(EntityGraphicType::Idle)};
-        const Sprite& sprite{
-            graphicArr.at(Rotation::Direction::South).getFirstSprite()};
-        const SpriteRenderData& renderData{
-            graphicData.getSpriteRenderData(sprite.numericID)};
-        SDL_Rect textureExtent{calcSquareTexExtent(renderData)};
+    // Thumbnails are only created and loaded as they scroll into view.
+    graphicSetContainer.setOnBindThumbnail(
+        [this](BuildModeThumbnail& thumbnail, std::size_t index) {
+            bindSpriteSetThumbnail(
+                thumbnail,
+                *(spriteSetThumbnailData[spriteSetSearchResults[index]]));
+        });
+    setSearchQuery("");
+}
 
-        // Load the sprite's image.
-        thumbnail.thumbnailImage.setSimpleImage(renderData.spriteSheetRelPath,
-                                                textureExtent);
+void EntityPanelContent::bindSpriteSetThumbnail(
+    BuildModeThumbnail& thumbnail, const EntityGraphicSet& graphicSet)
+{
+    // Calc a square texture extent that shows the bottom of the graphic
+    // (so we don't have to squash it).
+    // Note: Idle South is guaranteed to be present in every entity graphic
+    //       set (though it may be the null sprite).
+    const auto& graphicArr{graphicSet.graphics.at(EntityGraphicType::Idle)};
+    const Sprite& sprite{
+        graphicArr.at(Rotation::Direction::South).getFirstSprite()};
+    const SpriteRenderData& renderData{
+        graphicData.getSpriteRenderData(sprite.numericID)};
+    SDL_Rect textureExtent{calcSquareTexExtent(renderData)};
 
-        // Add the callback.
-        thumbnail.setOnSelected(
-            [this, &graphicSet](AUI::Thumbnail*) {
-                // This view closes immediately so we don't want to select this
-                // thumbnail, but we should clear any existing selection.
-                buildPanel.clearSelectedThumbnail();
-
-                // Send a request to change the entity's animation state.
-                GraphicStateChangeRequest changeRequest{
-                    editingEntityID, GraphicState{graphicSet.numericID}};
-                network.serializeAndSend(changeRequest);
-
-                // Switch back to the edit view.
-                changeView(ViewType::Edit);
-            });
+    // Load the sprite's image.
+    thumbnailAtlas.setSimpleImage(thumbnail.thumbnailImage,
+                                  renderData.spriteSheetRelPath, textureExtent);
 
-        graphicSetContainer.push_back(std::move(thumbnailPtr));
-    }
+    // Add the callback.
+    thumbnail.setOnSelected([this, &graphicSet](AUI::Thumbnail*) {
+        // This view closes immediately so we don't want to select this
+        // thumbnail, but we should clear any existing selection.
+        buildPanel.clearSelectedThumbnail();
+
+        // Send a request to change the entity's animation state.
+        GraphicStateChangeRequest changeRequest{
+            editingEntityID, GraphicState{graphicSet.numericID}};
+        network.serializeAndSend(changeRequest);
+
+        // Switch back to the edit view.
+        changeView(ViewType::Edit);
+    });
 }
 
 SDL_Rect
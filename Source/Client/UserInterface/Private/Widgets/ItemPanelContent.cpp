@@ -7,6 +7,7 @@
 #include "ItemData.h"
 #include "BuildPanel.h"
 #include "BuildModeThumbnail.h"
+#include "ThumbnailAtlas.h"
 #include "ItemDataRequest.h"
 #include "ItemError.h"
 #include "ItemInitScriptRequest.h"
@@ -25,6 +26,7 @@ namespace Client
 {
 ItemPanelContent::ItemPanelContent(Simulation& inSimulation, Network& inNetwork,
                                    ItemData& inItemData, IconData& inIconData,
+                                   const ThumbnailAtlas& inThumbnailAtlas,
                                    const SDL_Rect& inScreenExtent,
                                    const std::string& inDebugName)
 : AUI::Widget(inScreenExtent, inDebugName)
@@ -32,6 +34,7 @@ ItemPanelContent::ItemPanelContent(Simulation& inSimulation, Network& inNetwork,
 , network{inNetwork}
 , itemData{inItemData}
 , iconData{inIconData}
+, thumbnailAtlas{inThumbnailAtlas}
 , currentView{ViewType::Home}
 , requestedItemStringID{}
 , selectedItemID{NULL_ITEM_ID}
@@ -39,6 +42,12 @@ ItemPanelContent::ItemPanelContent(Simulation& inSimulation, Network& inNetwork,
 , selectedItemIconID{NULL_ICON_ID}
 , selectedItemInitScript{}
 , initScriptReceived{false}
+, searchQuery{}
+, itemSearchIndex{}
+, itemCacheSearchResults{}
+, iconThumbnailData{}
+, iconSearchIndex{}
+, iconSearchResults{}
 , itemErrorQueue{inNetwork.getEventDispatcher()}
 , itemInitScriptQueue{inNetwork.getEventDispatcher()}
 // Note: These dimensions are based on the top left that BuildPanel gives us.
@@ -53,9 +62,12 @@ ItemPanelContent::ItemPanelContent(Simulation& inSimulation, Network& inNetwork,
 , rightButton2{{738, 99, 140, 36}, "", "RightButton2"}
 , rightButton3{{738, 145, 140, 36}, "", "RightButton3"}
 , itemNotFoundLabel{{464, 113, 260, 36}, "ItemNotFoundLabel"}
-, itemCacheContainer{{0, 0, logicalExtent.w, logicalExtent.h},
+, itemCacheContainer{thumbnailAtlas,
+                     {0, 0, logicalExtent.w, logicalExtent.h},
                      "ItemCacheContainer"}
-, iconContainer{{0, 0, logicalExtent.w, logicalExtent.h}, "IconContainer"}
+, iconContainer{thumbnailAtlas,
+                {0, 0, logicalExtent.w, logicalExtent.h},
+                "IconContainer"}
 {
     // Add our children so they're included in rendering, etc.
     children.push_back(nameLabel);
@@ -103,7 +115,7 @@ ItemPanelContent::ItemPanelContent(Simulation& inSimulation, Network& inNetwork,
     createNewButton.setOnPressed([this]() { changeView(ViewType::Create); });
 
     /* Containers */
-    auto setContainerStyle = [](AUI::VerticalGridContainer& container) {
+    auto setContainerStyle = [](auto& container) {
         container.setNumColumns(11);
         container.setCellWidth(108);
         container.setCellHeight(109 + 1);
@@ -111,7 +123,24 @@ ItemPanelContent::ItemPanelContent(Simulation& inSimulation, Network& inNetwork,
     setContainerStyle(itemCacheContainer);
     setContainerStyle(iconContainer);
 
+    // Index our cached items.
+    for (const auto& [key, item] : itemData.getAllItems()) {
+        // Skip the null item.
+        if (!(item.numericID)) {
+            continue;
+        }
+
+        itemSearchIndex.setEntry(item.numericID, item.displayName,
+                                 item.stringID);
+    }
+
     // Add the item and icon thumbnails.
+    // Note: Thumbnails are only created and loaded as they scroll into view.
+    itemCacheContainer.setOnBindThumbnail(
+        [this](BuildModeThumbnail& thumbnail, std::size_t index) {
+            ItemID itemID{static_cast<ItemID>(itemCacheSearchResults[index])};
+            bindItemThumbnail(thumbnail, *(itemData.getItem(itemID)));
+        });
     refreshItemCacheThumbnails();
     addIconThumbnails();
 
@@ -129,6 +158,16 @@ void ItemPanelContent::reset()
     changeView(ViewType::Home);
 }
 
+void ItemPanelContent::setSearchQuery(std::string_view query)
+{
+    searchQuery = query;
+
+    refreshItemCacheThumbnails();
+
+    iconSearchIndex.search(searchQuery, iconSearchResults);
+    iconContainer.setItemCount(iconSearchResults.size());
+}
+
 void ItemPanelContent::onTick(double)
 {
     // Process any waiting messages, displaying any errors appropriately.
@@ -209,10 +248,13 @@ void ItemPanelContent::onItemUpdate(ItemID itemID)
 {
     // Note: We handle this signal instead of just receiving the update message
     //       in the UI, so that we can be sure ItemData is up-to-date before we
-    //       call getAllItems().
+    //       call getItem().
 
-    // If we requested this item, select it.
+    // Add or patch the item's cache thumbnail.
     const Item* item{itemData.getItem(itemID)};
+    updateItemCacheEntry(*item);
+
+    // If we requested this item, select it.
     if (requestedItemStringID == item->stringID) {
         // Select the item.
         selectedItemID = item->numericID;
@@ -256,9 +298,6 @@ void ItemPanelContent::onItemUpdate(ItemID itemID)
         initScriptReceived = false;
         network.serializeAndSend(ItemInitScriptRequest{selectedItemID});
     }
-
-    // Update the cache.
-    refreshItemCacheThumbnails();
 }
 
 void ItemPanelContent::sendItemChangeRequest()
@@ -328,81 +367,118 @@ void ItemPanelContent::changeView(ViewType newView)
 
 void ItemPanelContent::refreshItemCacheThumbnails()
 {
-    itemCacheContainer.clear();
+    // Find the items that match the current search, and re-bind every
+    // thumbnail.
+    itemSearchIndex.search(searchQuery, itemCacheSearchResults);
+    itemCacheContainer.setItemCount(itemCacheSearchResults.size());
+}
 
-    // Add thumbnails for all cached items.
-    for (const auto& [key, item] : itemData.getAllItems()) {
-        // Skip the null item.
-        if (!(item.numericID)) {
-            continue;
+void ItemPanelContent::updateItemCacheEntry(const Item& item)
+{
+    // Find where the item was in the cache view (if it was there).
+    SearchIndex::MatchType oldMatchType{
+        itemSearchIndex.getMatchType(item.numericID, searchQuery)};
+    std::size_t oldPosition{itemSearchIndex.findResultPosition(
+        itemCacheSearchResults, searchQuery, item.numericID, oldMatchType)};
+
+    // Update the item's index entry.
+    itemSearchIndex.setEntry(item.numericID, item.displayName, item.stringID);
+    SearchIndex::MatchType newMatchType{
+        itemSearchIndex.getMatchType(item.numericID, searchQuery)};
+
+    // If the item still matches the same way, it keeps its position. Patch
+    // its thumbnail in place.
+    // Note: Results are sorted by match type, then by ID.
+    if (newMatchType == oldMatchType) {
+        if (newMatchType != SearchIndex::MatchType::None) {
+            itemCacheContainer.refreshItem(oldPosition);
         }
+        return;
+    }
 
-        // Construct the new thumbnail.
-        std::unique_ptr<AUI::Widget> thumbnailPtr{
-            std::make_unique<BuildModeThumbnail>("ItemThumbnail")};
-        BuildModeThumbnail& thumbnail{
-            static_cast<BuildModeThumbnail&>(*thumbnailPtr)};
-        thumbnail.setText("");
-        thumbnail.setIsActivateable(false);
-
-        // Load the item's icon.
-        const IconRenderData& iconRenderData{
-            iconData.getRenderData(item.iconID)};
-        thumbnail.thumbnailImage.setSimpleImage(iconRenderData.iconSheetRelPath,
-                                                iconRenderData.textureExtent);
+    // Otherwise, move the item from its old position to its new one.
+    if (oldMatchType != SearchIndex::MatchType::None) {
+        itemCacheSearchResults.erase(itemCacheSearchResults.begin()
+                                     + oldPosition);
+        itemCacheContainer.removeItem(oldPosition);
+    }
+    if (newMatchType != SearchIndex::MatchType::None) {
+        std::size_t newPosition{itemSearchIndex.findResultPosition(
+            itemCacheSearchResults, searchQuery, item.numericID,
+            newMatchType)};
+        itemCacheSearchResults.insert(
+            (itemCacheSearchResults.begin() + newPosition), item.numericID);
+        itemCacheContainer.insertItem(newPosition);
+    }
+}
 
-        // When this thumbnail is selected, select the associated item and
-        // switch back to the home view.
-        thumbnail.setOnSelected(
-            [&, itemName{item.displayName}](AUI::Thumbnail*) {
-                trySelectItem(itemName);
+void ItemPanelContent::bindItemThumbnail(BuildModeThumbnail& thumbnail,
+                                         const Item& item)
+{
+    // Load the item's icon.
+    const IconRenderData& iconRenderData{iconData.getRenderData(item.iconID)};
+    thumbnailAtlas.setSimpleImage(thumbnail.thumbnailImage,
+                                  iconRenderData.iconSheetRelPath,
+                                  iconRenderData.textureExtent);
 
-                changeView(ViewType::Home);
-            });
+    // When this thumbnail is selected, select the associated item and
+    // switch back to the home view.
+    thumbnail.setOnSelected([&, itemName{item.displayName}](AUI::Thumbnail*) {
+        trySelectItem(itemName);
 
-        itemCacheContainer.push_back(std::move(thumbnailPtr));
-    }
+        changeView(ViewType::Home);
+    });
 }
 
 void ItemPanelContent::addIconThumbnails()
 {
-    // Add thumbnails for all icons.
+    // Gather all icons and index their names.
+    iconThumbnailData.clear();
+    iconSearchIndex.clear();
     for (const Icon& icon : iconData.getAllIcons()) {
-        // Construct the new thumbnail.
-        std::unique_ptr<AUI::Widget> thumbnailPtr{
-            std::make_unique<BuildModeThumbnail>("IconThumbnail")};
-        BuildModeThumbnail& thumbnail{
-            static_cast<BuildModeThumbnail&>(*thumbnailPtr)};
-        thumbnail.setText("");
-        thumbnail.setIsActivateable(false);
-
-        // Load the icon.
-        const IconRenderData& iconRenderData{
-            iconData.getRenderData(icon.numericID)};
-        thumbnail.thumbnailImage.setSimpleImage(iconRenderData.iconSheetRelPath,
-                                                iconRenderData.textureExtent);
-
-        // When this thumbnail is selected, select the associated icon and
-        // switch back to the edit view.
-        thumbnail.setOnMouseDown(
-            [&, iconID{icon.numericID}](AUI::Thumbnail*,
-                                        AUI::MouseButtonType buttonType) {
-                if (buttonType == AUI::MouseButtonType::Left) {
-                    // Set the new icon and request the server update the item.
-                    selectedItemIconID = iconID;
-                    sendItemChangeRequest();
-
-                    changeView(ViewType::Edit);
-
-                    return true;
-                }
-                else {
-                    return false;
-                }
-            });
-
-        iconContainer.push_back(std::move(thumbnailPtr));
+        iconSearchIndex.setEntry(static_cast<Uint32>(iconThumbnailData.size()),
+                                 icon.displayName, icon.stringID);
+        iconThumbnailData.push_back(&icon);
     }
+
+    // Thumbnails are only created and loaded as they scroll into view.
+    iconContainer.setOnBindThumbnail(
+        [this](BuildModeThumbnail& thumbnail, std::size_t index) {
+            bindIconThumbnail(thumbnail,
+                              *(iconThumbnailData[iconSearchResults[index]]));
+        });
+    iconSearchIndex.search(searchQuery, iconSearchResults);
+    iconContainer.setItemCount(iconSearchResults.size());
+}
+
+void ItemPanelContent::bindIconThumbnail(BuildModeThumbnail& thumbnail,
+                                         const Icon& icon)
+{
+    // Load the icon.
+    const IconRenderData& iconRenderData{
+        iconData.getRenderData(icon.numericID)};
+    thumbnailAtlas.setSimpleImage(thumbnail.thumbnailImage,
+                                  iconRenderData.iconSheetRelPath,
+                                  iconRenderData.textureExtent);
+
+    // When this thumbnail is selected, select the associated icon and
+    // switch back to the edit view.
+    thumbnail.setOnMouseDown(
+        [&, iconID{icon.numericID}](AUI::Thumbnail*,
+                                    AUI::MouseButtonType buttonType) {
+            if (buttonType == AUI::MouseButtonType::Left) {
+                // Set the new icon and request the server update the item.
+                selectedItemIconID = iconID;
+                sendItemChangeRequest();
+
+                changeView(ViewType::Edit);
+
+                return true;
+            }
+            else {
+                return false;
+            }
+        });
 }
 
 void ItemPanelContent::showHomeView()
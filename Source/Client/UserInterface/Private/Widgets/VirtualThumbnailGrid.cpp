@@ -0,0 +1,267 @@
+#include "VirtualThumbnailGrid.h"
+#include "BuildModeThumbnail.h"
+#include <algorithm>
+
+namespace AM
+{
+namespace Client
+{
+VirtualThumbnailGrid::VirtualThumbnailGrid(
+    const ThumbnailAtlas& inThumbnailAtlas, const SDL_Rect& inLogicalExtent,
+    const std::string& inDebugName)
+: AUI::Widget(inLogicalExtent, inDebugName)
+, thumbnailAtlas{inThumbnailAtlas}
+, onBindThumbnail{}
+, numColumns{1}
+, cellWidth{1}
+, cellHeight{1}
+, itemCount{0}
+, firstVisibleRow{0}
+, thumbnails{}
+, activeThumbnailCount{0}
+, boundItemIndices{}
+, selectedItemIndex{NO_SELECTION}
+{
+}
+
+void VirtualThumbnailGrid::setNumColumns(int inNumColumns)
+{
+    numColumns = std::max(inNumColumns, 1);
+    clampScroll();
+    updateThumbnails();
+}
+
+void VirtualThumbnailGrid::setCellWidth(int inCellWidth)
+{
+    cellWidth = inCellWidth;
+    updateThumbnails();
+}
+
+void VirtualThumbnailGrid::setCellHeight(int inCellHeight)
+{
+    cellHeight = std::max(inCellHeight, 1);
+    clampScroll();
+    updateThumbnails();
+}
+
+void VirtualThumbnailGrid::setItemCount(std::size_t inItemCount)
+{
+    itemCount = inItemCount;
+    clampScroll();
+
+    // The items may have changed, so every thumbnail needs to be re-bound and
+    // the selection may no longer refer to the same item.
+    clearSelectedItem();
+    std::fill(boundItemIndices.begin(), boundItemIndices.end(), NOT_BOUND);
+    updateThumbnails();
+}
+
+std::size_t VirtualThumbnailGrid::getItemCount() const
+{
+    return itemCount;
+}
+
+void VirtualThumbnailGrid::insertItem(std::size_t index)
+{
+    // The items after the new one each moved forward by one.
+    itemCount++;
+    if ((selectedItemIndex != NO_SELECTION) && (selectedItemIndex >= index)) {
+        selectedItemIndex++;
+    }
+    unbindFrom(index);
+    updateThumbnails();
+}
+
+void VirtualThumbnailGrid::removeItem(std::size_t index)
+{
+    // The items after the removed one each moved back by one.
+    itemCount--;
+    if (selectedItemIndex == index) {
+        clearSelectedItem();
+    }
+    else if ((selectedItemIndex != NO_SELECTION)
+             && (selectedItemIndex > index)) {
+        selectedItemIndex--;
+    }
+    clampScroll();
+    unbindFrom(index);
+    updateThumbnails();
+}
+
+void VirtualThumbnailGrid::refreshItem(std::size_t index)
+{
+    // If the item doesn't have a thumbnail, it'll be bound when it comes
+    // into range.
+    BuildModeThumbnail* thumbnail{getBoundThumbnail(index)};
+    if (thumbnail == nullptr) {
+        return;
+    }
+
+    // Re-bind the item's thumbnail in place, keeping its selection state.
+    if (onBindThumbnail) {
+        onBindThumbnail(*thumbnail, index);
+    }
+}
+
+void VirtualThumbnailGrid::setSelectedItem(std::size_t index)
+{
+    if (index == selectedItemIndex) {
+        return;
+    }
+
+    clearSelectedItem();
+    selectedItemIndex = index;
+
+    // If the item has a thumbnail, select it. If it doesn't, it'll be selected
+    // when it's bound.
+    // Note: If the user clicked the thumbnail, it's already selected.
+    BuildModeThumbnail* thumbnail{getBoundThumbnail(index)};
+    if ((thumbnail != nullptr) && !(thumbnail->getIsSelected())) {
+        thumbnail->select();
+    }
+}
+
+void VirtualThumbnailGrid::clearSelectedItem()
+{
+    if (selectedItemIndex == NO_SELECTION) {
+        return;
+    }
+
+    if (BuildModeThumbnail* thumbnail{getBoundThumbnail(selectedItemIndex)}) {
+        thumbnail->deselect();
+    }
+    selectedItemIndex = NO_SELECTION;
+}
+
+std::size_t VirtualThumbnailGrid::getSelectedItem() const
+{
+    return selectedItemIndex;
+}
+
+void VirtualThumbnailGrid::setOnBindThumbnail(
+    std::function<void(BuildModeThumbnail&, std::size_t)> inOnBindThumbnail)
+{
+    onBindThumbnail = std::move(inOnBindThumbnail);
+}
+
+AUI::EventResult VirtualThumbnailGrid::onMouseWheel(int amountScrolled)
+{
+    // Note: Positive values scroll up, so we move towards the first row.
+    int previousFirstRow{firstVisibleRow};
+    firstVisibleRow -= amountScrolled;
+    clampScroll();
+
+    if (firstVisibleRow != previousFirstRow) {
+        updateThumbnails();
+    }
+
+    return AUI::EventResult{.wasHandled{true}};
+}
+
+int VirtualThumbnailGrid::getVisibleRowCount() const
+{
+    return std::max((logicalExtent.h / cellHeight), 1);
+}
+
+int VirtualThumbnailGrid::getRowCount() const
+{
+    std::size_t columns{static_cast<std::size_t>(numColumns)};
+    return static_cast<int>((itemCount + columns - 1) / columns);
+}
+
+void VirtualThumbnailGrid::clampScroll()
+{
+    int maxFirstRow{std::max((getRowCount() - getVisibleRowCount()), 0)};
+    firstVisibleRow = std::clamp(firstVisibleRow, 0, maxFirstRow);
+}
+
+void VirtualThumbnailGrid::updateThumbnails()
+{
+    // If the layout changed, resize the set of thumbnails that we use.
+    int visibleRowCount{getVisibleRowCount()};
+    std::size_t neededThumbnailCount{static_cast<std::size_t>(
+        (visibleRowCount + (MARGIN_ROWS * 2)) * numColumns)};
+    if (neededThumbnailCount != activeThumbnailCount) {
+        while (thumbnails.size() < neededThumbnailCount) {
+            thumbnails.push_back(std::make_unique<BuildModeThumbnail>(
+                thumbnailAtlas, "VirtualGridThumbnail"));
+            thumbnails.back()->setText("");
+            thumbnails.back()->setIsActivateable(false);
+
+            // Add our children so they're included in rendering, etc.
+            children.push_back(*(thumbnails.back()));
+        }
+        boundItemIndices.assign(thumbnails.size(), NOT_BOUND);
+        activeThumbnailCount = neededThumbnailCount;
+    }
+
+    // Hide everything. We'll re-show the visible thumbnails below.
+    for (std::unique_ptr<BuildModeThumbnail>& thumbnail : thumbnails) {
+        thumbnail->setIsVisible(false);
+    }
+
+    // Bind and position the thumbnails for the rows that are in range.
+    std::size_t columns{static_cast<std::size_t>(numColumns)};
+    int firstBoundRow{std::max((firstVisibleRow - MARGIN_ROWS), 0)};
+    int endVisibleRow{firstVisibleRow + visibleRowCount};
+    std::size_t firstIndex{static_cast<std::size_t>(firstBoundRow) * columns};
+    std::size_t endIndex{std::min(
+        (static_cast<std::size_t>(endVisibleRow + MARGIN_ROWS) * columns),
+        itemCount)};
+    for (std::size_t itemIndex{firstIndex}; itemIndex < endIndex;
+         ++itemIndex) {
+        std::size_t thumbnailIndex{itemIndex % activeThumbnailCount};
+        BuildModeThumbnail& thumbnail{*(thumbnails[thumbnailIndex])};
+
+        // If this thumbnail isn't already showing this item, re-bind it.
+        if (boundItemIndices[thumbnailIndex] != itemIndex) {
+            // Note: The selection belonged to the old item, so we drop it,
+            //       then re-select if the new item is the selected one.
+            thumbnail.deselect();
+            if (onBindThumbnail) {
+                onBindThumbnail(thumbnail, itemIndex);
+            }
+            boundItemIndices[thumbnailIndex] = itemIndex;
+            if (itemIndex == selectedItemIndex) {
+                thumbnail.select();
+            }
+        }
+
+        // If this item's row is on screen, show it.
+        int row{static_cast<int>(itemIndex / columns)};
+        if ((row >= firstVisibleRow) && (row < endVisibleRow)) {
+            int column{static_cast<int>(itemIndex % columns)};
+            SDL_Rect thumbnailExtent{thumbnail.getLogicalExtent()};
+            thumbnailExtent.x = column * cellWidth;
+            thumbnailExtent.y = (row - firstVisibleRow) * cellHeight;
+            thumbnail.setLogicalExtent(thumbnailExtent);
+            thumbnail.setIsVisible(true);
+        }
+    }
+}
+
+void VirtualThumbnailGrid::unbindFrom(std::size_t index)
+{
+    for (std::size_t& boundItemIndex : boundItemIndices) {
+        if (boundItemIndex >= index) {
+            boundItemIndex = NOT_BOUND;
+        }
+    }
+}
+
+BuildModeThumbnail* VirtualThumbnailGrid::getBoundThumbnail(std::size_t index)
+{
+    if (activeThumbnailCount == 0) {
+        return nullptr;
+    }
+
+    std::size_t thumbnailIndex{index % activeThumbnailCount};
+    if (boundItemIndices[thumbnailIndex] != index) {
+        return nullptr;
+    }
+
+    return thumbnails[thumbnailIndex].get();
+}
+
+} // End namespace Client
+} // End namespace AM
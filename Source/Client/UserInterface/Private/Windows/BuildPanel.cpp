@@ -8,10 +8,12 @@
 #include "IconData.h"
 #include "BuildOverlay.h"
 #include "BuildModeThumbnail.h"
+#include "ThumbnailAtlas.h"
 #include "EntityTool.h"
 #include "SharedConfig.h"
 #include "Paths.h"
 #include "AMAssert.h"
+#include <algorithm>
 
 namespace AM
 {
@@ -19,29 +21,41 @@ namespace Client
 {
 BuildPanel::BuildPanel(Simulation& inSimulation, Network& inNetwork,
                        GraphicData& inGraphicData, ItemData& inItemData,
-                       IconData& inIconData, BuildOverlay& inBuildOverlay)
+                       IconData& inIconData,
+                       const ThumbnailAtlas& inThumbnailAtlas,
+                       BuildOverlay& inBuildOverlay)
 : AUI::Window{{0, 761, 1920, 319}, "BuildPanel"}
 , network{inNetwork}
 , graphicData{inGraphicData}
+, thumbnailAtlas{inThumbnailAtlas}
 , buildOverlay{inBuildOverlay}
 , selectedThumbnail{nullptr}
+, selectedTileDataIndex{NO_TILE_SELECTION}
+, currentBuildMode{BuildMode::Type::None}
+, terrainThumbnails{}
+, floorThumbnails{}
+, wallThumbnails{}
+, objectThumbnails{}
 , backgroundImage{{0, 0, 1920, 319}, "BuildPanelBackground"}
-, terrainContainer{{366, 91, 1188, 220}, "TerrainContainer"}
-, floorContainer{{366 - 2, 91, 1188, 220}, "FloorContainer"}
-, wallContainer{{366, 91, 1188, 220}, "WallContainer"}
-, objectContainer{{366, 91, 1188, 220}, "ObjectContainer"}
+, terrainContainer{thumbnailAtlas, {366, 91, 1188, 220}, "TerrainContainer"}
+, floorContainer{thumbnailAtlas, {366 - 2, 91, 1188, 220}, "FloorContainer"}
+, wallContainer{thumbnailAtlas, {366, 91, 1188, 220}, "WallContainer"}
+, objectContainer{thumbnailAtlas, {366, 91, 1188, 220}, "ObjectContainer"}
 , entityPanelContent{inSimulation.getWorld(),
                      network,
                      graphicData,
+                     thumbnailAtlas,
                      *this,
                      {366, 91, 1188, 220},
                      "EntityPanelContent"}
 , removeHintText{{679, 171, 562, 36}, "RemoveHintText"}
 , itemPanelContent{inSimulation,         network,
                    inItemData,           inIconData,
-                   {366, 91, 1188, 220}, "ItemPanelContent"}
+                   thumbnailAtlas,       {366, 91, 1188, 220},
+                   "ItemPanelContent"}
 , tileLayersLabel{{152, 92, 138, 36}, "TileLayersLabel"}
 , otherLabel{{1630, 92, 138, 36}, "OtherLabel"}
+, searchInput{{1294, 44, 260, 42}, "SearchInput"}
 , buildModeButtons{
       MainButton{{164, 132, 114, 32}, "Terrain", "TerrainToolButton"},
       MainButton{{164, 168, 114, 32}, "Floor", "FloorToolButton"},
@@ -62,6 +76,7 @@ BuildPanel::BuildPanel(Simulation& inSimulation, Network& inNetwork,
     children.push_back(itemPanelContent);
     children.push_back(tileLayersLabel);
     children.push_back(otherLabel);
+    children.push_back(searchInput);
     children.push_back(buildModeButtons[BuildMode::Type::Terrain]);
     children.push_back(buildModeButtons[BuildMode::Type::Floor]);
     children.push_back(buildModeButtons[BuildMode::Type::Wall]);
@@ -78,7 +93,7 @@ BuildPanel::BuildPanel(Simulation& inSimulation, Network& inNetwork,
           (Paths::TEXTURE_DIR + "BuildPanel/Background_1920.png")}});
 
     /* Containers */
-    auto setContainerStyle = [](AUI::VerticalGridContainer& container) {
+    auto setContainerStyle = [](VirtualThumbnailGrid& container) {
         container.setNumColumns(11);
         container.setCellWidth(108);
         container.setCellHeight(109 + 1);
@@ -108,6 +123,23 @@ BuildPanel::BuildPanel(Simulation& inSimulation, Network& inNetwork,
     removeHintText.setText("Click on a Tile Layer or Entity to remove it.");
     removeHintText.setIsVisible(false);
 
+    /* Search input */
+    searchInput.normalImage.setNineSliceImage(
+        (Paths::TEXTURE_DIR + "TextInput/Normal.png"), {8, 8, 8, 8});
+    searchInput.hoveredImage.setNineSliceImage(
+        (Paths::TEXTURE_DIR + "TextInput/Hovered.png"), {8, 8, 8, 8});
+    searchInput.focusedImage.setNineSliceImage(
+        (Paths::TEXTURE_DIR + "TextInput/Focused.png"), {8, 8, 8, 8});
+    searchInput.setTextFont(((Paths::FONT_DIR + "Cagliostro-Regular.ttf")), 20);
+    searchInput.setTextColor({255, 255, 255, 255});
+    searchInput.setPadding({0, 14, 0, 14});
+    searchInput.setCursorWidth(2);
+    searchInput.setCursorColor({255, 255, 255, 255});
+    searchInput.setIsVisible(false);
+
+    // Re-filter the content as the user types.
+    searchInput.setOnTextChanged([this]() { applySearch(); });
+
     /* Build tool buttons. */
     buildModeButtons[BuildMode::Type::Terrain].text.setFont(
         (Paths::FONT_DIR + "Cagliostro-Regular.ttf"), 18);
@@ -158,6 +190,25 @@ BuildPanel::BuildPanel(Simulation& inSimulation, Network& inNetwork,
         addTileGraphicSet(TileLayer::Type::Object, graphicSet,
                          getFirstSprite(graphicSet));
     }
+
+    // Tell the containers how to fill their thumbnails, and how many there
+    // are.
+    // Note: The containers show the search results, which start out as every
+    //       graphic set.
+    auto setContainerData = [this](VirtualThumbnailGrid& container,
+                                   TileThumbnailList& list) {
+        container.setOnBindThumbnail(
+            [this, &container, &list](BuildModeThumbnail& thumbnail,
+                                      std::size_t index) {
+                bindTileThumbnail(container, list, thumbnail, index);
+            });
+        list.searchIndex.search("", list.searchResults);
+        container.setItemCount(list.searchResults.size());
+    };
+    setContainerData(terrainContainer, terrainThumbnails);
+    setContainerData(floorContainer, floorThumbnails);
+    setContainerData(wallContainer, wallThumbnails);
+    setContainerData(objectContainer, objectThumbnails);
 }
 
 void BuildPanel::setSelectedThumbnail(AUI::Thumbnail& newSelectedThumbnail)
@@ -176,24 +227,55 @@ void BuildPanel::clearSelectedThumbnail()
         selectedThumbnail->deselect();
         selectedThumbnail = nullptr;
     }
+
+    // Note: Only the current build mode's container can have a selection,
+    //       but clearing all of them is cheap.
+    selectedTileDataIndex = NO_TILE_SELECTION;
+    terrainContainer.clearSelectedItem();
+    floorContainer.clearSelectedItem();
+    wallContainer.clearSelectedItem();
+    objectContainer.clearSelectedItem();
 }
 
 void BuildPanel::addTileGraphicSet(TileLayer::Type type,
                                    const GraphicSet& graphicSet,
                                    const Sprite& sprite)
 {
-    // Construct the new graphic set thumbnail.
-    std::unique_ptr<AUI::Widget> thumbnailPtr{
-        std::make_unique<BuildModeThumbnail>("BuildPanelThumbnail")};
-    BuildModeThumbnail& thumbnail{
-        static_cast<BuildModeThumbnail&>(*thumbnailPtr)};
-    thumbnail.setText("");
-    thumbnail.setIsActivateable(false);
+    TileThumbnailList* list{nullptr};
+    if (type == TileLayer::Type::Terrain) {
+        list = &terrainThumbnails;
+    }
+    else if (type == TileLayer::Type::Floor) {
+        list = &floorThumbnails;
+    }
+    else if (type == TileLayer::Type::Wall) {
+        list = &wallThumbnails;
+    }
+    else if (type == TileLayer::Type::Object) {
+        list = &objectThumbnails;
+    }
+    else {
+        return;
+    }
+
+    // Add the graphic set and index its name.
+    list->searchIndex.setEntry(static_cast<Uint32>(list->thumbnailData.size()),
+                               graphicSet.displayName, graphicSet.stringID);
+    list->thumbnailData.push_back({&graphicSet, &sprite});
+}
+
+void BuildPanel::bindTileThumbnail(VirtualThumbnailGrid& container,
+                                   TileThumbnailList& list,
+                                   BuildModeThumbnail& thumbnail,
+                                   std::size_t itemIndex)
+{
+    Uint32 dataIndex{list.searchResults[itemIndex]};
+    const TileThumbnailData& thumbnailData{list.thumbnailData[dataIndex]};
 
     // Calc a square texture extent that shows the bottom of the sprite (so we
     // don't have to squash it).
     const SpriteRenderData& renderData{
-        graphicData.getSpriteRenderData(sprite.numericID)};
+        graphicData.getSpriteRenderData(thumbnailData.sprite->numericID)};
     SDL_Rect textureExtent{renderData.textureExtent};
     if (textureExtent.h > textureExtent.w) {
         int diff{textureExtent.h - textureExtent.w};
@@ -202,30 +284,35 @@ void BuildPanel::addTileGraphicSet(TileLayer::Type type,
     }
 
     // Load the sprite's image.
-    thumbnail.thumbnailImage.setSimpleImage(renderData.spriteSheetRelPath,
-                                            textureExtent, SDL_ScaleModeLinear);
+    thumbnailAtlas.setSimpleImage(thumbnail.thumbnailImage,
+                                  renderData.spriteSheetRelPath, textureExtent,
+                                  SDL_ScaleModeLinear);
 
     // Add a callback to deactivate all other thumbnails when one is activated.
-    thumbnail.setOnSelected([this, &graphicSet](AUI::Thumbnail* selectedThumb) {
-        // Set this thumbnail as the new selection.
-        setSelectedThumbnail(*selectedThumb);
+    // Note: The thumbnail will be recycled, so we select by index.
+    const GraphicSet& graphicSet{*(thumbnailData.graphicSet)};
+    thumbnail.setOnSelected(
+        [this, &container, itemIndex, dataIndex, &graphicSet](AUI::Thumbnail*) {
+            // Set this item as the new selection.
+            setSelectedTileItem(container, itemIndex, dataIndex);
 
-        // Tell the overlay that the selected graphic set changed.
-        buildOverlay.setSelectedGraphicSet(graphicSet);
-    });
+            // Tell the overlay that the selected graphic set changed.
+            buildOverlay.setSelectedGraphicSet(graphicSet);
+        });
+}
 
-    if (type == TileLayer::Type::Terrain) {
-        terrainContainer.push_back(std::move(thumbnailPtr));
-    }
-    else if (type == TileLayer::Type::Floor) {
-        floorContainer.push_back(std::move(thumbnailPtr));
-    }
-    else if (type == TileLayer::Type::Wall) {
-        wallContainer.push_back(std::move(thumbnailPtr));
-    }
-    else if (type == TileLayer::Type::Object) {
-        objectContainer.push_back(std::move(thumbnailPtr));
+void BuildPanel::setSelectedTileItem(VirtualThumbnailGrid& container,
+                                     std::size_t itemIndex, Uint32 dataIndex)
+{
+    // If there's an old entity template selection, deselect it.
+    if (selectedThumbnail != nullptr) {
+        selectedThumbnail->deselect();
+        selectedThumbnail = nullptr;
     }
+
+    // Note: The container deselects its old selection.
+    selectedTileDataIndex = dataIndex;
+    container.setSelectedItem(itemIndex);
 }
 
 template<typename T>
@@ -246,10 +333,7 @@ const Sprite& BuildPanel::getFirstSprite(const T& graphicSet)
 void BuildPanel::setBuildMode(BuildMode::Type buildModeType)
 {
     // When we switch build tools, we deselect any selected thumbnails.
-    if (selectedThumbnail != nullptr) {
-        selectedThumbnail->deselect();
-        selectedThumbnail = nullptr;
-    }
+    clearSelectedThumbnail();
 
     // Set the overlay to the given build mode.
     buildOverlay.setBuildMode(buildModeType);
@@ -263,6 +347,12 @@ void BuildPanel::setBuildMode(BuildMode::Type buildModeType)
     removeHintText.setIsVisible(false);
     itemPanelContent.setIsVisible(false);
 
+    // Clear the last mode's search. The remove tool has nothing to search.
+    currentBuildMode = buildModeType;
+    searchInput.setText("");
+    searchInput.setIsVisible(buildModeType != BuildMode::Type::Remove);
+    applySearch();
+
     if (buildModeType == BuildMode::Type::Terrain) {
         terrainContainer.setIsVisible(true);
     }
@@ -289,5 +379,45 @@ void BuildPanel::setBuildMode(BuildMode::Type buildModeType)
     }
 }
 
+void BuildPanel::applySearch()
+{
+    // Filter the given tile layer container to the matching graphic sets.
+    // If the selected graphic set is still shown, re-select it at its new
+    // index.
+    const std::string& query{searchInput.getText()};
+    auto filterContainer = [this, &query](VirtualThumbnailGrid& container,
+                                          TileThumbnailList& list) {
+        list.searchIndex.search(query, list.searchResults);
+        container.setItemCount(list.searchResults.size());
+
+        auto resultIt{std::find(list.searchResults.begin(),
+                                list.searchResults.end(),
+                                selectedTileDataIndex)};
+        if (resultIt != list.searchResults.end()) {
+            container.setSelectedItem(static_cast<std::size_t>(
+                resultIt - list.searchResults.begin()));
+        }
+    };
+
+    if (currentBuildMode == BuildMode::Type::Terrain) {
+        filterContainer(terrainContainer, terrainThumbnails);
+    }
+    else if (currentBuildMode == BuildMode::Type::Floor) {
+        filterContainer(floorContainer, floorThumbnails);
+    }
+    else if (currentBuildMode == BuildMode::Type::Wall) {
+        filterContainer(wallContainer, wallThumbnails);
+    }
+    else if (currentBuildMode == BuildMode::Type::Object) {
+        filterContainer(objectContainer, objectThumbnails);
+    }
+    else if (currentBuildMode == BuildMode::Type::Entity) {
+        entityPanelContent.setSearchQuery(query);
+    }
+    else if (currentBuildMode == BuildMode::Type::Item) {
+        itemPanelContent.setSearchQuery(query);
+    }
+}
+
 } // End namespace Client
 } // End namespace AM
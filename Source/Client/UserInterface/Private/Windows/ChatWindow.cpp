@@ -3,8 +3,10 @@
 #include "Network.h"
 #include "CastFailed.h"
 #include "Paths.h"
+#include "PerformanceProfiler.h"
 #include "AUI/ScalingHelpers.h"
 #include <SDL_render.h>
+#include <algorithm>
 #include <cmath>
 
 namespace AM
@@ -24,14 +26,22 @@ ChatWindow::ChatWindow(Simulation& inSimulation, Network& inNetwork,
 , renderTexture{nullptr}
 , textureExtent{0, 0, 0, 0}
 , systemMessageQueue{inNetwork.getEventDispatcher()}
-, messageContainer({0, 0, logicalExtent.w, logicalExtent.h}, "MessageContainer")
+, glyphAtlas{inSdlRenderer, (Paths::FONT_DIR + "Cagliostro-Regular.ttf"), 20}
+, newestMessageIndex{MAX_MESSAGES - 1}
+, messageCount{0}
+, messageTexts{}
 {
-    // Add our children so they're included in rendering, etc.
-    children.push_back(messageContainer);
-
-    /* Message container. */
-    messageContainer.setFlowDirection(
-        AUI::VerticalListContainer::FlowDirection::BottomToTop);
+    // Allocate our message widgets up front, so adding a message never has
+    // to.
+    messageTexts.reserve(MAX_MESSAGES);
+    for (std::size_t i{0}; i < MAX_MESSAGES; ++i) {
+        messageTexts.push_back(std::make_unique<AtlasText>(
+            glyphAtlas, SDL_Rect{0, 0, logicalExtent.w, 0}, "MessageText"));
+        messageTexts.back()->setIsVisible(false);
+
+        // Add our children so they're included in rendering, etc.
+        children.push_back(*(messageTexts.back()));
+    }
 
     // When a cast fails, print a message to the chat.
     inSimulation.getCastFailedSink().connect<&ChatWindow::addCastFailedMessage>(
@@ -40,25 +50,12 @@ ChatWindow::ChatWindow(Simulation& inSimulation, Network& inNetwork,
 
 void ChatWindow::addChatMessage(std::string_view message)
 {
-    // Add the new text.
-    // Note: The widget's height will be auto-adjusted to fit the given
-    // text.
-    std::unique_ptr<AUI::Widget> textPtr{std::make_unique<AUI::Text>(
-        SDL_Rect{0, 0, logicalExtent.w, 0}, "SystemMessageText")};
-    AUI::Text& text{static_cast<AUI::Text&>(*textPtr)};
-    text.setFont((Paths::FONT_DIR + "Cagliostro-Regular.ttf"), 20);
-    text.setColor({255, 255, 255, 255});
-    text.setText(message);
-    text.setAutoHeightEnabled(true);
-    text.refreshTexture();
-
-    messageContainer.insert(messageContainer.begin(), std::move(textPtr));
-
-    // If the container has more than our max text widgets, erase the
-    // oldest one.
-    if (messageContainer.size() > MAX_MESSAGES) {
-        messageContainer.erase(messageContainer.end() - 1);
-    }
+    // Recycle the oldest message's widget for the new message.
+    newestMessageIndex = (newestMessageIndex + 1) % MAX_MESSAGES;
+    messageTexts[newestMessageIndex]->setText(message);
+    messageCount = std::min((messageCount + 1), MAX_MESSAGES);
+
+    layoutMessages();
 
     idleTimer.reset();
     shouldFade = false;
@@ -103,6 +100,15 @@ void ChatWindow::onTick(double)
 
 void ChatWindow::measure()
 {
+    // If the UI scale changed, re-rasterize our glyphs and re-wrap the
+    // messages to match.
+    if (glyphAtlas.refresh()) {
+        for (std::unique_ptr<AtlasText>& messageText : messageTexts) {
+            messageText->refreshLayout();
+        }
+        layoutMessages();
+    }
+
     // Run the normal measure step.
     Window::measure();
 
@@ -117,6 +123,7 @@ void ChatWindow::measure()
         if (rawTexture == nullptr) {
             LOG_FATAL("Failed to create texture: %s", SDL_GetError());
         }
+        PerformanceProfiler::countTextureCreation();
         renderTexture = std::shared_ptr<SDL_Texture>(
             rawTexture, [](SDL_Texture* p) { SDL_DestroyTexture(p); });
 
@@ -183,5 +190,29 @@ void ChatWindow::addCastFailedMessage(const CastFailed& castFailed)
     }
 }
 
+void ChatWindow::layoutMessages()
+{
+    // Stack the messages upwards from the bottom, newest first.
+    int nextBottom{logicalExtent.h};
+    for (std::size_t i{0}; i < MAX_MESSAGES; ++i) {
+        AtlasText& messageText{
+            *(messageTexts[(newestMessageIndex + MAX_MESSAGES - i)
+                           % MAX_MESSAGES])};
+
+        // If we've run out of messages or room, hide the rest.
+        SDL_Rect textExtent{messageText.getLogicalExtent()};
+        if ((i >= messageCount) || (textExtent.h > nextBottom)) {
+            messageText.setIsVisible(false);
+            nextBottom = -1;
+            continue;
+        }
+
+        nextBottom -= textExtent.h;
+        textExtent.y = nextBottom;
+        messageText.setLogicalExtent(textExtent);
+        messageText.setIsVisible(true);
+    }
+}
+
 } // End namespace Client
 } // End namespace AM
@@ -3,6 +3,7 @@
 #include "Network.h"
 #include "ItemData.h"
 #include "IconData.h"
+#include "ThumbnailAtlas.h"
 #include "ViewModel.h"
 #include "InteractionManager.h"
 #include "Paths.h"
@@ -12,6 +13,7 @@
 #include "InventoryOperation.h"
 #include "AUI/ScalingHelpers.h"
 #include "entt/entity/registry.hpp"
+#include <algorithm>
 
 namespace AM
 {
@@ -19,6 +21,7 @@ namespace Client
 {
 InventoryWindow::InventoryWindow(Simulation& inSimulation, Network& inNetwork,
                                  ItemData& inItemData, IconData& inIconData,
+                                 const ThumbnailAtlas& inThumbnailAtlas,
                                  ViewModel& inViewModel,
                                  InteractionManager& inInteractionManager)
 : AUI::Window({1362, 340, 256, 256}, "InventoryWindow")
@@ -26,9 +29,11 @@ InventoryWindow::InventoryWindow(Simulation& inSimulation, Network& inNetwork,
 , network{inNetwork}
 , itemData{inItemData}
 , iconData{inIconData}
+, thumbnailAtlas{inThumbnailAtlas}
 , viewModel{inViewModel}
 , interactionManager{inInteractionManager}
-, wasRefreshed{false}
+, displayedSlots{}
+, changedSlots{}
 , backgroundImage({0, 0, logicalExtent.w, logicalExtent.h}, "BackgroundImage")
 , slotContainer({12, 12, (logicalExtent.w - 24), (logicalExtent.h - 24)},
                 "SlotContainer")
@@ -59,67 +64,98 @@ void InventoryWindow::arrange()
     // Run the normal arrange step.
     Window::arrange();
 
-    // Items in the inventory may have changed, causing our old hover state to 
-    // be incorrect. If the mouse is hovering over the inventory, update 
+    // Items in the inventory may have changed, causing our old hover state to
+    // be incorrect. If the mouse is hovering over a changed slot, update
     // the model's hover state.
     // Note: We have to wait until after layout, so the thumbnails are in their
     //       actual position.
-    if (wasRefreshed) {
-        wasRefreshed = false;
-
+    if (!changedSlots.empty()) {
         // Get the current mouse position and make it window-relative.
         SDL_Point cursorPosition{};
         SDL_GetMouseState(&(cursorPosition.x), &(cursorPosition.y));
         cursorPosition.x -= scaledExtent.x;
         cursorPosition.y -= scaledExtent.y;
 
-        // If the mouse isn't in the inventory, no items are being hovered and
-        // none were being hovered before the update. Do nothing.
-        if (!containsPoint(cursorPosition)) {
-            return;
-        }
+        // If the mouse is in the inventory, check if it's over a changed
+        // slot. The hover state of the unchanged slots is still correct.
+        if (containsPoint(cursorPosition)) {
+            for (Uint8 slotIndex : changedSlots) {
+                ItemThumbnail& thumbnail{getSlotThumbnail(slotIndex)};
+                if (!(thumbnail.containsPoint(cursorPosition))) {
+                    continue;
+                }
 
-        // If we're hovering an item thumbnail, update the model.
-        bool hoveringItem{false};
-        for (Uint8 slotIndex = 0; slotIndex < slotContainer.size();
-             ++slotIndex) {
-            std::unique_ptr<AUI::Widget>& item{slotContainer[slotIndex]};
-            if (item->getIsVisible() && item->containsPoint(cursorPosition)) {
-                std::string tooltipString{
-                    interactionManager.getItemTooltipString(slotIndex)};
-                viewModel.setHoveredItem(tooltipString);
-                hoveringItem = true;
+                // If the slot still exists, show its new item (the tooltip
+                // string will be empty if there isn't one). If it was
+                // removed, unhover it.
+                if (thumbnail.getIsVisible()) {
+                    std::string tooltipString{
+                        interactionManager.getItemTooltipString(slotIndex)};
+                    viewModel.setHoveredItem(tooltipString);
+                }
+                else {
+                    viewModel.clearHoveredItem();
+                }
+                break;
             }
         }
 
-        // If we aren't hovering an item, tell the model to unhover since we 
-        // may been hovering an item before the update.
-        if (!hoveringItem) {
-            viewModel.clearHoveredItem();
-        }
+        changedSlots.clear();
     }
 }
 
 void InventoryWindow::refresh(const Inventory& inventory)
 {
-    // If an item was selected, deselect it.
-    interactionManager.itemDeselected();
-
-    // Add thumbnails for each slot in the player's inventory.
-    slotContainer.clear();
-    for (Uint8 slotIndex = 0; slotIndex < inventory.slots.size(); ++slotIndex) {
-        // Assume that the slot is empty and add an empty thumbnail.
-        ItemThumbnail& thumbnail{addEmptyThumbnail(slotIndex)};
-
-        // If the slot has an item in it, build the empty thumbnail into a
-        // full item thumbnail.
-        const Inventory::ItemSlot& slot{inventory.slots[slotIndex]};
-        if (slot.ID) {
+    // If the inventory grew past our thumbnails, add more.
+    while (slotContainer.size() < inventory.slots.size()) {
+        addEmptyThumbnail(static_cast<Uint8>(slotContainer.size()));
+    }
+
+    // Update the thumbnails for any slots that changed.
+    std::size_t slotCount{
+        std::max(inventory.slots.size(), displayedSlots.size())};
+    std::size_t changedSlotCountBefore{changedSlots.size()};
+    for (std::size_t i{0}; i < slotCount; ++i) {
+        Uint8 slotIndex{static_cast<Uint8>(i)};
+        ItemThumbnail& thumbnail{getSlotThumbnail(slotIndex)};
+        bool wasDisplayed{i < displayedSlots.size()};
+        bool isInInventory{i < inventory.slots.size()};
+
+        // If the slot was removed, clear and hide its thumbnail.
+        if (!isInInventory) {
+            clearItemThumbnail(thumbnail);
+            thumbnail.setIsVisible(false);
+            changedSlots.push_back(slotIndex);
+            continue;
+        }
+
+        // If the slot didn't change, skip it.
+        const Inventory::ItemSlot& slot{inventory.slots[i]};
+        if (wasDisplayed && (displayedSlots[i].ID == slot.ID)
+            && (displayedSlots[i].count == slot.count)) {
+            continue;
+        }
+
+        thumbnail.setIsVisible(true);
+        if (!(slot.ID)) {
+            clearItemThumbnail(thumbnail);
+        }
+        else if (wasDisplayed && (displayedSlots[i].ID == slot.ID)) {
+            // Only the count changed.
+            thumbnail.setItemCount((slot.count > 1) ? slot.count : 0);
+        }
+        else {
+            clearItemThumbnail(thumbnail);
             finishItemThumbnail(thumbnail, slot.ID, slot.count, slotIndex);
         }
+        changedSlots.push_back(slotIndex);
     }
+    displayedSlots = inventory.slots;
 
-    wasRefreshed = true;
+    // If anything changed and an item was selected, deselect it.
+    if (changedSlots.size() != changedSlotCountBefore) {
+        interactionManager.itemDeselected();
+    }
 }
 
 ItemThumbnail& InventoryWindow::addEmptyThumbnail(Uint8 slotIndex)
@@ -145,6 +181,11 @@ ItemThumbnail& InventoryWindow::addEmptyThumbnail(Uint8 slotIndex)
     return thumbnail;
 }
 
+ItemThumbnail& InventoryWindow::getSlotThumbnail(Uint8 slotIndex)
+{
+    return static_cast<ItemThumbnail&>(*(slotContainer[slotIndex]));
+}
+
 void InventoryWindow::finishItemThumbnail(ItemThumbnail& thumbnail,
                                           ItemID itemID, Uint8 itemCount,
                                           Uint8 slotIndex)
@@ -158,10 +199,13 @@ void InventoryWindow::finishItemThumbnail(ItemThumbnail& thumbnail,
         // Default icon
         renderData = &(iconData.getRenderData(NULL_ICON_ID));
     }
-    thumbnail.thumbnailImage.setSimpleImage(renderData->iconSheetRelPath,
-                                            renderData->textureExtent);
-    thumbnail.dragDropImage.setSimpleImage(renderData->iconSheetRelPath,
-                                           renderData->textureExtent);
+    thumbnailAtlas.setSimpleImage(thumbnail.thumbnailImage,
+                                  renderData->iconSheetRelPath,
+                                  renderData->textureExtent);
+    thumbnailAtlas.setSimpleImage(thumbnail.dragDropImage,
+                                  renderData->iconSheetRelPath,
+                                  renderData->textureExtent);
+    thumbnail.thumbnailImage.setIsVisible(true);
 
     // If the slot is holding a stack of items, show the count text.
     if (itemCount > 1) {
@@ -203,6 +247,22 @@ void InventoryWindow::finishItemThumbnail(ItemThumbnail& thumbnail,
     });
 }
 
+void InventoryWindow::clearItemThumbnail(ItemThumbnail& thumbnail)
+{
+    // Hide the old item's image and count.
+    thumbnail.thumbnailImage.setIsVisible(false);
+    thumbnail.setItemCount(0);
+
+    // Empty slots can't be dragged or interacted with, but can still have
+    // items dropped on them.
+    thumbnail.setDragDropData(nullptr);
+    thumbnail.setOnHovered(nullptr);
+    thumbnail.setOnUnhovered(nullptr);
+    thumbnail.setOnMouseDown(nullptr);
+    thumbnail.setOnMouseUp(nullptr);
+    thumbnail.setOnDeselected(nullptr);
+}
+
 void InventoryWindow::onInventoryUpdated(entt::registry& registry,
                                          entt::entity entity)
 {
@@ -216,15 +276,22 @@ void InventoryWindow::onInventoryUpdated(entt::registry& registry,
 
 void InventoryWindow::onItemUpdate(ItemID itemID)
 {
-    // If this update is for an item in the inventory, we need to refresh.
-    const Item* item{itemData.getItem(itemID)};
-    Inventory& inventory{world.registry.get<Inventory>(world.playerEntity)};
-    auto it{std::find_if(inventory.slots.begin(), inventory.slots.end(),
-                         [&](const Inventory::ItemSlot& itemSlot) {
-                             return (itemSlot.ID == item->numericID);
-                         })};
-    if (it != inventory.slots.end()) {
-        refresh(inventory);
+    // If this update is for an item in the inventory, re-load the thumbnails
+    // that show it.
+    std::size_t changedSlotCountBefore{changedSlots.size()};
+    for (std::size_t i{0}; i < displayedSlots.size(); ++i) {
+        const Inventory::ItemSlot& slot{displayedSlots[i]};
+        if (slot.ID == itemID) {
+            Uint8 slotIndex{static_cast<Uint8>(i)};
+            finishItemThumbnail(getSlotThumbnail(slotIndex), slot.ID,
+                                slot.count, slotIndex);
+            changedSlots.push_back(slotIndex);
+        }
+    }
+
+    // If anything changed and an item was selected, deselect it.
+    if (changedSlots.size() != changedSlotCountBefore) {
+        interactionManager.itemDeselected();
     }
 }
 
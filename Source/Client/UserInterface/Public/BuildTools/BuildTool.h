@@ -74,6 +74,27 @@ public:
     virtual void onMouseLeave();
 
 protected:
+    /**
+     * Starts a click-and-drag at mouseTilePosition.
+     */
+    void beginDrag();
+
+    /**
+     * Ends the current click-and-drag.
+     *
+     * @return The extent that was dragged over. See getDragExtent().
+     */
+    TileExtent endDrag();
+
+    /**
+     * Returns the extent between the tile that the current drag started on
+     * and mouseTilePosition, at the start tile's Z level.
+     *
+     * The extent is anchored at the start tile, and each side is clamped to
+     * TileExtentEdit::MAX_EXTENT_LENGTH.
+     */
+    TileExtent getDragExtent() const;
+
     /** Used for getting the world state so our tools can make decisions and
         send messages. */
     World& world;
@@ -99,6 +120,12 @@ protected:
         color mods) or respond to inputs. */
     bool isActive;
 
+    /** If true, the user is currently clicking and dragging. */
+    bool isDragging;
+
+    /** If isDragging, this is the tile that the drag started on. */
+    TilePosition dragStartTilePosition;
+
     /** Holds any phantom sprites that this build tool wants to render.
         These sprites get passed down to the Renderer, which then correctly
         sorts and renders them while rendering the sim's world data. */
@@ -62,6 +62,27 @@ public:
     void onMouseLeave() override;
 
 private:
+    /** The number of lookalikes to spawn when the user shift + clicks with a
+        template selected. */
+    static constexpr Uint16 BULK_SPAWN_COUNT{10};
+
+    /** How far, in tiles, from the clicked tile to scatter bulk spawned
+        entities. */
+    static constexpr int BULK_SPAWN_RADIUS{2};
+
+    /**
+     * Requests a group of entities that look like the selected template,
+     * around the clicked tile.
+     *
+     * Note: These are lookalikes, not template instances. They get the
+     *       template's name and graphic state, but its init script isn't
+     *       run.
+     *
+     * @param addRandomWalkerAI If true, each entity will be given a default
+     *                          random walker behavior.
+     */
+    void requestLookalikeSpawn(bool addRandomWalkerAI);
+
     /**
      * If the given entity isn't a player entity and isn't already selected,
      * selects it and calls onEntitySelected.
@@ -21,12 +21,20 @@ public:
 
     void onMouseDown(AUI::MouseButtonType buttonType,
                      const SDL_Point& cursorPosition) override;
+    void onMouseUp(AUI::MouseButtonType buttonType,
+                   const SDL_Point& cursorPosition) override;
     void onMouseDoubleClick(AUI::MouseButtonType buttonType,
                             const SDL_Point& cursorPosition) override;
     void onMouseWheel(int amountScrolled) override;
     void onMouseMove(const SDL_Point& cursorPosition) override;
 
 private:
+    /**
+     * Sets the selected graphic as a phantom at mouseTilePosition, or over
+     * the whole drag extent if we're dragging.
+     */
+    void addPhantoms();
+
     /** The currently selected graphic set. */
     const FloorGraphicSet* selectedGraphicSet;
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "BuildTool.h"
+#include "TileExtentEdit.h"
 
 namespace AM
 {
@@ -34,12 +35,40 @@ private:
                                 TileLayer::Type layerType, Uint16 graphicSetID,
                                 Uint8 graphicIndex);
 
+    /**
+     * Changes the given layer's graphic value to the one that should be
+     * requested when removing it.
+     *
+     * NE gap fills are requested as North walls (the tile map handles gap
+     * fills).
+     *
+     * @return false if the layer can't be removed directly, else true.
+     *         NW gap fills are removed when one of the adjoined walls is.
+     */
+    static bool toRemovedGraphicValue(TileLayer::Type layerType,
+                                      Uint8& graphicValue);
+
+    /**
+     * Returns the extent of the current drag that layers should be removed
+     * from. Walls can only be removed along a line that matches their type.
+     */
+    TileExtent getRemoveExtent() const;
+
+    /**
+     * Highlights the dragged layer on each tile in the current drag.
+     */
+    void addDragColorMods();
+
     /** Used for finding tile layers or entities that the mouse is
         hovering over or clicking. */
     const WorldObjectLocator& worldObjectLocator;
 
     /** The color used to highlight the hovered object. */
     const SDL_Color highlightColor;
+
+    /** If isDragging, this describes the layer to remove. Its extent is
+        filled in when the drag ends. */
+    TileExtentEdit dragEdit;
 };
 
 } // End namespace Client
@@ -23,12 +23,25 @@ public:
 
     void onMouseDown(AUI::MouseButtonType buttonType,
                      const SDL_Point& cursorPosition) override;
+    void onMouseUp(AUI::MouseButtonType buttonType,
+                   const SDL_Point& cursorPosition) override;
     void onMouseDoubleClick(AUI::MouseButtonType buttonType,
                             const SDL_Point& cursorPosition) override;
     void onMouseWheel(int amountScrolled) override;
     void onMouseMove(const SDL_Point& cursorPosition) override;
 
 private:
+    /**
+     * Returns the graphic value of the selected height and start height.
+     */
+    Terrain::Value getSelectedValue() const;
+
+    /**
+     * Sets the selected graphic as a phantom at mouseTilePosition, or over
+     * the whole drag extent if we're dragging.
+     */
+    void addPhantoms();
+
     /** The currently selected graphic set. */
     const TerrainGraphicSet* selectedGraphicSet;
 
@@ -28,6 +28,25 @@ public:
     void onMouseMove(const SDL_Point& cursorPosition) override;
 
 private:
+    /**
+     * Tells the sim to add the current phantom walls.
+     */
+    void requestPhantomWalls();
+
+    /**
+     * Returns the line of tiles within the given drag extent that walls
+     * should be added to.
+     *
+     * @param outWallType The type of wall to add to the line.
+     */
+    TileExtent getWallLine(const TileExtent& dragExtent,
+                           Wall::Type& outWallType) const;
+
+    /**
+     * Adds a phantom wall to each tile in the current drag's wall line.
+     */
+    void addPhantomWallLine();
+
     /**
      * Adds phantom walls based on the given mouse position. The phantom's wall
      * types depend on whether the mouse is closer to the top or left of a tile,
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <SDL_rect.h>
+#include <SDL_stdinc.h>
+#include <array>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+struct SDL_Renderer;
+struct SDL_Texture;
+struct SDL_Surface;
+typedef struct _TTF_Font TTF_Font;
+
+namespace AM
+{
+namespace Client
+{
+/**
+ * Rasterizes a font's glyphs into a single texture.
+ *
+ * Text that's drawn from the atlas is just a list of source rects, so
+ * changing it never needs a new texture. Printable ASCII is rasterized up
+ * front. Any other codepoint is rasterized into the atlas the first time
+ * it's requested, so names and messages in other scripts still draw.
+ *
+ * The atlas is rasterized at the font's actual (scaled) size. If the UI
+ * scale changes, call refresh() to re-rasterize it.
+ *
+ * Note: Codepoints that the font doesn't provide, or that don't fit in a
+ *       full atlas, are drawn as '?'. Kerning isn't applied, glyphs are
+ *       placed by their advance alone.
+ */
+class GlyphAtlas
+{
+public:
+    /**
+     * A single glyph's location in the atlas texture.
+     */
+    struct Glyph {
+        /** The glyph's extent within the atlas texture. */
+        SDL_Rect sourceExtent{};
+
+        /** How far to move the pen after drawing this glyph, in actual
+            pixels. */
+        int advance{0};
+    };
+
+    GlyphAtlas(SDL_Renderer* inSdlRenderer, const std::string& inFontPath,
+               int inLogicalFontSize);
+
+    ~GlyphAtlas();
+
+    GlyphAtlas(const GlyphAtlas&) = delete;
+    GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+
+    /**
+     * If the atlas hasn't been rasterized yet, or the UI scale has changed
+     * since it was, rasterizes it at the current scale.
+     *
+     * Glyphs that were rasterized on demand are dropped, and will be
+     * rasterized again when they're next requested.
+     *
+     * @return true if the atlas was re-rasterized, else false.
+     */
+    bool refresh();
+
+    /**
+     * Returns the glyph to use for the given codepoint, rasterizing it into
+     * the atlas if this is the first time it's been requested.
+     *
+     * Note: Rasterizing may update or replace the atlas texture, so this
+     *       shouldn't be called while rendering.
+     */
+    const Glyph& getGlyph(Uint32 codepoint);
+
+    /**
+     * Returns the height of a line of text, in actual pixels.
+     */
+    int getLineHeight() const;
+
+    SDL_Texture* getTexture() const;
+
+    /**
+     * Decodes the UTF-8 codepoint that starts at the given index, and moves
+     * the index past it.
+     *
+     * Invalid or truncated sequences decode as REPLACEMENT_CHARACTER, and
+     * only consume their first byte.
+     */
+    static Uint32 decodeUtf8(std::string_view text, std::size_t& index);
+
+    /** The first and last characters that are rasterized up front. */
+    static constexpr char FIRST_CHARACTER{' '};
+    static constexpr char LAST_CHARACTER{'~'};
+
+    /** The codepoint that invalid UTF-8 decodes as. */
+    static constexpr Uint32 REPLACEMENT_CHARACTER{0xFFFD};
+
+private:
+    /** The max width of the atlas texture. Glyphs wrap to a new row past
+        this width. */
+    static constexpr int MAX_ATLAS_WIDTH{1024};
+
+    /** The max height of the atlas texture. Once it's full, new codepoints
+        are drawn as '?'. */
+    static constexpr int MAX_ATLAS_HEIGHT{1024};
+
+    static constexpr std::size_t ASCII_GLYPH_COUNT{
+        static_cast<std::size_t>(LAST_CHARACTER - FIRST_CHARACTER) + 1};
+
+    /**
+     * Rasterizes the given codepoint and packs it into the atlas surface.
+     * If the texture exists, uploads the glyph to it.
+     *
+     * @return true if successful. false if the font doesn't provide the
+     *         codepoint or the atlas is full.
+     */
+    bool rasterizeGlyph(Uint32 codepoint, Glyph& outGlyph);
+
+    /**
+     * Grows the atlas surface to at least the given height, copying over the
+     * existing glyphs.
+     *
+     * @return true if successful. false if the height is past
+     *         MAX_ATLAS_HEIGHT.
+     */
+    bool growAtlasSurface(int minHeight);
+
+    /**
+     * Creates a new texture from the atlas surface.
+     */
+    void createTexture();
+
+    /** Used to create the atlas texture. */
+    SDL_Renderer* sdlRenderer;
+
+    /** The font to rasterize. */
+    std::string fontPath;
+
+    /** The font size, before UI scaling is applied. */
+    int logicalFontSize;
+
+    /** The font size that the atlas was last rasterized at. 0 if it hasn't
+        been rasterized yet. */
+    int actualFontSize;
+
+    /** The open font, at actualFontSize. Kept open so we can rasterize
+        codepoints on demand. */
+    TTF_Font* font;
+
+    /** The height of a line of text, in actual pixels. */
+    int lineHeight;
+
+    /** The location of each printable ASCII glyph, indexed by (character -
+        FIRST_CHARACTER). */
+    std::array<Glyph, ASCII_GLYPH_COUNT> asciiGlyphs;
+
+    /** The location of each other codepoint that's been requested. Includes
+        codepoints that fell back to '?', so we don't retry them. */
+    std::unordered_map<Uint32, Glyph> extraGlyphs;
+
+    /** Where the next glyph will be packed, and the height of the current
+        row. */
+    SDL_Point nextPosition;
+    int rowHeight;
+
+    /** A CPU copy of the atlas. New glyphs are packed into it, then uploaded
+        to the texture. */
+    std::shared_ptr<SDL_Surface> atlasSurface;
+
+    /** The texture that holds every glyph. */
+    std::shared_ptr<SDL_Texture> texture;
+
+    /** The height of the texture. If the atlas surface grows past it, the
+        texture must be re-created. */
+    int textureHeight;
+};
+
+} // End namespace Client
+} // End namespace AM
@@ -6,6 +6,9 @@
 #include "SpriteColorModInfo.h"
 #include "ViewModel.h"
 #include "InteractionManager.h"
+#include "ThumbnailAtlas.h"
+#include "RegionWatcher.h"
+#include "ProfiledWindow.h"
 #include "MainOverlay.h"
 #include "ChatWindow.h"
 #include "DialogueWindow.h"
@@ -27,6 +30,7 @@ struct Position;
 namespace Client
 {
 struct UserInterfaceExDependencies;
+class PerformanceProfiler;
 
 /**
  * The main UI that overlays the world.
@@ -34,7 +38,8 @@ struct UserInterfaceExDependencies;
 class MainScreen : public AUI::Screen
 {
 public:
-    MainScreen(const UserInterfaceExDependencies& deps);
+    MainScreen(const UserInterfaceExDependencies& deps,
+               PerformanceProfiler& profiler);
 
     virtual ~MainScreen() = default;
 
@@ -94,10 +99,10 @@ public:
 
 private:
     /**
-     * If the player enters or exits the build area, performs the necessary UI
-     * changes.
+     * When the player enters or exits the build area, performs the necessary
+     * UI changes.
      */
-    void onPositionChanged(entt::registry& registry, entt::entity entity);
+    void onBuildAreaChanged(bool playerIsInside);
 
     /**
      * Shows/hides the TooltipWindow.
@@ -117,41 +122,48 @@ private:
     /** If true, the player is currently in the build area. */
     bool playerIsInBuildArea;
 
+    /** Tells us when the player enters or exits the build area. */
+    RegionWatcher regionWatcher;
+
     EventQueue<DialogueResponse> dialogueResponseQueue;
 
+    /** The shared atlas that thumbnail images are drawn from. */
+    ThumbnailAtlas thumbnailAtlas;
+
     //-------------------------------------------------------------------------
     // Windows
+    // Note: Each window is wrapped so that its frame times are profiled.
     //-------------------------------------------------------------------------
     /** The main overlay. Currently only shows the "build mode" text, but
         will eventually show player names, etc. */
-    MainOverlay mainOverlay;
+    ProfiledWindow<MainOverlay> mainOverlay;
 
     /** The chat window. Currently only shows system messages, but will
         eventually show player messages and support sending messages. */
-    ChatWindow chatWindow;
+    ProfiledWindow<ChatWindow> chatWindow;
 
     /** The dialogue window that pops up when you talk to an entity. */
-    DialogueWindow dialogueWindow;
+    ProfiledWindow<DialogueWindow> dialogueWindow;
 
     /** The player's inventory window. */
-    InventoryWindow inventoryWindow;
+    ProfiledWindow<InventoryWindow> inventoryWindow;
 
     /** The player's hotbar window. */
-    HotbarWindow hotbarWindow;
+    ProfiledWindow<HotbarWindow> hotbarWindow;
 
     /** The build mode overlay. Allows the player to place tiles. */
-    BuildOverlay buildOverlay;
+    ProfiledWindow<BuildOverlay> buildOverlay;
 
     /** The build mode panel. Allows the player to select tiles. */
-    BuildPanel buildPanel;
+    ProfiledWindow<BuildPanel> buildPanel;
 
     /** A general-purpose right-click menu. Used for e.g. displaying
         the supported interactions when a user right-clicks an item. */
-    RightClickMenu rightClickMenu;
+    ProfiledWindow<RightClickMenu> rightClickMenu;
 
     /** A general-purpose tooltip window. Used for e.g. displaying an entity 
         or item name when hovered. */
-    TooltipWindow tooltipWindow;
+    ProfiledWindow<TooltipWindow> tooltipWindow;
 };
 
 } // End namespace Client
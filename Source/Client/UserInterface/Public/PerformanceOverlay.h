@@ -0,0 +1,91 @@
+#pragma once
+
+#include "GlyphAtlas.h"
+#include "Timer.h"
+#include <SDL_rect.h>
+#include <array>
+
+struct SDL_Renderer;
+
+namespace AM
+{
+namespace Client
+{
+class PerformanceProfiler;
+
+/**
+ * Draws a PerformanceProfiler's stats over the top of the UI.
+ *
+ * Each section gets a line showing its average and max stage times and its
+ * widget count. The text is drawn straight from a GlyphAtlas, so updating
+ * it doesn't create textures or allocate.
+ *
+ * Note: This isn't an AUI window, so that it can be drawn over any screen
+ *       without being part of its layout.
+ */
+class PerformanceOverlay
+{
+public:
+    PerformanceOverlay(SDL_Renderer* inSdlRenderer,
+                       const PerformanceProfiler& inProfiler);
+
+    /**
+     * If the text is due for an update, re-formats it from the profiler's
+     * latest stats.
+     */
+    void update();
+
+    /**
+     * Draws the overlay to the current rendering target.
+     *
+     * Note: update() must be called first, at least once.
+     */
+    void render();
+
+private:
+    /** How often to update the text. Updating every frame makes the
+        numbers unreadable. */
+    static constexpr double UPDATE_PERIOD_S{0.25};
+
+    /** The number of latest frames to calculate stats over. */
+    static constexpr std::size_t STAT_FRAME_COUNT{60};
+
+    /** The max number of lines (a header, a footer, and one per
+        section). */
+    static constexpr std::size_t MAX_LINES{26};
+
+    /** The max length of a line, including the null terminator. */
+    static constexpr std::size_t MAX_LINE_LENGTH{128};
+
+    /** The padding around the text, in actual pixels. */
+    static constexpr int PADDING{8};
+
+    /**
+     * Formats the given text into the next line.
+     */
+    void addLine(const char* format, ...);
+
+    /** Used to draw the overlay. */
+    SDL_Renderer* sdlRenderer;
+
+    /** The profiler to pull stats from. */
+    const PerformanceProfiler& profiler;
+
+    /** The glyphs that our text is drawn with. */
+    GlyphAtlas glyphAtlas;
+
+    /** Tracks when we need to update the text. */
+    Timer updateTimer;
+
+    /** Our formatted text. */
+    std::array<std::array<char, MAX_LINE_LENGTH>, MAX_LINES> lines;
+
+    /** The number of lines in use. */
+    std::size_t lineCount;
+
+    /** The extent of the background behind our text, in actual pixels. */
+    SDL_Rect backgroundExtent;
+};
+
+} // End namespace Client
+} // End namespace AM
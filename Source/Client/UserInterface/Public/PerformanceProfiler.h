@@ -0,0 +1,178 @@
+#pragma once
+
+#include <SDL_stdinc.h>
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace AM
+{
+namespace Client
+{
+/**
+ * Records how long each UI screen and window spends in each stage of a frame.
+ *
+ * Each section (a screen or window) adds its stage times to the current
+ * frame. When the frame ends, it's moved into a ring buffer that holds the
+ * last HISTORY_LENGTH frames.
+ *
+ * All storage is allocated when sections are added, so recording never
+ * allocates.
+ */
+class PerformanceProfiler
+{
+public:
+    /** Used to refer to a section when recording. */
+    using SectionID = Uint8;
+
+    /**
+     * The stages of a frame that we time.
+     */
+    enum class Stage : Uint8 {
+        Tick,
+        /** measure() and arrange(). */
+        Layout,
+        Render,
+        Count
+    };
+
+    static constexpr std::size_t STAGE_COUNT{
+        static_cast<std::size_t>(Stage::Count)};
+
+    /** The max number of sections that can be added. */
+    static constexpr std::size_t MAX_SECTIONS{24};
+
+    /** The number of frames that we keep. */
+    static constexpr std::size_t HISTORY_LENGTH{240};
+
+    /**
+     * A single section's data for a single frame.
+     */
+    struct SectionSample {
+        /** The time spent in each stage, in seconds. */
+        std::array<float, STAGE_COUNT> stageTimesS{};
+
+        /** The number of widgets in the section. */
+        Uint16 widgetCount{0};
+    };
+
+    /**
+     * A section's stats over the recorded history.
+     */
+    struct SectionStats {
+        /** The average time spent in each stage, in seconds. */
+        std::array<double, STAGE_COUNT> averageTimesS{};
+
+        /** The max time spent in each stage, in seconds. */
+        std::array<double, STAGE_COUNT> maxTimesS{};
+
+        /** The section's widget count, as of the latest frame. */
+        Uint16 widgetCount{0};
+    };
+
+    PerformanceProfiler();
+
+    /**
+     * Adds a section with the given name.
+     *
+     * Note: Sections should only be added during construction, since this
+     *       allocates the section's history.
+     */
+    SectionID addSection(std::string_view name);
+
+    /**
+     * Adds the given time to the given section's stage, for the current
+     * frame.
+     */
+    void addTime(SectionID sectionID, Stage stage, double timeS);
+
+    /**
+     * Sets the given section's widget count, for the current frame.
+     */
+    void setWidgetCount(SectionID sectionID, std::size_t widgetCount);
+
+    /**
+     * Records that a texture was created during the current frame.
+     *
+     * Note: This is static so that texture owners don't need to be given a
+     *       profiler. Textures that AUI creates internally aren't counted.
+     */
+    static void countTextureCreation();
+
+    /**
+     * Moves the current frame into the history and starts a new one.
+     */
+    void endFrame();
+
+    /**
+     * Returns the number of frames in the history.
+     */
+    std::size_t getFrameCount() const;
+
+    /**
+     * Returns the number of sections that have been added.
+     */
+    std::size_t getSectionCount() const;
+
+    const std::string& getSectionName(SectionID sectionID) const;
+
+    /**
+     * Returns the given section's stats over the recorded history.
+     *
+     * @param frameAge If non-zero, only the latest frameAge frames are used.
+     */
+    SectionStats getSectionStats(SectionID sectionID,
+                                 std::size_t frameAge = 0) const;
+
+    /**
+     * Returns the number of textures that were created in the recorded
+     * history.
+     */
+    std::size_t getTextureCreationCount() const;
+
+    /**
+     * Writes the recorded history to the given file, as CSV.
+     * Each row holds one section's data for one frame, oldest first.
+     *
+     * @return true if the file was written, else false.
+     */
+    bool exportCsv(const std::string& filePath) const;
+
+private:
+    /**
+     * Returns the history index of the frame that's the given number of
+     * frames older than the newest.
+     */
+    std::size_t getHistoryIndex(std::size_t framesAgo) const;
+
+    /** The name of each section, indexed by SectionID. */
+    std::vector<std::string> sectionNames;
+
+    /** Each section's in-progress sample for the current frame. */
+    std::vector<SectionSample> currentSamples;
+
+    /** Each section's ring buffer of samples, indexed by
+        ((sectionID * HISTORY_LENGTH) + historyIndex). */
+    std::vector<SectionSample> sampleHistory;
+
+    /** The number of textures that were created in each frame. */
+    std::array<Uint16, HISTORY_LENGTH> textureCountHistory;
+
+    /** The history index that the next frame will be written to. */
+    std::size_t nextHistoryIndex;
+
+    /** The number of valid frames in the history, up to HISTORY_LENGTH. */
+    std::size_t frameCount;
+
+    /** The total number of frames that have ended. Used to label rows in
+        the exported CSV. */
+    Uint64 totalFrameCount;
+
+    /** The number of textures that have been created in the current
+        frame. */
+    static Uint16 currentTextureCount;
+};
+
+} // End namespace Client
+} // End namespace AM
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "TileExtent.h"
+#include "TilePosition.h"
+#include "entt/fwd.hpp"
+#include "entt/entity/entity.hpp"
+#include <SDL_stdinc.h>
+#include <functional>
+#include <span>
+#include <vector>
+
+namespace AM
+{
+namespace Client
+{
+/**
+ * Notifies when specific entities enter or leave specific tile regions.
+ *
+ * Instead of hooking every Position update in the registry and filtering out
+ * the entities we don't care about, update() only reads the positions of the
+ * watched entities. If a watched entity moved to a new tile, its region
+ * membership is looked up in a grid that's precomputed when the region is
+ * added, instead of testing each of the region's extents.
+ */
+class RegionWatcher
+{
+public:
+    using RegionID = Uint8;
+
+    /**
+     * Adds a region, made of the union of the given extents.
+     *
+     * @return The new region's ID.
+     */
+    RegionID addRegion(std::span<const TileExtent> extents);
+
+    /**
+     * Starts watching the given entity, calling onChanged(true) when it
+     * enters the given region and onChanged(false) when it leaves.
+     *
+     * Note: The referenced entity ID is re-read on every update(), so this
+     *       can follow an ID that changes (e.g. World::playerEntity).
+     */
+    void watch(const entt::entity& entity, RegionID regionID,
+               std::function<void(bool)> onChanged);
+
+    /**
+     * Checks if any watched entities entered or left their region, and calls
+     * the appropriate callbacks.
+     */
+    void update(const entt::registry& registry);
+
+private:
+    /**
+     * A region's tile membership, stored as a grid over its bounding extent.
+     */
+    struct Region {
+        TileExtent bounds{};
+
+        /** Holds 1 for each tile in bounds that's in the region, else 0. */
+        std::vector<Uint8> membership{};
+
+        bool contains(const TilePosition& tilePosition) const;
+    };
+
+    struct Watch {
+        /** The ID of the entity to watch. */
+        const entt::entity* entity{nullptr};
+
+        RegionID regionID{0};
+
+        std::function<void(bool)> onChanged{};
+
+        /** The entity that we last checked. If this changes, we re-check. */
+        entt::entity lastEntity{entt::null};
+
+        /** The tile that the entity was last checked at. */
+        TilePosition lastTilePosition{};
+
+        /** If true, the entity was last seen inside the region. */
+        bool isInside{false};
+    };
+
+    std::vector<Region> regions;
+
+    std::vector<Watch> watches;
+};
+
+} // End namespace Client
+} // End namespace AM
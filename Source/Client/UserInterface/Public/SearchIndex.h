@@ -0,0 +1,188 @@
+#pragma once
+
+#include <SDL_stdinc.h>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace AM
+{
+namespace Client
+{
+/**
+ * A case-insensitive substring search index over the display names and
+ * string IDs of a catalog (graphic sets, icons, items, etc).
+ *
+ * Each entry's fields are broken into every 1, 2, and 3-character gram, and
+ * each gram maps to a sorted list of the entries that contain it. A second
+ * set of lists holds only the entries that have a field starting with the
+ * gram, so match types are precomputed for every gram. Queries of up to 3
+ * characters are answered by merging a gram's two lists, without looking at
+ * any entry's fields. Longer queries intersect the lists of their trigrams
+ * (starting from the shortest), then confirm the few remaining candidates
+ * with a substring check.
+ *
+ * Entries can be added, updated, and removed individually, so the index can
+ * be kept up to date as the catalog changes.
+ */
+class SearchIndex
+{
+public:
+    /**
+     * How an entry matches a query.
+     * Search results are sorted in this order.
+     */
+    enum class MatchType : Uint8 {
+        /** A field starts with the query. */
+        Prefix,
+        /** A field contains the query. */
+        Substring,
+        /** Neither field contains the query. */
+        None
+    };
+
+    /**
+     * Adds an entry with the given ID, or replaces it if it already exists.
+     */
+    void setEntry(Uint32 entryID, std::string_view displayName,
+                  std::string_view stringID);
+
+    /**
+     * Removes the entry with the given ID, if it exists.
+     */
+    void removeEntry(Uint32 entryID);
+
+    /**
+     * Removes all entries.
+     */
+    void clear();
+
+    /**
+     * Returns the number of entries in the index.
+     */
+    std::size_t size() const;
+
+    /**
+     * Fills outResults with the IDs of every entry whose display name or
+     * string ID contains the given query, ignoring case.
+     *
+     * Entries where a field starts with the query come first. Otherwise,
+     * results are in ID order. An empty query returns every entry.
+     */
+    void search(std::string_view query, std::vector<Uint32>& outResults) const;
+
+    /**
+     * Returns how the given entry matches the given query.
+     * If the entry doesn't exist, returns None.
+     */
+    MatchType getMatchType(Uint32 entryID, std::string_view query) const;
+
+    /**
+     * Returns the position that the given entry would have in the results
+     * of search(query), if it matched with the given type.
+     *
+     * Used to keep a set of results up to date as entries change, without
+     * re-running the search: get the entry's old match type before calling
+     * setEntry(), then move it from its old position to its new one.
+     *
+     * @param results The results of an earlier search(query). The other
+     *                entries in it must not have changed.
+     */
+    std::size_t findResultPosition(const std::vector<Uint32>& results,
+                                   std::string_view query, Uint32 entryID,
+                                   MatchType matchType) const;
+
+private:
+    /** The longest gram that we index. */
+    static constexpr std::size_t MAX_GRAM_LENGTH{3};
+
+    struct Entry {
+        /** The entry's lowercase display name. */
+        std::string displayName{};
+
+        /** The entry's lowercase string ID. */
+        std::string stringID{};
+
+        /** Every gram that the entry's fields contain, without duplicates. */
+        std::vector<Uint32> grams{};
+
+        /** Every gram that one of the entry's fields starts with, without
+            duplicates. */
+        std::vector<Uint32> prefixGrams{};
+    };
+
+    /** Maps each gram to a sorted list of entry IDs. */
+    using PostingListMap = std::unordered_map<Uint32, std::vector<Uint32>>;
+
+    /**
+     * Lowercases the given string into outString.
+     */
+    static void normalize(std::string_view string, std::string& outString);
+
+    /**
+     * Returns how the given entry matches the given query.
+     * The query must already be normalized.
+     */
+    static MatchType getMatchType(const Entry& entry, std::string_view query);
+
+    /**
+     * Packs the given 1 to 3 characters (and their length) into a gram key.
+     */
+    static Uint32 packGram(std::string_view characters);
+
+    /**
+     * Adds every gram in the given string to outGrams.
+     */
+    static void addGrams(std::string_view string,
+                         std::vector<Uint32>& outGrams);
+
+    /**
+     * Adds every gram that the given string starts with to outGrams.
+     */
+    static void addPrefixGrams(std::string_view string,
+                               std::vector<Uint32>& outGrams);
+
+    /**
+     * Sorts the given grams and removes any duplicates.
+     */
+    static void sortUnique(std::vector<Uint32>& grams);
+
+    /**
+     * Adds the given entry to the given grams' lists in the given map.
+     */
+    static void addToPostingLists(PostingListMap& postingListMap,
+                                  const std::vector<Uint32>& grams,
+                                  Uint32 entryID);
+
+    /**
+     * Removes the given entry from the given grams' lists in the given map.
+     */
+    static void removeFromPostingLists(PostingListMap& postingListMap,
+                                       const std::vector<Uint32>& grams,
+                                       Uint32 entryID);
+
+    /**
+     * Returns the given gram's list in the given map, or nullptr if it has
+     * none.
+     */
+    static const std::vector<Uint32>*
+        getPostingList(const PostingListMap& postingListMap, Uint32 gram);
+
+    /** The indexed entries. */
+    std::unordered_map<Uint32, Entry> entries;
+
+    /** Maps each gram to the sorted IDs of the entries that contain it. */
+    PostingListMap postingLists;
+
+    /** Maps each gram to the sorted IDs of the entries that have a field
+        starting with it. Each list is a subset of the gram's list in
+        postingLists. */
+    PostingListMap prefixPostingLists;
+
+    /** Scratch storage for normalizing queries. */
+    mutable std::string normalizedQuery;
+};
+
+} // End namespace Client
+} // End namespace AM
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <SDL_rect.h>
+#include <SDL_render.h>
+#include <SDL_stdinc.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace AUI
+{
+class Image;
+}
+
+namespace AM
+{
+namespace Client
+{
+class GraphicData;
+class IconData;
+
+/**
+ * Packs the images that thumbnails show (item icons, the first sprite of
+ * each graphic set, and the thumbnail backgrounds) into a few shared atlas
+ * pages.
+ *
+ * Thumbnails that set their images through this class draw sub-rects of the
+ * atlas pages, instead of each using their own texture. Since consecutive
+ * draws from the same texture get batched by the renderer, an icon-heavy
+ * window costs a few draw calls instead of a few per thumbnail.
+ *
+ * Packing is done on the first run. The pages and a manifest are saved to
+ * the cache directory, and re-used on later runs until a source image or the
+ * set of thumbnails changes.
+ *
+ * Images that didn't make it into the atlas (e.g. because they're too large)
+ * are set as usual, from their own texture.
+ */
+class ThumbnailAtlas
+{
+public:
+    ThumbnailAtlas(GraphicData& inGraphicData, IconData& inIconData);
+
+    /**
+     * Sets the given image to the given sub-image of the given image file.
+     * If the sub-image is in the atlas, it'll be drawn from the atlas.
+     */
+    void setSimpleImage(AUI::Image& image, const std::string& imagePath,
+                        const SDL_Rect& textureExtent) const;
+    void setSimpleImage(AUI::Image& image, const std::string& imagePath,
+                        const SDL_Rect& textureExtent,
+                        SDL_ScaleMode scaleMode) const;
+
+    /**
+     * Sets the given image to the whole given image file.
+     * If the file is in the atlas, it'll be drawn from the atlas.
+     */
+    void setSimpleImage(AUI::Image& image, const std::string& imagePath) const;
+
+private:
+    /** The width and height of each atlas page. */
+    static constexpr int PAGE_SIZE{2048};
+
+    /** Images larger than this (in either dimension) aren't worth the atlas
+        space, and are left out. */
+    static constexpr int MAX_SOURCE_SIZE{512};
+
+    /** The empty space to leave around each image, so linear filtering
+        doesn't bleed neighboring images into it. */
+    static constexpr int PADDING{1};
+
+    /** The thumbnail background images, which every thumbnail draws. */
+    static const std::vector<std::string> BACKGROUND_IMAGE_NAMES;
+
+    /**
+     * An image that should be packed into the atlas.
+     */
+    struct Source {
+        std::string imagePath{};
+
+        /** The sub-image to pack. Ignored if isWholeImage == true. */
+        SDL_Rect sourceExtent{};
+
+        /** If true, the whole image file should be packed. */
+        bool isWholeImage{false};
+    };
+
+    /**
+     * An image that's been packed into the atlas.
+     */
+    struct Entry {
+        /** The packed extent, within the source image file. */
+        SDL_Rect sourceExtent{};
+
+        /** If true, the whole image file was packed. */
+        bool isWholeImage{false};
+
+        /** The page that the image is on. */
+        std::size_t pageIndex{0};
+
+        /** The image's top left position within its page. */
+        SDL_Point atlasPosition{};
+    };
+
+    /**
+     * Fills outSources with every image that thumbnails might show.
+     */
+    void gatherSources(GraphicData& graphicData, IconData& iconData,
+                       std::vector<Source>& outSources);
+
+    /**
+     * Returns a hash of the given sources and the files that they come from.
+     * If a source file changes, the hash will change.
+     */
+    Uint64 calcSignature(const std::vector<Source>& sources);
+
+    /**
+     * Loads the cached atlas, if it exists and matches the given signature.
+     * @return true if successful, else false.
+     */
+    bool loadCache(Uint64 signature);
+
+    /**
+     * Packs the given sources into atlas pages and saves them to the cache.
+     */
+    void pack(const std::vector<Source>& sources, Uint64 signature);
+
+    /**
+     * Searches for the packed entry that contains the given sub-image.
+     * @return The entry if found, else nullptr.
+     */
+    const Entry* findEntry(const std::string& imagePath,
+                           const SDL_Rect* textureExtent) const;
+
+    /**
+     * Returns the path to the given atlas page's image file.
+     */
+    std::string getPagePath(std::size_t pageIndex) const;
+
+    /** The packed images, keyed by their source file path. */
+    std::unordered_map<std::string, std::vector<Entry>> entries;
+};
+
+} // End namespace Client
+} // End namespace AM
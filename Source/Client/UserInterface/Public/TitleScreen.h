@@ -2,6 +2,7 @@
 
 #include "AUI/Screen.h"
 #include "TitleWindow.h"
+#include "ProfiledWindow.h"
 
 namespace AM
 {
@@ -10,6 +11,7 @@ namespace Client
 {
 class UserInterfaceExtension;
 class Simulation;
+class PerformanceProfiler;
 
 /**
  * The opening title screen that you see on app launch.
@@ -18,7 +20,8 @@ class TitleScreen : public AUI::Screen
 {
 public:
     TitleScreen(UserInterfaceExtension& inUserInterface,
-                Simulation& inSimulation, EventDispatcher& inUiEventDispatcher);
+                Simulation& inSimulation, EventDispatcher& inUiEventDispatcher,
+                PerformanceProfiler& profiler);
 
     void render() override;
 
@@ -26,7 +29,7 @@ private:
     //-------------------------------------------------------------------------
     // Windows
     //-------------------------------------------------------------------------
-    TitleWindow titleWindow;
+    ProfiledWindow<TitleWindow> titleWindow;
 };
 
 } // End namespace Client
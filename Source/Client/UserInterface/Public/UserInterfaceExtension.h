@@ -3,6 +3,9 @@
 #include "IUserInterfaceExtension.h"
 #include "TitleScreen.h"
 #include "MainScreen.h"
+#include "PerformanceProfiler.h"
+#include "PerformanceOverlay.h"
+#include "Timer.h"
 #include "AUI/Initializer.h"
 
 namespace AUI
@@ -57,7 +60,7 @@ public:
     std::vector<SpriteColorModInfo> getSpriteColorMods() const override;
 
     /**
-     * Calls AUI::Screen::tick() on the current screen.
+     * Calls AUI::Screen::tick() on the current screen, and profiles it.
      *
      * @param timestepS  The amount of time that has passed since the last
      *                   tick() call, in seconds.
@@ -66,7 +69,9 @@ public:
 
     /**
      * Renders all UI graphics for the current screen to the current rendering
-     * target.
+     * target, and profiles it.
+     *
+     * If the performance overlay is open, it's rendered over the top.
      *
      * @param camera  The camera to calculate screen position with.
      */
@@ -74,14 +79,44 @@ public:
 
     /**
      * Handles user input events.
+     *
+     * F3 toggles the performance overlay, and F4 exports the recorded frame
+     * times to PERFORMANCE_TRACE_FILE_NAME.
      */
     bool handleOSEvent(SDL_Event& event) override;
 
 private:
+    /** The file, within Paths::BASE_PATH, that frame times are exported
+        to. */
+    static constexpr const char* PERFORMANCE_TRACE_FILE_NAME{
+        "UIPerformanceTrace.csv"};
+
+    /**
+     * Returns the profiler section of the current screen.
+     */
+    PerformanceProfiler::SectionID getCurrentScreenSectionID() const;
+
+    /**
+     * Writes the profiler's recorded frame times to
+     * PERFORMANCE_TRACE_FILE_NAME.
+     */
+    void exportPerformanceTrace();
+
     /** AmalgamUI initializer, used to init/quit the library at the proper
         times. */
     AUI::Initializer auiInitializer;
 
+    /** Records the frame times of each screen and window. Must be
+        constructed before the screens. */
+    PerformanceProfiler profiler;
+
+    /** The screens' sections in the profiler. */
+    PerformanceProfiler::SectionID titleScreenSectionID;
+    PerformanceProfiler::SectionID mainScreenSectionID;
+
+    /** Used to time the screens. */
+    Timer screenTimer;
+
     /** The opening title screen, seen on app launch. */
     TitleScreen titleScreen;
 
@@ -90,6 +125,12 @@ private:
 
     /** The current active UI screen. */
     AUI::Screen* currentScreen;
+
+    /** Shows the profiler's stats. */
+    PerformanceOverlay performanceOverlay;
+
+    /** If true, performanceOverlay should be rendered. */
+    bool performanceOverlayIsVisible;
 };
 
 } // End namespace Client
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "AUI/Widget.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace AM
+{
+namespace Client
+{
+class GlyphAtlas;
+
+/**
+ * A word-wrapped block of text that's drawn from a shared GlyphAtlas.
+ *
+ * Unlike AUI::Text, changing the text doesn't rasterize a new texture. It
+ * just re-places glyph quads, reusing this widget's storage. This makes it
+ * cheap enough to recycle for rapidly changing text, such as chat.
+ *
+ * The widget's height is set to fit the wrapped text. Text is UTF-8, and
+ * glyphs that aren't in the atlas yet are added as they're laid out.
+ */
+class AtlasText : public AUI::Widget
+{
+public:
+    //-------------------------------------------------------------------------
+    // Public interface
+    //-------------------------------------------------------------------------
+    AtlasText(GlyphAtlas& inGlyphAtlas, const SDL_Rect& inLogicalExtent,
+              const std::string& inDebugName = "AtlasText");
+
+    virtual ~AtlasText() = default;
+
+    /**
+     * Sets this widget's text and lays it out.
+     */
+    void setText(std::string_view inText);
+
+    /**
+     * Re-lays out the current text. Must be called if the glyph atlas is
+     * re-rasterized.
+     */
+    void refreshLayout();
+
+    //-------------------------------------------------------------------------
+    // Base class overrides
+    //-------------------------------------------------------------------------
+    void render(const SDL_Point& windowTopLeft = {}) override;
+
+private:
+    /**
+     * A single glyph to draw.
+     */
+    struct GlyphQuad {
+        /** The glyph's extent within the atlas texture. */
+        SDL_Rect sourceExtent{};
+
+        /** Where to draw the glyph, in actual pixels, relative to this
+            widget's top left. */
+        SDL_Rect destinationExtent{};
+    };
+
+    /** The atlas to draw glyphs from. */
+    GlyphAtlas& glyphAtlas;
+
+    /** The current text. */
+    std::string text;
+
+    /** The placed glyphs of the current text. */
+    std::vector<GlyphQuad> glyphQuads;
+};
+
+} // End namespace Client
+} // End namespace AM
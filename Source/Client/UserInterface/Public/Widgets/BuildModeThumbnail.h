@@ -6,13 +6,19 @@ namespace AM
 {
 namespace Client
 {
+class ThumbnailAtlas;
+
 /**
  * The thumbnail style used for the main screen.
+ *
+ * The background images are drawn from the thumbnail atlas. To batch with
+ * them, the thumbnail image should be set through the atlas as well.
  */
 class BuildModeThumbnail : public AUI::Thumbnail
 {
 public:
-    BuildModeThumbnail(const std::string& inDebugName = "BuildModeThumbnail");
+    BuildModeThumbnail(const ThumbnailAtlas& thumbnailAtlas,
+                       const std::string& inDebugName = "BuildModeThumbnail");
 };
 
 } // End namespace Client
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "MainButton.h"
+#include "VirtualThumbnailGrid.h"
+#include "SearchIndex.h"
 #include "EntityTemplates.h"
 #include "EntityInitScriptResponse.h"
 #include "AUI/Widget.h"
@@ -9,6 +11,8 @@
 #include "AUI/VerticalGridContainer.h"
 #include "QueuedEvents.h"
 #include "entt/fwd.hpp"
+#include <string_view>
+#include <vector>
 
 namespace AUI
 {
@@ -18,6 +22,7 @@ class Thumbnail;
 namespace AM
 {
 struct GraphicSet;
+struct EntityGraphicSet;
 struct Sprite;
 
 namespace Client
@@ -27,6 +32,8 @@ class Network;
 class GraphicData;
 class BuildPanel;
 class EntityTool;
+class BuildModeThumbnail;
+class ThumbnailAtlas;
 struct SpriteRenderData;
 
 /**
@@ -36,7 +43,9 @@ class EntityPanelContent : public AUI::Widget
 {
 public:
     EntityPanelContent(World& inWorld, Network& inNetwork,
-                       GraphicData& inGraphicData, BuildPanel& inBuildPanel,
+                       GraphicData& inGraphicData,
+                       const ThumbnailAtlas& inThumbnailAtlas,
+                       BuildPanel& inBuildPanel,
                        const SDL_Rect& inScreenExtent,
                        const std::string& inDebugName = "EntityPanelContent");
 
@@ -46,6 +55,13 @@ public:
      */
     void setBuildTool(EntityTool* inEntityTool);
 
+    /**
+     * Filters the sprite set view to the graphic sets whose display name or
+     * string ID contains the given query.
+     * An empty query shows every graphic set.
+     */
+    void setSearchQuery(std::string_view query);
+
     //-------------------------------------------------------------------------
     // Widget class overrides
     //-------------------------------------------------------------------------
@@ -93,6 +109,12 @@ private:
      */
     void addSpriteSetThumbnails();
 
+    /**
+     * Sets up the given thumbnail to represent the given entity graphic set.
+     */
+    void bindSpriteSetThumbnail(BuildModeThumbnail& thumbnail,
+                                const EntityGraphicSet& graphicSet);
+
     /**
      * Returns a square texture extent that shows the bottom of the given
      * sprite.
@@ -108,6 +130,9 @@ private:
     /** Used to get the graphic sets that we fill the panel with. */
     GraphicData& graphicData;
 
+    /** Used to draw thumbnail images from the shared atlas. */
+    const ThumbnailAtlas& thumbnailAtlas;
+
     /** Used to properly deselect thumbnails when a new one is selected. */
     BuildPanel& buildPanel;
 
@@ -133,6 +158,16 @@ private:
     /** Maps a sprite to the thumbnail that represents it. */
     std::unordered_map<const Sprite*, AUI::Thumbnail*> spriteThumbnailMap;
 
+    /** The graphic sets that graphicSetContainer can show, in order. */
+    std::vector<const EntityGraphicSet*> spriteSetThumbnailData;
+
+    /** Indexes spriteSetThumbnailData by graphic set name. */
+    SearchIndex spriteSetSearchIndex;
+
+    /** The indices into spriteSetThumbnailData that match the current search,
+        in the order that graphicSetContainer shows them. */
+    std::vector<Uint32> spriteSetSearchResults;
+
     EventQueue<EntityTemplates> entityTemplatesQueue;
 
     EventQueue<EntityInitScriptResponse> entityInitScriptQueue;
@@ -160,7 +195,7 @@ private:
     // GraphicSet selection view
     /** Holds the graphic sets that are used to change a selected entity's
         graphics. */
-    AUI::VerticalGridContainer graphicSetContainer;
+    VirtualThumbnailGrid graphicSetContainer;
 };
 
 } // End namespace Client
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "MainButton.h"
+#include "VirtualThumbnailGrid.h"
+#include "SearchIndex.h"
 #include "ItemID.h"
 #include "ItemError.h"
 #include "ItemInitScriptResponse.h"
@@ -8,9 +10,9 @@
 #include "AUI/Text.h"
 #include "AUI/TextInput.h"
 #include "AUI/Image.h"
-#include "AUI/VerticalGridContainer.h"
 #include "QueuedEvents.h"
 #include <string_view>
+#include <vector>
 
 namespace AUI
 {
@@ -20,6 +22,7 @@ class Thumbnail;
 namespace AM
 {
 struct Item;
+struct Icon;
 
 namespace Client
 {
@@ -28,6 +31,8 @@ class World;
 class Network;
 class ItemData;
 class IconData;
+class BuildModeThumbnail;
+class ThumbnailAtlas;
 
 /**
  * Content for the BuildPanel when the item tool is selected.
@@ -37,6 +42,7 @@ class ItemPanelContent : public AUI::Widget
 public:
     ItemPanelContent(Simulation& inSimulation, Network& inNetwork,
                      ItemData& inItemData, IconData& inIconData,
+                     const ThumbnailAtlas& inThumbnailAtlas,
                      const SDL_Rect& inScreenExtent,
                      const std::string& inDebugName = "ItemPanelContent");
 
@@ -46,6 +52,13 @@ public:
      */
     void reset();
 
+    /**
+     * Filters the item cache and icon list views to the entries whose display
+     * name or string ID contains the given query.
+     * An empty query shows every entry.
+     */
+    void setSearchQuery(std::string_view query);
+
     //-------------------------------------------------------------------------
     // Widget class overrides
     //-------------------------------------------------------------------------
@@ -62,7 +75,7 @@ private:
      * If we have a pending requested item and this matches it, finishes
      * selecting the item and fills out the UI.
      *
-     * Also refreshes itemCacheContainer.
+     * Also adds or patches the item's thumbnail in itemCacheContainer.
      */
     void onItemUpdate(ItemID itemID);
 
@@ -93,15 +106,35 @@ private:
     void changeView(ViewType newView);
 
     /**
-     * Fills the item container with all of our cached items.
+     * Fills the item container with the cached items that match the current
+     * search.
+     * Only needed when the search changes. Item changes are applied by
+     * updateItemCacheEntry().
      */
     void refreshItemCacheThumbnails();
 
+    /**
+     * Updates the given item's search index entry, then adds, patches, moves,
+     * or removes its thumbnail in itemCacheContainer to match.
+     * Only the thumbnails at or after the item's position are re-bound.
+     */
+    void updateItemCacheEntry(const Item& item);
+
+    /**
+     * Sets up the given thumbnail to represent the given item.
+     */
+    void bindItemThumbnail(BuildModeThumbnail& thumbnail, const Item& item);
+
     /**
      * Fills the icon container will all of the available icons.
      */
     void addIconThumbnails();
 
+    /**
+     * Sets up the given thumbnail to represent the given icon.
+     */
+    void bindIconThumbnail(BuildModeThumbnail& thumbnail, const Icon& icon);
+
     // These all make their widgets visible and set any needed callbacks.
     void showHomeView();
     void showCreateView();
@@ -116,6 +149,8 @@ private:
     ItemData& itemData;
     /** Used to get the item icons. */
     IconData& iconData;
+    /** Used to draw item icons from the shared atlas. */
+    const ThumbnailAtlas& thumbnailAtlas;
 
     /** The current content view type. */
     ViewType currentView;
@@ -142,6 +177,27 @@ private:
         saved it in editinItemInitScript). */
     bool initScriptReceived;
 
+    /** The current search query. */
+    std::string searchQuery;
+
+    /** Indexes our cached items by name. Kept up to date as items are
+        created and updated. */
+    SearchIndex itemSearchIndex;
+
+    /** The IDs of the cached items that match the current search, in the
+        order that itemCacheContainer shows them. */
+    std::vector<Uint32> itemCacheSearchResults;
+
+    /** The icons that iconContainer can show, in order. */
+    std::vector<const Icon*> iconThumbnailData;
+
+    /** Indexes iconThumbnailData by icon name. */
+    SearchIndex iconSearchIndex;
+
+    /** The indices into iconThumbnailData that match the current search, in
+        the order that iconContainer shows them. */
+    std::vector<Uint32> iconSearchResults;
+
     EventQueue<ItemError> itemErrorQueue;
     EventQueue<ItemInitScriptResponse> itemInitScriptQueue;
 
@@ -178,10 +234,10 @@ private:
 
     // Cache view
     /** Holds thumbnails for our cached items. */
-    AUI::VerticalGridContainer itemCacheContainer;
+    VirtualThumbnailGrid itemCacheContainer;
 
     // IconList view
-    AUI::VerticalGridContainer iconContainer;
+    VirtualThumbnailGrid iconContainer;
 };
 
 } // End namespace Client
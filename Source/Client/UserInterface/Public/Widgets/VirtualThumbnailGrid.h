@@ -0,0 +1,192 @@
+#pragma once
+
+#include "AUI/Widget.h"
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace AM
+{
+namespace Client
+{
+class ThumbnailAtlas;
+class BuildModeThumbnail;
+
+/**
+ * A scrollable grid of BuildModeThumbnails that only creates widgets for the
+ * rows that are on screen, plus a small margin.
+ *
+ * Unlike AUI::VerticalGridContainer, the grid doesn't own a widget per item.
+ * Instead, the user gives it an item count and a bind callback. As the grid
+ * scrolls, thumbnails whose items scrolled out of range are recycled and
+ * re-bound to the newly visible items. Since thumbnails are only bound when
+ * their item comes into range, their images are only loaded on demand.
+ *
+ * Since thumbnails are recycled, the selection is tracked by item index
+ * rather than by widget. Whenever the selected item's thumbnail is bound, it's
+ * re-selected.
+ *
+ * Scrolling moves one row per mouse wheel step.
+ */
+class VirtualThumbnailGrid : public AUI::Widget
+{
+public:
+    //-------------------------------------------------------------------------
+    // Public interface
+    //-------------------------------------------------------------------------
+    VirtualThumbnailGrid(const ThumbnailAtlas& inThumbnailAtlas,
+                         const SDL_Rect& inLogicalExtent,
+                         const std::string& inDebugName
+                         = "VirtualThumbnailGrid");
+
+    virtual ~VirtualThumbnailGrid() = default;
+
+    void setNumColumns(int inNumColumns);
+
+    void setCellWidth(int inCellWidth);
+
+    void setCellHeight(int inCellHeight);
+
+    /**
+     * Sets the number of items in the grid, and re-binds every thumbnail.
+     * Must be called whenever the items change.
+     *
+     * Note: Since the items may have changed, this clears the selection.
+     */
+    void setItemCount(std::size_t inItemCount);
+
+    std::size_t getItemCount() const;
+
+    /**
+     * Tells the grid that an item was inserted at the given index.
+     * Only the thumbnails for the items at or after the index are re-bound.
+     */
+    void insertItem(std::size_t index);
+
+    /**
+     * Tells the grid that the item at the given index was removed.
+     * Only the thumbnails for the items at or after the index are re-bound.
+     */
+    void removeItem(std::size_t index);
+
+    /**
+     * Tells the grid that the item at the given index changed.
+     * If the item has a bound thumbnail, only that thumbnail is re-bound.
+     */
+    void refreshItem(std::size_t index);
+
+    /**
+     * Selects the item at the given index, deselecting the previous selection.
+     * If the item has a bound thumbnail, it's selected now. Otherwise, it'll
+     * be selected when it comes into range.
+     */
+    void setSelectedItem(std::size_t index);
+
+    /**
+     * Deselects the selected item, if there is one.
+     */
+    void clearSelectedItem();
+
+    /**
+     * Returns the index of the selected item, or NO_SELECTION if there isn't
+     * one.
+     */
+    std::size_t getSelectedItem() const;
+
+    /** Returned by getSelectedItem() when no item is selected. */
+    static constexpr std::size_t NO_SELECTION{SIZE_MAX};
+
+    //-------------------------------------------------------------------------
+    // Callback registration
+    //-------------------------------------------------------------------------
+    /**
+     * @param inOnBindThumbnail A callback that sets up the given thumbnail
+     *                          (image, callbacks, etc) to represent the item
+     *                          at the given index.
+     */
+    void setOnBindThumbnail(
+        std::function<void(BuildModeThumbnail&, std::size_t)>
+            inOnBindThumbnail);
+
+    //-------------------------------------------------------------------------
+    // Base class overrides
+    //-------------------------------------------------------------------------
+    AUI::EventResult onMouseWheel(int amountScrolled) override;
+
+private:
+    /** The number of rows above and below the visible rows that we keep
+        thumbnails bound for. */
+    static constexpr int MARGIN_ROWS{1};
+
+    /** Used to mark a thumbnail that isn't bound to any item. */
+    static constexpr std::size_t NOT_BOUND{SIZE_MAX};
+
+    /**
+     * Returns the number of rows that fit within this widget.
+     */
+    int getVisibleRowCount() const;
+
+    /**
+     * Returns the number of rows that the items fill.
+     */
+    int getRowCount() const;
+
+    /**
+     * Clamps firstVisibleRow so we can't scroll past the last row.
+     */
+    void clampScroll();
+
+    /**
+     * Binds any thumbnails whose items came into range, and positions and
+     * shows the thumbnails for the visible rows.
+     */
+    void updateThumbnails();
+
+    /**
+     * Unbinds every thumbnail that's bound to the given item index or later,
+     * so they'll be re-bound by the next updateThumbnails().
+     */
+    void unbindFrom(std::size_t index);
+
+    /**
+     * If the given item has a bound thumbnail, returns it. Else, returns
+     * nullptr.
+     */
+    BuildModeThumbnail* getBoundThumbnail(std::size_t index);
+
+    /** Used to style the thumbnails that we create. */
+    const ThumbnailAtlas& thumbnailAtlas;
+
+    std::function<void(BuildModeThumbnail&, std::size_t)> onBindThumbnail;
+
+    int numColumns;
+    int cellWidth;
+    int cellHeight;
+
+    /** The number of items in the grid. */
+    std::size_t itemCount;
+
+    /** The index of the topmost visible row. */
+    int firstVisibleRow;
+
+    /** The recycled thumbnails. Item i is always bound to thumbnail
+        (i % activeThumbnailCount), so thumbnails whose items stay in range
+        don't need to be re-bound when we scroll.
+        Note: These are pointers so that the children list's references
+              stay valid. */
+    std::vector<std::unique_ptr<BuildModeThumbnail>> thumbnails;
+
+    /** The number of thumbnails that are needed to cover the visible rows
+        and margins. If the layout shrinks, the extra thumbnails are kept
+        but left hidden. */
+    std::size_t activeThumbnailCount;
+
+    /** The index of the item that each thumbnail is bound to. */
+    std::vector<std::size_t> boundItemIndices;
+
+    /** The index of the selected item, or NO_SELECTION. */
+    std::size_t selectedItemIndex;
+};
+
+} // End namespace Client
+} // End namespace AM
@@ -8,9 +8,12 @@
 #include "Log.h"
 #include "AUI/Window.h"
 #include "AUI/Image.h"
-#include "AUI/VerticalGridContainer.h"
+#include "VirtualThumbnailGrid.h"
+#include "SearchIndex.h"
 #include "AUI/Text.h"
+#include "AUI/TextInput.h"
 #include <concepts>
+#include <vector>
 
 namespace AUI
 {
@@ -30,6 +33,8 @@ class GraphicData;
 class ItemData;
 class IconData;
 class BuildOverlay;
+class BuildModeThumbnail;
+class ThumbnailAtlas;
 
 /**
  * The build panel on the main screen. Allows the user to select which tile
@@ -45,7 +50,8 @@ public:
     //-------------------------------------------------------------------------
     BuildPanel(Simulation& inSimulation, Network& inNetwork,
                GraphicData& inGraphicData, ItemData& inItemData,
-               IconData& inIconData, BuildOverlay& inBuildOverlay);
+               IconData& inIconData, const ThumbnailAtlas& inThumbnailAtlas,
+               BuildOverlay& inBuildOverlay);
 
     ~BuildPanel() = default;
 
@@ -54,23 +60,73 @@ public:
      * the given thumbnail as the new selection.
      * Used by content classes to make sure the old selection gets deselected
      * when we change tools.
+     *
+     * Note: The given thumbnail must be owned by a regular container. Virtual
+     *       grids recycle their thumbnails, so their selection is tracked by
+     *       item index instead.
      */
     void setSelectedThumbnail(AUI::Thumbnail& newSelectedThumbnail);
 
     /**
-     * Deselects the currently selected thumbnail (if there is one) without
-     * setting a new selection.
+     * Deselects the currently selected thumbnail or tile graphic set (if
+     * there is one) without setting a new selection.
      */
     void clearSelectedThumbnail();
 
 private:
+    /** Used for selectedTileDataIndex when no tile graphic set is selected. */
+    static constexpr Uint32 NO_TILE_SELECTION{UINT32_MAX};
+
+    /**
+     * A tile graphic set, and the sprite to show in its thumbnail.
+     */
+    struct TileThumbnailData {
+        const GraphicSet* graphicSet{nullptr};
+        const Sprite* sprite{nullptr};
+    };
+
     /**
-     * Adds a graphic set thumbnail to the appropriate tile graphic set 
-     * container.
+     * The graphic sets that a tile layer container can show, and the subset
+     * of them that match the current search.
+     */
+    struct TileThumbnailList {
+        /** The graphic sets that the container can show, in order. */
+        std::vector<TileThumbnailData> thumbnailData{};
+
+        /** Indexes thumbnailData by graphic set name. */
+        SearchIndex searchIndex{};
+
+        /** The indices into thumbnailData that match the current search, in
+            the order that the container shows them. */
+        std::vector<Uint32> searchResults{};
+    };
+
+    /**
+     * Adds a graphic set to the appropriate tile graphic set list.
+     * The thumbnail itself is only created once it scrolls into view.
      */
     void addTileGraphicSet(TileLayer::Type type, const GraphicSet& graphicSet,
                           const Sprite& sprite);
 
+    /**
+     * Sets up the given thumbnail to represent the given item in the given
+     * tile layer container.
+     */
+    void bindTileThumbnail(VirtualThumbnailGrid& container,
+                           TileThumbnailList& list,
+                           BuildModeThumbnail& thumbnail,
+                           std::size_t itemIndex);
+
+    /**
+     * Deselects the old selection and selects the given item in the given
+     * tile layer container.
+     *
+     * @param dataIndex The index of the item's entry in its list's
+     *                  thumbnailData.
+     */
+    void setSelectedTileItem(VirtualThumbnailGrid& container,
+                             std::size_t itemIndex, Uint32 dataIndex);
+
     /**
      * Returns the first graphic within the set.
      */
@@ -85,16 +141,41 @@ private:
      */
     void setBuildMode(BuildMode::Type buildModeType);
 
+    /**
+     * Filters the current build mode's content to the entries that match
+     * searchInput's text.
+     */
+    void applySearch();
+
     /** Used to send and receive content-related build mode messages. */
     Network& network;
     /** Used to get the graphic sets that we fill the panel with. */
     GraphicData& graphicData;
+    /** Used to draw thumbnail images from the shared atlas. */
+    const ThumbnailAtlas& thumbnailAtlas;
     /** We keep the overlay updated on which tool and sprite set is selected. */
     BuildOverlay& buildOverlay;
 
-    /** The currently selected sprite set thumbnail. */
+    /** The currently selected entity template thumbnail.
+        Note: Tile layer selections are tracked by selectedTileDataIndex,
+              since their thumbnails are recycled. */
     AUI::Thumbnail* selectedThumbnail;
 
+    /** The index within the current build mode's thumbnailData of the
+        selected tile graphic set, or NO_TILE_SELECTION.
+        Stays valid when the search changes, so the selection can be
+        re-applied to the filtered container. */
+    Uint32 selectedTileDataIndex;
+
+    /** The build mode that we're currently showing the content of. */
+    BuildMode::Type currentBuildMode;
+
+    /** The graphic sets that each tile layer container can show. */
+    TileThumbnailList terrainThumbnails;
+    TileThumbnailList floorThumbnails;
+    TileThumbnailList wallThumbnails;
+    TileThumbnailList objectThumbnails;
+
     //-------------------------------------------------------------------------
     // Private child widgets
     //-------------------------------------------------------------------------
@@ -103,16 +184,16 @@ private:
     // Note: Since all of the tile layer tools have the same UI, we handle their
     //       content in this class. Other tools get their own content widgets.
     // Terrain tile layer tool content.
-    AUI::VerticalGridContainer terrainContainer;
+    VirtualThumbnailGrid terrainContainer;
 
     // Floor tile layer tool content.
-    AUI::VerticalGridContainer floorContainer;
+    VirtualThumbnailGrid floorContainer;
 
     // Wall tile layer tool content.
-    AUI::VerticalGridContainer wallContainer;
+    VirtualThumbnailGrid wallContainer;
 
     // Object tile layer tool content.
-    AUI::VerticalGridContainer objectContainer;
+    VirtualThumbnailGrid objectContainer;
 
     // Entity tool content panel.
     EntityPanelContent entityPanelContent;
@@ -126,6 +207,9 @@ private:
     AUI::Text tileLayersLabel;
     AUI::Text otherLabel;
 
+    /** Used for filtering the current content by name. */
+    AUI::TextInput searchInput;
+
     std::array<MainButton, BuildMode::Type::Count> buildModeButtons;
 };
 
@@ -2,12 +2,13 @@
 
 #include "SystemMessage.h"
 #include "Timer.h"
+#include "GlyphAtlas.h"
+#include "AtlasText.h"
 #include "AUI/Window.h"
-#include "AUI/Text.h"
-#include "AUI/VerticalListContainer.h"
 #include "QueuedEvents.h"
 #include <SDL_stdinc.h>
 #include <memory>
+#include <vector>
 
 struct SDL_Renderer;
 
@@ -62,8 +63,14 @@ private:
      */
     void addCastFailedMessage(const CastFailed& castFailed);
 
-    /** The maximum number of messages that our messageContainer will hold.
-        As we receive more, the oldest will be erased. */
+    /**
+     * Stacks the messages from newest (at the bottom) to oldest, hiding any
+     * that don't fit.
+     */
+    void layoutMessages();
+
+    /** The maximum number of messages that we'll hold. As we receive more,
+        the oldest message's widget is recycled. */
     static constexpr std::size_t MAX_MESSAGES{15};
 
     /** How long this window should stay at full alpha after receiving a
@@ -108,11 +115,23 @@ private:
 
     EventQueue<SystemMessage> systemMessageQueue;
 
+    /** The glyphs that our messages are drawn with. */
+    GlyphAtlas glyphAtlas;
+
+    /** The index within messageTexts of the newest message. */
+    std::size_t newestMessageIndex;
+
+    /** The number of messages that we've received, up to MAX_MESSAGES. */
+    std::size_t messageCount;
+
     //-------------------------------------------------------------------------
     // Private child widgets
     //-------------------------------------------------------------------------
-    /** Holds the player and system messages. */
-    AUI::VerticalListContainer messageContainer;
+    /** A ring of MAX_MESSAGES widgets that hold the player and system
+        messages. They're allocated once and recycled, oldest first.
+        Note: These are pointers so that the children list's references stay
+              valid. */
+    std::vector<std::unique_ptr<AtlasText>> messageTexts;
 };
 
 } // End namespace Client
@@ -1,15 +1,16 @@
 #pragma once
 
 #include "ItemID.h"
+#include "Inventory.h"
 #include "AUI/Window.h"
 #include "AUI/Image.h"
 #include "AUI/VerticalGridContainer.h"
 #include "QueuedEvents.h"
 #include "entt/fwd.hpp"
+#include <vector>
 
 namespace AM
 {
-struct Inventory;
 struct Item;
 
 namespace Client
@@ -19,12 +20,17 @@ class World;
 class Network;
 class ItemData;
 class IconData;
+class ThumbnailAtlas;
 class ViewModel;
 class InteractionManager;
 class ItemThumbnail;
 
 /**
  * The inventory window on the main screen. Shows the player's inventory.
+ *
+ * Each slot's thumbnail is kept for the life of the window. When the
+ * inventory changes, only the thumbnails for the slots that changed are
+ * updated.
  */
 class InventoryWindow : public AUI::Window
 {
@@ -34,6 +40,7 @@ public:
     //-------------------------------------------------------------------------
     InventoryWindow(Simulation& inSimulation, Network& inNetwork,
                     ItemData& inItemData, IconData& inIconData,
+                    const ThumbnailAtlas& inThumbnailAtlas,
                     ViewModel& inViewModel,
                     InteractionManager& inInteractionManager);
 
@@ -41,8 +48,8 @@ public:
     // Base class overrides
     //-------------------------------------------------------------------------
     /**
-     * Calls Window::arrange() and, if itemContainer has been refreshed,
-     * notifies InteractionManager.
+     * Calls Window::arrange() and, if any slots changed, updates the hovered
+     * item.
      */
     void arrange() override;
 
@@ -51,7 +58,8 @@ private:
     static constexpr int THUMBNAIL_SIZE{58};
 
     /**
-     * Refreshes itemContainer, making it match the given inventory.
+     * Compares the given inventory to displayedSlots, and updates the
+     * thumbnails of any slots that changed.
      */
     void refresh(const Inventory& inventory);
 
@@ -60,13 +68,25 @@ private:
      */
     ItemThumbnail& addEmptyThumbnail(Uint8 slotIndex);
 
+    /**
+     * Returns the thumbnail for the given slot.
+     */
+    ItemThumbnail& getSlotThumbnail(Uint8 slotIndex);
+
     /**
      * Turns the given empty thumbnail into an item thumbnail.
      * Used for non-empty slots, after first calling addEmptyThumbnail().
+     *
+     * May also be called on an item thumbnail to re-load its item.
      */
     void finishItemThumbnail(ItemThumbnail& thumbnail, ItemID itemID,
                              Uint8 itemCount, Uint8 slotIndex);
 
+    /**
+     * Turns the given item thumbnail back into an empty thumbnail.
+     */
+    void clearItemThumbnail(ItemThumbnail& thumbnail);
+
     void onInventoryUpdated(entt::registry& registry, entt::entity entity);
     void onItemUpdate(ItemID itemID);
 
@@ -78,21 +98,27 @@ private:
     ItemData& itemData;
     /** Used to get item icons. */
     IconData& iconData;
+    /** Used to draw item icons from the shared atlas. */
+    const ThumbnailAtlas& thumbnailAtlas;
     /** Used to update hovered/targeted item state. */
     ViewModel& viewModel;
     /** Used to orchestrate item/entity interactions. */
     InteractionManager& interactionManager;
 
-    /** If true, itemContainer has been refreshed and InteractionManager needs
-        to be notified. */
-    bool wasRefreshed;
+    /** The inventory slots that our thumbnails are currently showing. */
+    std::vector<Inventory::ItemSlot> displayedSlots;
+
+    /** The slots whose thumbnails changed since the last arrange(). */
+    std::vector<Uint8> changedSlots;
 
     //-------------------------------------------------------------------------
     // Private child widgets
     //-------------------------------------------------------------------------
     AUI::Image backgroundImage;
 
-    /** Holds the inventory slot thumbnails. */
+    /** Holds the inventory slot thumbnails.
+        Note: If the inventory shrinks, the thumbnails for the removed slots
+              are hidden and kept, in case it grows again. */
     AUI::VerticalGridContainer slotContainer;
 };
 
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "PerformanceProfiler.h"
+#include "Timer.h"
+#include "AUI/Widget.h"
+#include <string_view>
+#include <utility>
+
+namespace AM
+{
+namespace Client
+{
+/**
+ * Wraps the given window type, timing its tick, layout, and render stages
+ * in the given profiler.
+ *
+ * Usage: Declare e.g. "ProfiledWindow<ChatWindow> chatWindow;" and pass
+ *        the profiler and a section name before ChatWindow's usual
+ *        constructor args.
+ *
+ * Note: AUI doesn't let us walk a child's children, so the recorded widget
+ *       count is the number of the window's direct children.
+ */
+template<typename WindowType>
+class ProfiledWindow : public WindowType
+{
+public:
+    template<typename... Args>
+    ProfiledWindow(PerformanceProfiler& inProfiler,
+                   std::string_view sectionName, Args&&... args)
+    : WindowType(std::forward<Args>(args)...)
+    , profiler{inProfiler}
+    , sectionID{inProfiler.addSection(sectionName)}
+    , stageTimer{}
+    {
+    }
+
+    //-------------------------------------------------------------------------
+    // Widget class overrides
+    //-------------------------------------------------------------------------
+    void onTick(double timestepS) override
+    {
+        stageTimer.reset();
+        WindowType::onTick(timestepS);
+        profiler.addTime(sectionID, PerformanceProfiler::Stage::Tick,
+                         stageTimer.getTime());
+    }
+
+    void measure() override
+    {
+        stageTimer.reset();
+        WindowType::measure();
+        profiler.addTime(sectionID, PerformanceProfiler::Stage::Layout,
+                         stageTimer.getTime());
+    }
+
+    void arrange() override
+    {
+        stageTimer.reset();
+        WindowType::arrange();
+        profiler.addTime(sectionID, PerformanceProfiler::Stage::Layout,
+                         stageTimer.getTime());
+    }
+
+    void render() override
+    {
+        stageTimer.reset();
+        WindowType::render();
+        profiler.addTime(sectionID, PerformanceProfiler::Stage::Render,
+                         stageTimer.getTime());
+
+        std::size_t widgetCount{0};
+        for ([[maybe_unused]] AUI::Widget& child : this->children) {
+            widgetCount++;
+        }
+        profiler.setWidgetCount(sectionID, widgetCount);
+    }
+
+private:
+    /** The profiler to record our times in. */
+    PerformanceProfiler& profiler;
+
+    /** Our section in the profiler. */
+    PerformanceProfiler::SectionID sectionID;
+
+    /** Times each stage. */
+    Timer stageTimer;
+};
+
+} // End namespace Client
+} // End namespace AM
@@ -64,6 +64,12 @@ public:
         in seconds. */
     static constexpr float SAVE_PERIOD_S{60 * 15};
 
+    /** How often the project's persisted components should be saved for any
+        entities that changed since the last save, in seconds.
+        These saves only touch changed entities, so they're cheap enough to
+        run much more often than the full save above. */
+    static constexpr float INCREMENTAL_SAVE_PERIOD_S{5};
+
     //-------------------------------------------------------------------------
     // Network
     //-------------------------------------------------------------------------
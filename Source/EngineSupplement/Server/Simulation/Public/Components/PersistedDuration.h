@@ -0,0 +1,42 @@
+#pragma once
+
+#include "bitsery/ext/compact_value.h"
+#include <SDL_stdinc.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace AM
+{
+namespace Server
+{
+
+/**
+ * Serializes a duration in seconds as a whole number of milliseconds, using a
+ * variable-length encoding.
+ *
+ * Persisted durations (AI timings, etc) are set by hand and only need
+ * millisecond precision. Typical values fit in 2-3 bytes, instead of the 8
+ * bytes that a double takes.
+ *
+ * Note: The given value is quantized in place, so a saved component matches
+ *       what will be loaded. Non-finite values (NaN, inf) are saved as 0.
+ */
+template<typename S>
+void serializePersistedDuration(S& serializer, double& seconds)
+{
+    static constexpr double MAX_MILLISECONDS{
+        static_cast<double>(std::numeric_limits<Uint32>::max())};
+    Uint32 milliseconds{0};
+    if (std::isfinite(seconds)) {
+        milliseconds = static_cast<Uint32>(
+            std::clamp(std::round(seconds * 1000.0), 0.0, MAX_MILLISECONDS));
+    }
+
+    serializer.ext4b(milliseconds, bitsery::ext::CompactValue{});
+
+    seconds = (milliseconds / 1000.0);
+}
+
+} // namespace Server
+} // namespace AM
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "AILogic.h"
+#include "PersistedDuration.h"
 #include "Timer.h"
 #include "entt/fwd.hpp"
 #include <string>
@@ -75,9 +76,10 @@ void serialize(S& serializer, RandomWalkerAI& randomWalkerAI)
 {
     // Note: We only serialize the configuration variables. 
     //       Current state variables will be defaulted.
-    serializer.value8b(randomWalkerAI.timeToWalk);
-    serializer.value8b(randomWalkerAI.timeToWait);
-    serializer.value8b(randomWalkerAI.timeTillDirectionChange);
+    serializePersistedDuration(serializer, randomWalkerAI.timeToWalk);
+    serializePersistedDuration(serializer, randomWalkerAI.timeToWait);
+    serializePersistedDuration(serializer,
+                               randomWalkerAI.timeTillDirectionChange);
 }
 
 } // namespace Server
@@ -19,8 +19,13 @@ namespace Server
  * If ProjectPersistedComponentTypes is changed in any way, or the fields of any
  * component in the list are changed in a way that changes their serialization, 
  * you must increment this number and run a migration.
+ *
+ * Version history:
+ *   0: Initial version.
+ *   1: RandomWalkerAI timings are stored as variable-length milliseconds.
+ *      Migrate with the MigrateProjectComponents tool.
  */
-static constexpr unsigned int PROJECT_COMPONENTS_VERSION{0};
+static constexpr unsigned int PROJECT_COMPONENTS_VERSION{1};
 
 /**
  * All of the project's component types that should be saved to the database 
@@ -3,20 +3,69 @@
 #include "ProjectUserConfig.h"
 #include "MessageProcessorExtension.h"
 #include "SimulationExtension.h"
+#include "ProjectPersistedComponentTypes.h"
+#include "Paths.h"
 
 #include "SDL2pp/Exception.hh"
+#include "SQLiteCpp/Database.h"
 
 #include <exception>
+#include <filesystem>
+#include <string>
 
 using namespace AM;
 using namespace AM::Server;
 
+/**
+ * Returns false if the database's persisted project components are at a
+ * different version than this build uses.
+ *
+ * The engine decodes the components while it loads, before any of our
+ * extension code runs, so we check here instead of letting it fail partway
+ * through.
+ */
+static bool checkProjectComponentsVersion()
+{
+    std::string databasePath{Paths::BASE_PATH + "Database.db3"};
+    if (!std::filesystem::exists(databasePath)) {
+        // No database yet. The engine will create one at our version.
+        return true;
+    }
+
+    try {
+        SQLite::Database database{databasePath, SQLite::OPEN_READONLY};
+        unsigned int version{static_cast<unsigned int>(
+            database.execAndGet("SELECT projectComponentsVersion FROM versions")
+                .getInt())};
+        if (version != PROJECT_COMPONENTS_VERSION) {
+            LOG_ERROR("Database.db3 has project components version %u, but "
+                      "this server uses version %u. Run "
+                      "\"MigrateProjectComponents.exe %s\" to migrate it "
+                      "before starting the server.",
+                      version, PROJECT_COMPONENTS_VERSION,
+                      databasePath.c_str());
+            return false;
+        }
+    } catch (SQLite::Exception& e) {
+        // Leave any other database problems for the engine to report.
+        LOG_INFO("Failed to check the project components version: %s",
+                 e.what());
+    }
+
+    return true;
+}
+
 // Note: SDL2 needs this signature for main, but we don't use the parameters.
 int main(int, char**)
 try {
     // Set up file logging.
     Log::enableFileLogging("Server.log");
 
+    // Make sure the engine will be able to load our persisted components.
+    if (!checkProjectComponentsVersion()) {
+        return 1;
+    }
+
     // Construct the app.
     Application app{};
 
@@ -4,6 +4,8 @@
 #include "ProjectMessageType.h"
 #include "EntityTemplatesRequest.h"
 #include "AddEntityTemplate.h"
+#include "BulkSpawnRequest.h"
+#include "TileExtentEdit.h"
 #include "Log.h"
 #include "QueuedEvents.h"
 #include <span>
@@ -53,6 +55,16 @@ void MessageProcessorExtension::processReceivedMessage(NetworkID netID,
                                                networkEventDispatcher);
             break;
         }
+        case ProjectMessageType::BulkSpawnRequest: {
+            dispatchWithNetID<BulkSpawnRequest>(
+                netID, {messageBuffer, messageSize}, networkEventDispatcher);
+            break;
+        }
+        case ProjectMessageType::TileExtentEdit: {
+            dispatchWithNetID<TileExtentEdit>(
+                netID, {messageBuffer, messageSize}, networkEventDispatcher);
+            break;
+        }
         default: {
             LOG_FATAL("Received unexpected message type: %u", messageType);
             break;
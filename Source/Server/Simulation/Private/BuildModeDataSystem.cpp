@@ -18,6 +18,7 @@ BuildModeDataSystem::BuildModeDataSystem(
 , entityTemplates{}
 , entityTemplatesRequestQueue{inNetworkEventDispatcher}
 , addEntityTemplateQueue{inNetworkEventDispatcher}
+, onTemplateAdded{}
 {
     // Load our saved templates.
     // TODO: Replace this placeholder data with real data from a database.
@@ -49,7 +50,11 @@ void BuildModeDataSystem::processMessages()
                 templateData.initScript = *initScript;
             }
 
-            entityTemplates.templates.push_back(templateData);
+            addTemplate(templateData);
+
+            if (onTemplateAdded != nullptr) {
+                onTemplateAdded(templateData);
+            }
         }
     }
 
@@ -61,5 +66,16 @@ void BuildModeDataSystem::processMessages()
     }
 }
 
+void BuildModeDataSystem::addTemplate(const EntityTemplates::Data& templateData)
+{
+    entityTemplates.templates.push_back(templateData);
+}
+
+void BuildModeDataSystem::setOnTemplateAdded(
+    std::function<void(const EntityTemplates::Data&)> inOnTemplateAdded)
+{
+    onTemplateAdded = inOnTemplateAdded;
+}
+
 } // End namespace Server
 } // End namespace AM
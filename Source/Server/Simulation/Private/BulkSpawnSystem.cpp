@@ -0,0 +1,218 @@
+#include "BulkSpawnSystem.h"
+#include "World.h"
+#include "GraphicData.h"
+#include "ISimulationExtension.h"
+#include "RandomWalkerAI.h"
+#include "GraphicState.h"
+#include "Collision.h"
+#include "Input.h"
+#include "Movement.h"
+#include "MovementModifiers.h"
+#include "TilePosition.h"
+#include "SharedConfig.h"
+#include "Log.h"
+#include <algorithm>
+#include <cmath>
+
+namespace AM
+{
+namespace Server
+{
+
+BulkSpawnSystem::BulkSpawnSystem(World& inWorld,
+                                 EventDispatcher& inNetworkEventDispatcher,
+                                 const GraphicData& inGraphicData,
+                                 const ISimulationExtension& inExtension)
+: world{inWorld}
+, graphicData{inGraphicData}
+, extension{inExtension}
+, pendingRequests{}
+, groupPositions{}
+, groupEntities{}
+, randomDevice{}
+, generator{randomDevice()}
+, bulkSpawnRequestQueue{inNetworkEventDispatcher}
+, onGroupSpawned{}
+{
+}
+
+void BulkSpawnSystem::queueSpawn(const BulkSpawnRequest& bulkSpawnRequest)
+{
+    pendingRequests.push_back({bulkSpawnRequest, false});
+}
+
+void BulkSpawnSystem::spawnEntities()
+{
+    // Validate any waiting client requests.
+    BulkSpawnRequest bulkSpawnRequest{};
+    while (bulkSpawnRequestQueue.pop(bulkSpawnRequest)) {
+        // Only check the part of the extent that's within the map.
+        bulkSpawnRequest.tileExtent.intersectWith(
+            world.tileMap.getTileExtent());
+        if (extension.isTileExtentEditable(bulkSpawnRequest.netID,
+                                           bulkSpawnRequest.tileExtent)) {
+            pendingRequests.push_back({bulkSpawnRequest, true});
+        }
+    }
+
+    // Process all of the valid requests, respecting the entity cap.
+    for (const PendingRequest& pendingRequest : pendingRequests) {
+        const BulkSpawnRequest& request{pendingRequest.request};
+        if (!isRequestValid(request)) {
+            continue;
+        }
+
+        std::size_t spawnCount{clampToEntityCap(request.spawnCount)};
+        if (spawnCount < request.spawnCount) {
+            LOG_INFO("Bulk spawn clamped from %u to %zu entities.",
+                     request.spawnCount, spawnCount);
+        }
+
+        if (spawnCount > 0) {
+            scatterPositions(request, spawnCount);
+            createGroup(request, groupPositions);
+
+            if (onGroupSpawned != nullptr) {
+                onGroupSpawned(request, pendingRequest.isFromClient,
+                               groupEntities);
+            }
+        }
+    }
+
+    pendingRequests.clear();
+}
+
+void BulkSpawnSystem::setOnGroupSpawned(
+    std::function<void(const BulkSpawnRequest&, bool,
+                       std::span<const entt::entity>)>
+        inOnGroupSpawned)
+{
+    onGroupSpawned = inOnGroupSpawned;
+}
+
+bool BulkSpawnSystem::isRequestValid(
+    const BulkSpawnRequest& bulkSpawnRequest) const
+{
+    // The extent must contain at least one tile.
+    const TileExtent& extent{bulkSpawnRequest.tileExtent};
+    if ((extent.xLength <= 0) || (extent.yLength <= 0)) {
+        LOG_INFO("Rejected bulk spawn with empty extent.");
+        return false;
+    }
+
+    // The graphic set must exist.
+    if (bulkSpawnRequest.graphicState.graphicSetID
+        >= graphicData.getAllEntityGraphicSets().size()) {
+        LOG_INFO("Rejected bulk spawn with invalid graphic set: %u.",
+                 bulkSpawnRequest.graphicState.graphicSetID);
+        return false;
+    }
+
+    // If we're adding a behavior, its timings must be usable.
+    if (bulkSpawnRequest.addRandomWalkerAI) {
+        for (float time :
+             {bulkSpawnRequest.timeToWalk, bulkSpawnRequest.timeToWait,
+              bulkSpawnRequest.timeTillDirectionChange}) {
+            if (!std::isfinite(time) || (time < 0)) {
+                LOG_INFO("Rejected bulk spawn with invalid behavior timing.");
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+std::size_t BulkSpawnSystem::clampToEntityCap(std::size_t spawnCount) const
+{
+    std::size_t currentEntityCount{world.registry.view<Position>().size()};
+    std::size_t availableCount{0};
+    if (currentEntityCount < SharedConfig::MAX_ENTITIES) {
+        availableCount = SharedConfig::MAX_ENTITIES - currentEntityCount;
+    }
+
+    return std::min(
+        {spawnCount, BulkSpawnRequest::MAX_SPAWN_COUNT, availableCount});
+}
+
+void BulkSpawnSystem::scatterPositions(
+    const BulkSpawnRequest& bulkSpawnRequest, std::size_t spawnCount)
+{
+    const TileExtent& extent{bulkSpawnRequest.tileExtent};
+
+    // Note: We place each entity at the center of a random tile. Overlapping
+    //       entities are fine, their collision will push them apart once
+    //       they start moving.
+    std::uniform_int_distribution<int> xDistribution{
+        extent.x, (extent.x + extent.xLength - 1)};
+    std::uniform_int_distribution<int> yDistribution{
+        extent.y, (extent.y + extent.yLength - 1)};
+    static constexpr float HALF_TILE_WIDTH{SharedConfig::TILE_WORLD_WIDTH
+                                           / 2.f};
+
+    groupPositions.clear();
+    groupPositions.reserve(spawnCount);
+    for (std::size_t i{0}; i < spawnCount; ++i) {
+        TilePosition tilePosition{xDistribution(generator),
+                                  yDistribution(generator), extent.z};
+        Vector3 tileOrigin{tilePosition.getOriginPoint()};
+        groupPositions.push_back({(tileOrigin.x + HALF_TILE_WIDTH),
+                                  (tileOrigin.y + HALF_TILE_WIDTH),
+                                  tileOrigin.z});
+    }
+}
+
+template<typename... ComponentTypes>
+void BulkSpawnSystem::reserveStorage(std::size_t additionalCount)
+{
+    (world.registry.storage<ComponentTypes>().reserve(
+         world.registry.storage<ComponentTypes>().size() + additionalCount),
+     ...);
+}
+
+void BulkSpawnSystem::createGroup(const BulkSpawnRequest& bulkSpawnRequest,
+                                  std::span<const Position> positions)
+{
+    // Reserve space in the storage of every component that we'll be adding,
+    // so the group doesn't cause repeated reallocations.
+    std::size_t spawnCount{positions.size()};
+    reserveStorage<Name, GraphicState, Collision>(spawnCount);
+    if (bulkSpawnRequest.addRandomWalkerAI) {
+        reserveStorage<Input, Movement, MovementModifiers, RandomWalkerAI>(
+            spawnCount);
+    }
+
+    // Create the entities.
+    groupEntities.clear();
+    groupEntities.reserve(spawnCount);
+    for (const Position& position : positions) {
+        groupEntities.push_back(world.createEntity(position));
+    }
+
+    // Add the components to the whole group, one type at a time.
+    // Note: The graphics and movement components go through World's helpers,
+    //       since they also set up collision. Their storage was reserved
+    //       above, so they won't reallocate.
+    world.registry.insert<Name>(groupEntities.begin(), groupEntities.end(),
+                                bulkSpawnRequest.name);
+    for (entt::entity entity : groupEntities) {
+        world.addGraphicsComponents(entity, bulkSpawnRequest.graphicState);
+    }
+
+    if (bulkSpawnRequest.addRandomWalkerAI) {
+        for (entt::entity entity : groupEntities) {
+            world.addMovementComponents(entity);
+        }
+
+        // Note: RandomWalkerAI's copy constructor re-seeds its generator, so
+        //       each entity will still walk in its own random pattern.
+        world.registry.insert<RandomWalkerAI>(
+            groupEntities.begin(), groupEntities.end(),
+            RandomWalkerAI{bulkSpawnRequest.timeToWalk,
+                           bulkSpawnRequest.timeToWait,
+                           bulkSpawnRequest.timeTillDirectionChange});
+    }
+}
+
+} // End namespace Server
+} // End namespace AM
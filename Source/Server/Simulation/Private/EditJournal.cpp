@@ -0,0 +1,583 @@
+#include "EditJournal.h"
+#include "World.h"
+#include "ISimulationExtension.h"
+#include "BuildModeDataSystem.h"
+#include "TileExtent.h"
+#include "Config.h"
+#include "Paths.h"
+#include "Deserialize.h"
+#include "Log.h"
+#include "bitsery/bitsery.h"
+#include "bitsery/adapter/buffer.h"
+#include <filesystem>
+#include <algorithm>
+
+namespace AM
+{
+namespace Server
+{
+
+/**
+ * Writes a journal file header to the given stream.
+ */
+static void writeHeader(std::ofstream& stream)
+{
+    std::vector<Uint8> header{};
+    EditJournalFormat::appendHeader(header);
+    stream.write(reinterpret_cast<const char*>(header.data()), header.size());
+}
+
+/**
+ * A bulk spawned group, as journaled.
+ */
+struct JournaledBulkSpawn {
+    BulkSpawnRequest request{};
+
+    /** If true, the request came from a client. */
+    bool isFromClient{false};
+
+    /** The created entities. */
+    std::vector<Uint32> entities{};
+
+    /** The created entities' positions. Index-matched with entities. */
+    std::vector<Position> positions{};
+};
+
+template<typename S>
+void serialize(S& serializer, JournaledBulkSpawn& bulkSpawn)
+{
+    serializer.object(bulkSpawn.request);
+    serializer.boolValue(bulkSpawn.isFromClient);
+    serializer.container4b(bulkSpawn.entities,
+                           BulkSpawnRequest::MAX_SPAWN_COUNT);
+    serializer.container(bulkSpawn.positions,
+                         BulkSpawnRequest::MAX_SPAWN_COUNT);
+}
+
+/**
+ * Returns true if the given record's payload decodes as the given type.
+ */
+template<typename T>
+static bool decodesAs(const EditJournalFormat::Record& record)
+{
+    T message{};
+    return Deserialize::fromBuffer(record.payload.data(),
+                                   record.payload.size(), message);
+}
+
+/**
+ * Returns true if the given record's payload decodes as the message type
+ * that its record type says it holds.
+ */
+static bool isRecordDecodable(const EditJournalFormat::Record& record)
+{
+    using RecordType = EditJournalFormat::RecordType;
+    switch (record.type) {
+        case RecordType::TileAddLayer:
+            return decodesAs<TileAddLayer>(record);
+        case RecordType::TileRemoveLayer:
+            return decodesAs<TileRemoveLayer>(record);
+        case RecordType::EntityInitRequest:
+            return decodesAs<EntityInitRequest>(record);
+        case RecordType::EntityDeleteRequest:
+            return decodesAs<EntityDeleteRequest>(record);
+        case RecordType::EntityNameChangeRequest:
+            return decodesAs<EntityNameChangeRequest>(record);
+        case RecordType::GraphicStateChangeRequest:
+            return decodesAs<GraphicStateChangeRequest>(record);
+        case RecordType::ItemInitRequest:
+            return decodesAs<ItemInitRequest>(record);
+        case RecordType::ItemChangeRequest:
+            return decodesAs<ItemChangeRequest>(record);
+        case RecordType::EntityTemplate:
+            return decodesAs<EntityTemplates::Data>(record);
+        case RecordType::BulkSpawn:
+            return decodesAs<JournaledBulkSpawn>(record);
+        default:
+            return false;
+    }
+}
+
+EditJournal::EditJournal(World& inWorld,
+                         EventDispatcher& inNetworkEventDispatcher,
+                         const ISimulationExtension& inExtension,
+                         BuildModeDataSystem& inBuildModeDataSystem)
+: world{inWorld}
+, extension{inExtension}
+, buildModeDataSystem{inBuildModeDataSystem}
+, currentJournalPath{Paths::BASE_PATH + "EditJournal.bin"}
+, previousJournalPath{Paths::BASE_PATH + "EditJournal.prev.bin"}
+, unappliedJournalPath{Paths::BASE_PATH + "EditJournal.unapplied.bin"}
+, pendingEntityInits{}
+, createdEntities{}
+, templateRecordData{}
+, captureBuffer{}
+, serializationBuffer{}
+, rotationTimer{}
+, pendingRecordData{}
+, writingRecordData{}
+, rotationIsPending{false}
+, pendingTemplateRecordData{}
+, exitRequested{false}
+, writerMutex{}
+, writerCondition{}
+, journalFile{}
+, writerThread{}
+, tileAddLayerQueue{inNetworkEventDispatcher}
+, tileRemoveLayerQueue{inNetworkEventDispatcher}
+, entityInitRequestQueue{inNetworkEventDispatcher}
+, entityDeleteRequestQueue{inNetworkEventDispatcher}
+, entityNameChangeRequestQueue{inNetworkEventDispatcher}
+, graphicStateChangeRequestQueue{inNetworkEventDispatcher}
+, itemInitRequestQueue{inNetworkEventDispatcher}
+, itemChangeRequestQueue{inNetworkEventDispatcher}
+{
+    // Read both journal generations (oldest first).
+    std::vector<Record> startupRecords{};
+    readJournalFile(previousJournalPath, startupRecords);
+    readJournalFile(currentJournalPath, startupRecords);
+
+    // Restore our templates and move any world edits aside.
+    handleStartupRecords(startupRecords);
+
+    // Start a fresh generation with our templates, since they aren't part
+    // of the engine's save.
+    replaceJournalFile(currentJournalPath, templateRecordData);
+    std::error_code errorCode{};
+    std::filesystem::remove(previousJournalPath, errorCode);
+
+    journalFile.open(currentJournalPath, (std::ios::binary | std::ios::app));
+    if (!(journalFile.is_open())) {
+        LOG_FATAL("Failed to open edit journal: %s",
+                  currentJournalPath.c_str());
+    }
+
+    // Track entity creation, so we can match entities to their init
+    // requests.
+    world.registry.on_construct<Position>()
+        .connect<&EditJournal::onPositionConstructed>(*this);
+
+    // Start the writer thread.
+    writerThread = std::thread(&EditJournal::writeRecords, this);
+}
+
+EditJournal::~EditJournal()
+{
+    // Signal the writer thread to write any pending data and exit.
+    {
+        std::scoped_lock lock{writerMutex};
+        exitRequested = true;
+    }
+    writerCondition.notify_one();
+    writerThread.join();
+}
+
+void EditJournal::processEdits()
+{
+    // Journal any new edits.
+    journalQueuedEdits();
+
+    // Hand any new records to the writer thread.
+    if (!(captureBuffer.empty())) {
+        {
+            std::scoped_lock lock{writerMutex};
+            pendingRecordData.insert(pendingRecordData.end(),
+                                     captureBuffer.begin(),
+                                     captureBuffer.end());
+        }
+        writerCondition.notify_one();
+        captureBuffer.clear();
+    }
+
+    // If a save period has passed since the last rotation, rotate the
+    // journal files.
+    if (rotationTimer.getTime() >= Config::SAVE_PERIOD_S) {
+        {
+            std::scoped_lock lock{writerMutex};
+            rotationIsPending = true;
+            pendingTemplateRecordData = templateRecordData;
+        }
+        writerCondition.notify_one();
+        rotationTimer.reset();
+    }
+}
+
+void EditJournal::resolveCreatedEntities()
+{
+    // Match each pending init to the entity that it created.
+    for (auto it{pendingEntityInits.begin()};
+         it != pendingEntityInits.end();) {
+        const EntityInitRequest& request{it->request};
+        CreatedEntity* match{nullptr};
+        for (CreatedEntity& createdEntity : createdEntities) {
+            const Position& position{createdEntity.position};
+            if (createdEntity.isClaimed
+                || !(world.registry.valid(createdEntity.entity))
+                || (position.x != request.position.x)
+                || (position.y != request.position.y)
+                || (position.z != request.position.z)) {
+                continue;
+            }
+
+            const Name* name{
+                world.registry.try_get<Name>(createdEntity.entity)};
+            if (name && (name->value == request.name.value)) {
+                match = &createdEntity;
+                break;
+            }
+        }
+
+        if (match != nullptr) {
+            match->isClaimed = true;
+            appendRecord(captureBuffer, RecordType::EntityInitRequest,
+                         request, match->entity);
+            it = pendingEntityInits.erase(it);
+        }
+        else if (++(it->ticksWaited) > MAX_INIT_RESOLVE_TICKS) {
+            // The request was never processed, so it must have been rejected.
+            it = pendingEntityInits.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+
+    // Stop tracking any claimed or stale entities.
+    std::erase_if(createdEntities, [](CreatedEntity& createdEntity) {
+        return createdEntity.isClaimed
+               || (++(createdEntity.ticksWaited) > MAX_INIT_RESOLVE_TICKS);
+    });
+}
+
+void EditJournal::recordTemplate(const EntityTemplates::Data& templateData)
+{
+    appendRecord(captureBuffer, RecordType::EntityTemplate, templateData);
+    appendRecord(templateRecordData, RecordType::EntityTemplate,
+                 templateData);
+}
+
+void EditJournal::recordBulkSpawn(const BulkSpawnRequest& bulkSpawnRequest,
+                                  bool isFromClient,
+                                  std::span<const entt::entity> entities)
+{
+    JournaledBulkSpawn bulkSpawn{bulkSpawnRequest, isFromClient};
+    for (entt::entity entity : entities) {
+        bulkSpawn.entities.push_back(static_cast<Uint32>(entity));
+        bulkSpawn.positions.push_back(world.registry.get<Position>(entity));
+    }
+
+    appendRecord(captureBuffer, RecordType::BulkSpawn, bulkSpawn);
+}
+
+void EditJournal::handleStartupRecords(const std::vector<Record>& records)
+{
+    std::vector<Uint8> unappliedRecordData{};
+    std::size_t unappliedCount{0};
+    std::vector<std::vector<Uint8>> restoredTemplates{};
+    for (const Record& record : records) {
+        if (record.type != RecordType::EntityTemplate) {
+            EditJournalFormat::appendRecord(unappliedRecordData, record.type,
+                                            record.createdEntity,
+                                            record.payload);
+            unappliedCount++;
+            continue;
+        }
+
+        // Templates are carried forward into each generation, so skip any
+        // that we've already restored.
+        if (std::ranges::contains(restoredTemplates, record.payload)) {
+            continue;
+        }
+
+        EntityTemplates::Data templateData{};
+        if (Deserialize::fromBuffer(record.payload.data(),
+                                    record.payload.size(), templateData)) {
+            buildModeDataSystem.addTemplate(templateData);
+            EditJournalFormat::appendRecord(templateRecordData, record.type,
+                                            record.createdEntity,
+                                            record.payload);
+            restoredTemplates.push_back(record.payload);
+        }
+    }
+
+    if (unappliedCount == 0) {
+        return;
+    }
+
+    // Move the edits aside, after any that were moved aside on a previous
+    // startup.
+    std::vector<Record> previousRecords{};
+    readJournalFile(unappliedJournalPath, previousRecords);
+    std::vector<Uint8> allRecordData{};
+    for (const Record& record : previousRecords) {
+        EditJournalFormat::appendRecord(allRecordData, record.type,
+                                        record.createdEntity, record.payload);
+    }
+    allRecordData.insert(allRecordData.end(), unappliedRecordData.begin(),
+                         unappliedRecordData.end());
+    replaceJournalFile(unappliedJournalPath, allRecordData);
+
+    LOG_INFO("Found %zu journaled edits that may already be in the saved "
+             "world. They weren't applied, and were moved to: %s",
+             unappliedCount, unappliedJournalPath.c_str());
+}
+
+void EditJournal::journalQueuedEdits()
+{
+    // Note: Each edit is checked with the same hook that the engine will use
+    //       to accept or reject it, so rejected edits aren't journaled.
+    //       The engine hasn't processed this tick's messages yet, so the
+    //       hooks see the same world state that the engine will.
+    TileAddLayer tileAddLayer{};
+    while (tileAddLayerQueue.pop(tileAddLayer)) {
+        const TilePosition& tilePosition{tileAddLayer.tilePosition};
+        if (extension.isTileExtentEditable(
+                tileAddLayer.netID, TileExtent{tilePosition.x, tilePosition.y,
+                                               tilePosition.z, 1, 1, 1})) {
+            appendRecord(captureBuffer, RecordType::TileAddLayer,
+                         tileAddLayer);
+        }
+    }
+
+    TileRemoveLayer tileRemoveLayer{};
+    while (tileRemoveLayerQueue.pop(tileRemoveLayer)) {
+        const TilePosition& tilePosition{tileRemoveLayer.tilePosition};
+        if (extension.isTileExtentEditable(
+                tileRemoveLayer.netID,
+                TileExtent{tilePosition.x, tilePosition.y, tilePosition.z, 1,
+                           1, 1})) {
+            appendRecord(captureBuffer, RecordType::TileRemoveLayer,
+                         tileRemoveLayer);
+        }
+    }
+
+    EntityInitRequest entityInitRequest{};
+    while (entityInitRequestQueue.pop(entityInitRequest)) {
+        if (((entityInitRequest.entity != entt::null)
+                && !(world.registry.valid(entityInitRequest.entity)))
+            || !(extension.isEntityInitRequestValid(entityInitRequest))) {
+            continue;
+        }
+
+        // If this request creates a new entity, wait until we know its ID.
+        if (entityInitRequest.entity == entt::null) {
+            pendingEntityInits.push_back({entityInitRequest, 0});
+        }
+        else {
+            appendRecord(captureBuffer, RecordType::EntityInitRequest,
+                         entityInitRequest);
+        }
+    }
+
+    EntityDeleteRequest entityDeleteRequest{};
+    while (entityDeleteRequestQueue.pop(entityDeleteRequest)) {
+        if (world.registry.valid(entityDeleteRequest.entity)
+            && extension.isEntityDeleteRequestValid(entityDeleteRequest)) {
+            appendRecord(captureBuffer, RecordType::EntityDeleteRequest,
+                         entityDeleteRequest);
+        }
+    }
+
+    EntityNameChangeRequest nameChangeRequest{};
+    while (entityNameChangeRequestQueue.pop(nameChangeRequest)) {
+        if (world.registry.valid(nameChangeRequest.entity)
+            && extension.isEntityNameChangeRequestValid(nameChangeRequest)) {
+            appendRecord(captureBuffer, RecordType::EntityNameChangeRequest,
+                         nameChangeRequest);
+        }
+    }
+
+    GraphicStateChangeRequest graphicStateChangeRequest{};
+    while (graphicStateChangeRequestQueue.pop(graphicStateChangeRequest)) {
+        if (world.registry.valid(graphicStateChangeRequest.entity)
+            && extension.isGraphicStateChangeRequestValid(
+                graphicStateChangeRequest)) {
+            appendRecord(captureBuffer, RecordType::GraphicStateChangeRequest,
+                         graphicStateChangeRequest);
+        }
+    }
+
+    ItemInitRequest itemInitRequest{};
+    while (itemInitRequestQueue.pop(itemInitRequest)) {
+        if (extension.isItemInitRequestValid(itemInitRequest)) {
+            appendRecord(captureBuffer, RecordType::ItemInitRequest,
+                         itemInitRequest);
+        }
+    }
+
+    ItemChangeRequest itemChangeRequest{};
+    while (itemChangeRequestQueue.pop(itemChangeRequest)) {
+        if (extension.isItemChangeRequestValid(itemChangeRequest)) {
+            appendRecord(captureBuffer, RecordType::ItemChangeRequest,
+                         itemChangeRequest);
+        }
+    }
+}
+
+template<typename T>
+void EditJournal::appendRecord(std::vector<Uint8>& buffer, RecordType type,
+                               const T& message, entt::entity createdEntity)
+{
+    using OutputAdapter = bitsery::OutputBufferAdapter<std::vector<Uint8>>;
+    std::size_t payloadSize{bitsery::quickSerialization(
+        OutputAdapter{serializationBuffer}, message)};
+
+    EditJournalFormat::appendRecord(
+        buffer, type, static_cast<Uint32>(createdEntity),
+        std::span<const Uint8>{serializationBuffer.data(), payloadSize});
+}
+
+void EditJournal::onPositionConstructed(entt::registry& registry,
+                                        entt::entity entity)
+{
+    createdEntities.push_back({entity, registry.get<Position>(entity), 0});
+}
+
+void EditJournal::readJournalFile(const std::string& filePath,
+                                  std::vector<Record>& records)
+{
+    std::ifstream file{filePath, (std::ios::binary | std::ios::ate)};
+    if (!(file.is_open())) {
+        return;
+    }
+
+    // Read the whole file. Each record's size is checked against the bytes
+    // that are left in it.
+    std::streamoff fileSize{file.tellg()};
+    if (fileSize < 0) {
+        LOG_INFO("Failed to read edit journal: %s", filePath.c_str());
+        return;
+    }
+    std::vector<Uint8> fileData(static_cast<std::size_t>(fileSize));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(fileData.data()), fileSize);
+    if (file.gcount() != fileSize) {
+        LOG_INFO("Failed to read edit journal: %s", filePath.c_str());
+        return;
+    }
+
+    using ReadResult = EditJournalFormat::ReadResult;
+    std::size_t firstRecordIndex{records.size()};
+    ReadResult result{EditJournalFormat::readRecords(fileData, records)};
+    if (result == ReadResult::InvalidHeader) {
+        LOG_INFO("Skipping invalid edit journal: %s", filePath.c_str());
+        return;
+    }
+    else if (result == ReadResult::Truncated) {
+        // The last record was only partially written.
+        LOG_INFO("Dropping incomplete record at end of %s",
+                 filePath.c_str());
+    }
+    else if (result == ReadResult::Corrupt) {
+        LOG_INFO("Dropping corrupt records at end of %s", filePath.c_str());
+    }
+
+    // Drop everything from the first record that doesn't decode, since we
+    // can't trust the framing after it.
+    for (std::size_t i{firstRecordIndex}; i < records.size(); ++i) {
+        if (!isRecordDecodable(records[i])) {
+            LOG_INFO("Dropping %zu undecodable records at end of %s",
+                     (records.size() - i), filePath.c_str());
+            records.erase((records.begin() + i), records.end());
+            break;
+        }
+    }
+}
+
+void EditJournal::replaceJournalFile(const std::string& filePath,
+                                     const std::vector<Uint8>& recordData)
+{
+    // Write to a temporary file, then swap it in, so we never leave a
+    // partially written generation behind.
+    std::string tempFilePath{filePath + ".tmp"};
+    {
+        std::ofstream file{tempFilePath, (std::ios::binary | std::ios::trunc)};
+        if (!(file.is_open())) {
+            LOG_FATAL("Failed to open edit journal: %s", tempFilePath.c_str());
+        }
+        writeHeader(file);
+        file.write(reinterpret_cast<const char*>(recordData.data()),
+                   recordData.size());
+    }
+
+    std::error_code errorCode{};
+    std::filesystem::rename(tempFilePath, filePath, errorCode);
+    if (errorCode) {
+        LOG_FATAL("Failed to replace edit journal %s: %s", filePath.c_str(),
+                  errorCode.message().c_str());
+    }
+}
+
+void EditJournal::writeRecords()
+{
+    std::vector<Uint8> rotationTemplateData{};
+    while (true) {
+        bool shouldRotate{false};
+        bool shouldExit{false};
+        {
+            std::unique_lock lock{writerMutex};
+            writerCondition.wait(lock, [this] {
+                return !(pendingRecordData.empty()) || rotationIsPending
+                       || exitRequested;
+            });
+
+            std::swap(pendingRecordData, writingRecordData);
+            shouldRotate = rotationIsPending;
+            rotationIsPending = false;
+            if (shouldRotate) {
+                std::swap(pendingTemplateRecordData, rotationTemplateData);
+            }
+            shouldExit = exitRequested;
+        }
+
+        // Write the batch.
+        if (!(writingRecordData.empty())) {
+            journalFile.write(
+                reinterpret_cast<const char*>(writingRecordData.data()),
+                writingRecordData.size());
+            journalFile.flush();
+            writingRecordData.clear();
+        }
+
+        if (shouldRotate) {
+            // Start the new generation with our templates, since they aren't
+            // part of the engine's save.
+            rotateJournalFiles();
+            journalFile.write(
+                reinterpret_cast<const char*>(rotationTemplateData.data()),
+                rotationTemplateData.size());
+            journalFile.flush();
+        }
+
+        if (shouldExit) {
+            return;
+        }
+    }
+}
+
+void EditJournal::rotateJournalFiles()
+{
+    journalFile.close();
+
+    // Drop the previous generation. The engine has saved at least once since
+    // its last record was written, though not necessarily since this
+    // generation's first record (see the class comment).
+    std::error_code errorCode{};
+    std::filesystem::remove(previousJournalPath, errorCode);
+    std::filesystem::rename(currentJournalPath, previousJournalPath,
+                            errorCode);
+    if (errorCode) {
+        LOG_INFO("Failed to rotate edit journal: %s",
+                 errorCode.message().c_str());
+    }
+
+    journalFile.open(currentJournalPath, (std::ios::binary | std::ios::trunc));
+    if (!(journalFile.is_open())) {
+        LOG_FATAL("Failed to open edit journal: %s",
+                  currentJournalPath.c_str());
+    }
+    writeHeader(journalFile);
+}
+
+} // End namespace Server
+} // End namespace AM
@@ -0,0 +1,261 @@
+#include "IncrementalSaveSystem.h"
+#include "World.h"
+#include "Config.h"
+#include "Paths.h"
+#include "Log.h"
+#include "SQLiteCpp/Transaction.h"
+#include "bitsery/bitsery.h"
+#include "bitsery/adapter/buffer.h"
+#include "boost/mp11/algorithm.hpp"
+#include <type_traits>
+
+namespace AM
+{
+namespace Server
+{
+
+/** How long a save transaction will wait for the engine's connection to
+    release the database, in milliseconds. */
+static constexpr int DATABASE_BUSY_TIMEOUT_MS{5000};
+
+IncrementalSaveSystem::IncrementalSaveSystem(World& inWorld)
+: world{inWorld}
+, database{(Paths::BASE_PATH + "Database.db3"), SQLite::OPEN_READWRITE,
+           DATABASE_BUSY_TIMEOUT_MS}
+, updateComponentsQuery{database, "UPDATE entities SET "
+                                  "serializedProjectComponents = ? WHERE "
+                                  "id = ?"}
+, dirtyEntities{}
+, componentBuffer{}
+, serializationBuffer{}
+, saveTimer{}
+, captureSnapshot{}
+, pendingSnapshot{}
+, writingSnapshot{}
+, snapshotIsPending{false}
+, failedEntityIDs{}
+, snapshotMutex{}
+, snapshotCondition{}
+, exitRequested{false}
+, saveThread{}
+{
+    // Observe all of our persisted component types.
+    boost::mp11::mp_for_each<boost::mp11::mp_transform<
+        boost::mp11::mp_identity, ProjectPersistedComponentTypes>>(
+        [&](auto I) {
+            using T = typename decltype(I)::type;
+            world.registry.on_construct<T>()
+                .template connect<&IncrementalSaveSystem::onComponentChanged>(
+                    *this);
+            world.registry.on_update<T>()
+                .template connect<&IncrementalSaveSystem::onComponentChanged>(
+                    *this);
+            world.registry.on_destroy<T>()
+                .template connect<&IncrementalSaveSystem::onComponentChanged>(
+                    *this);
+        });
+
+    // Start the save thread.
+    saveThread = std::thread(&IncrementalSaveSystem::writeSnapshots, this);
+}
+
+IncrementalSaveSystem::~IncrementalSaveSystem()
+{
+    // Signal the save thread to write any pending snapshot and exit.
+    {
+        std::scoped_lock lock{snapshotMutex};
+        exitRequested = true;
+    }
+    snapshotCondition.notify_one();
+    saveThread.join();
+
+    // Write any entities that changed since the last capture (or failed to
+    // save), so they aren't lost.
+    // Note: The save thread has exited, so it's safe to use the database
+    //       from this thread.
+    requeueFailedEntities();
+    if (!(dirtyEntities.empty())) {
+        captureDirtyEntities();
+        writeSnapshot(captureSnapshot);
+    }
+}
+
+void IncrementalSaveSystem::saveDirtyEntities()
+{
+    // If it isn't time to save, return early.
+    if (saveTimer.getTime() < Config::INCREMENTAL_SAVE_PERIOD_S) {
+        return;
+    }
+
+    // If the save thread hasn't picked up the last snapshot yet, wait until
+    // it does. The dirty entities will be included in the next capture.
+    {
+        std::scoped_lock lock{snapshotMutex};
+        if (snapshotIsPending) {
+            return;
+        }
+    }
+
+    // If nothing has changed (and nothing needs to be retried), return early.
+    requeueFailedEntities();
+    if (dirtyEntities.empty()) {
+        return;
+    }
+
+    // Capture the dirty entities' data.
+    Timer captureTimer{};
+    captureDirtyEntities();
+    double captureTime{captureTimer.getTime()};
+    if (captureTime > CAPTURE_BUDGET_S) {
+        LOG_INFO("Incremental save capture took %.3fms (budget: %.3fms).",
+                 (captureTime * 1000.0), (CAPTURE_BUDGET_S * 1000.0));
+    }
+
+    // Hand the snapshot to the save thread.
+    {
+        std::scoped_lock lock{snapshotMutex};
+        std::swap(captureSnapshot, pendingSnapshot);
+        snapshotIsPending = true;
+    }
+    snapshotCondition.notify_one();
+
+    saveTimer.reset();
+}
+
+void IncrementalSaveSystem::onComponentChanged(entt::registry&,
+                                               entt::entity entity)
+{
+    dirtyEntities.insert(entity);
+}
+
+void IncrementalSaveSystem::requeueFailedEntities()
+{
+    std::scoped_lock lock{snapshotMutex};
+    for (Uint32 entityID : failedEntityIDs) {
+        dirtyEntities.insert(static_cast<entt::entity>(entityID));
+    }
+    failedEntityIDs.clear();
+}
+
+void IncrementalSaveSystem::captureDirtyEntities()
+{
+    captureSnapshot.clear();
+    for (entt::entity entity : dirtyEntities) {
+        // If the entity was destroyed, skip it. The engine handles
+        // deleting its row.
+        if (!(world.registry.valid(entity))) {
+            continue;
+        }
+
+        std::size_t serializedSize{serializeComponents(entity)};
+        captureSnapshot.entityIDs.push_back(static_cast<Uint32>(entity));
+        captureSnapshot.dataOffsets.push_back(
+            captureSnapshot.componentData.size());
+        captureSnapshot.componentData.insert(
+            captureSnapshot.componentData.end(), serializationBuffer.begin(),
+            (serializationBuffer.begin() + serializedSize));
+    }
+
+    dirtyEntities.clear();
+}
+
+std::size_t IncrementalSaveSystem::serializeComponents(entt::entity entity)
+{
+    // Collect the entity's persisted components.
+    componentBuffer.clear();
+    boost::mp11::mp_for_each<boost::mp11::mp_transform<
+        boost::mp11::mp_identity, ProjectPersistedComponentTypes>>(
+        [&](auto I) {
+            using T = typename decltype(I)::type;
+            // Note: Empty types (tags) aren't stored, so we can't get them.
+            if constexpr (std::is_empty_v<T>) {
+                if (world.registry.all_of<T>(entity)) {
+                    componentBuffer.emplace_back(T{});
+                }
+            }
+            else if (T* component{world.registry.try_get<T>(entity)}) {
+                componentBuffer.emplace_back(*component);
+            }
+        });
+
+    // Serialize them, using the same format as the engine's full save.
+    using OutputAdapter = bitsery::OutputBufferAdapter<std::vector<Uint8>>;
+    return bitsery::quickSerialization(OutputAdapter{serializationBuffer},
+                                       componentBuffer);
+}
+
+void IncrementalSaveSystem::writeSnapshots()
+{
+    while (true) {
+        // Wait for a snapshot (or an exit request).
+        {
+            std::unique_lock lock{snapshotMutex};
+            snapshotCondition.wait(lock, [this] {
+                return snapshotIsPending || exitRequested;
+            });
+
+            // Note: We write any pending snapshot before exiting, so changes
+            //       made right before shutdown aren't lost.
+            if (!snapshotIsPending) {
+                return;
+            }
+
+            std::swap(pendingSnapshot, writingSnapshot);
+            snapshotIsPending = false;
+        }
+
+        writeSnapshot(writingSnapshot);
+    }
+}
+
+void IncrementalSaveSystem::writeSnapshot(const Snapshot& snapshot)
+{
+    Timer durationTimer{};
+    std::size_t savedEntityCount{0};
+    std::size_t bytesWritten{0};
+    try {
+        SQLite::Transaction transaction{database};
+
+        for (std::size_t i{0}; i < snapshot.entityIDs.size(); ++i) {
+            std::size_t dataStart{snapshot.dataOffsets[i]};
+            std::size_t dataEnd{(i + 1) < snapshot.dataOffsets.size()
+                                    ? snapshot.dataOffsets[i + 1]
+                                    : snapshot.componentData.size()};
+            std::size_t dataSize{dataEnd - dataStart};
+
+            updateComponentsQuery.bind(1, &(snapshot.componentData[dataStart]),
+                                       static_cast<int>(dataSize));
+            updateComponentsQuery.bind(2, snapshot.entityIDs[i]);
+
+            // Note: If the engine hasn't saved this entity yet, there's no
+            //       row to update. Its next full save will cover it.
+            if (updateComponentsQuery.exec() > 0) {
+                savedEntityCount++;
+                bytesWritten += dataSize;
+            }
+            updateComponentsQuery.reset();
+        }
+
+        transaction.commit();
+    } catch (SQLite::Exception& e) {
+        LOG_ERROR("Incremental save failed, will retry %zu entities: %s",
+                  snapshot.entityIDs.size(), e.what());
+        updateComponentsQuery.reset();
+
+        // The transaction was rolled back. Hand the entities back to the sim
+        // thread, so they're captured again (with their latest data) on the
+        // next save.
+        std::scoped_lock lock{snapshotMutex};
+        failedEntityIDs.insert(failedEntityIDs.end(),
+                               snapshot.entityIDs.begin(),
+                               snapshot.entityIDs.end());
+        return;
+    }
+
+    LOG_INFO("Incremental save: %zu entities, %zu bytes, %.3fms.",
+             savedEntityCount, bytesWritten,
+             (durationTimer.getTime() * 1000.0));
+}
+
+} // End namespace Server
+} // End namespace AM
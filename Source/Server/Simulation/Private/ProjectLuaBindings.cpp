@@ -6,8 +6,11 @@
 #include "DialogueChoiceConditionLua.h"
 #include "GraphicData.h"
 #include "World.h"
+#include "BulkSpawnSystem.h"
 #include "RandomWalkerAI.h"
 #include "PreviousPosition.h"
+#include "TilePosition.h"
+#include <algorithm>
 
 namespace AM
 {
@@ -19,7 +22,8 @@ ProjectLuaBindings::ProjectLuaBindings(
     EntityItemHandlerLua& inEntityItemHandlerLua, ItemInitLua& inItemInitLua,
     DialogueLua& inDialogueLua,
     DialogueChoiceConditionLua& inDialogueChoiceConditionLua,
-    const GraphicData& inGraphicData, World& inWorld)
+    const GraphicData& inGraphicData, World& inWorld,
+    BulkSpawnSystem& inBulkSpawnSystem)
 : entityInitLua{inEntityInitLua}
 , entityItemHandlerLua{inEntityItemHandlerLua}
 , itemInitLua{inItemInitLua}
@@ -27,6 +31,7 @@ ProjectLuaBindings::ProjectLuaBindings(
 , dialogueChoiceConditionLua{inDialogueChoiceConditionLua}
 , graphicData{inGraphicData}
 , world{inWorld}
+, bulkSpawnSystem{inBulkSpawnSystem}
 {
 }
 
@@ -36,6 +41,11 @@ void ProjectLuaBindings::addBindings()
     entityInitLua.luaState.set_function(
         "addRandomWalkerAIBehavior",
         &ProjectLuaBindings::addRandomWalkerAIBehavior, this);
+    entityInitLua.luaState.set_function(
+        "bulkSpawnEntities", &ProjectLuaBindings::bulkSpawnEntities, this);
+    entityInitLua.luaState.set_function(
+        "bulkSpawnRandomWalkers", &ProjectLuaBindings::bulkSpawnRandomWalkers,
+        this);
 
     // Entity item handler
 
@@ -56,6 +66,60 @@ void ProjectLuaBindings::addRandomWalkerAIBehavior(
                                            timeTillDirectionChange);
 }
 
+void ProjectLuaBindings::bulkSpawnEntities(const std::string& name,
+                                           const std::string& graphicSetID,
+                                           int radius, int count)
+{
+    bulkSpawnSystem.queueSpawn(
+        buildSpawnRequest(name, graphicSetID, radius, count));
+}
+
+void ProjectLuaBindings::bulkSpawnRandomWalkers(
+    const std::string& name, const std::string& graphicSetID, int radius,
+    int count, double timeToWalk, double timeToWait,
+    double timeTillDirectionChange)
+{
+    BulkSpawnRequest bulkSpawnRequest{
+        buildSpawnRequest(name, graphicSetID, radius, count)};
+    bulkSpawnRequest.addRandomWalkerAI = true;
+    bulkSpawnRequest.timeToWalk = static_cast<float>(timeToWalk);
+    bulkSpawnRequest.timeToWait = static_cast<float>(timeToWait);
+    bulkSpawnRequest.timeTillDirectionChange
+        = static_cast<float>(timeTillDirectionChange);
+
+    bulkSpawnSystem.queueSpawn(bulkSpawnRequest);
+}
+
+BulkSpawnRequest ProjectLuaBindings::buildSpawnRequest(
+    const std::string& name, const std::string& graphicSetID, int radius,
+    int count)
+{
+    // Center the spawn extent on this entity.
+    // Note: The group is created the next time BulkSpawnSystem runs, so it
+    //       won't interfere with this entity's initialization.
+    const Position& position{
+        world.registry.get<Position>(entityInitLua.selfEntity)};
+    TilePosition tilePosition(position);
+    radius = std::clamp(radius, 0, MAX_SPAWN_RADIUS);
+
+    BulkSpawnRequest bulkSpawnRequest{};
+    bulkSpawnRequest.name = Name{name};
+    bulkSpawnRequest.graphicState.graphicSetID
+        = graphicData.getEntityGraphicSet(graphicSetID).numericID;
+    int diameter{(radius * 2) + 1};
+    bulkSpawnRequest.tileExtent
+        = TileExtent{(tilePosition.x - radius), (tilePosition.y - radius),
+                     tilePosition.z, diameter, diameter, 1};
+
+    // Stay within the map, like build mode does.
+    bulkSpawnRequest.tileExtent.intersectWith(world.tileMap.getTileExtent());
+    bulkSpawnRequest.spawnCount = static_cast<Uint16>(
+        std::clamp(count, 0,
+                   static_cast<int>(BulkSpawnRequest::MAX_SPAWN_COUNT)));
+
+    return bulkSpawnRequest;
+}
+
 void ProjectLuaBindings::addTestInteraction()
 {
     // Add the interaction to this item.
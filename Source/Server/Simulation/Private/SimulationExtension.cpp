@@ -20,20 +20,41 @@ namespace Server
 
 SimulationExtension::SimulationExtension(const SimulationExDependencies& deps)
 : world{deps.simulation.getWorld()}
+, bulkSpawnSystem{world, deps.network.getEventDispatcher(), deps.graphicData,
+                  *this}
 , projectLuaBindings{deps.simulation.getEntityInitLua(),
                      deps.simulation.getEntityItemHandlerLua(),
                      deps.simulation.getItemInitLua(),
                      deps.simulation.getDialogueLua(),
                      deps.simulation.getDialogueChoiceConditionLua(),
                      deps.graphicData,
-                     world}
+                     world,
+                     bulkSpawnSystem}
 , buildModeDataSystem{world, deps.network.getEventDispatcher(), deps.network,
                       deps.graphicData}
+, tileExtentEditSystem{deps.network.getEventDispatcher(), *this}
+, editJournal{world, deps.network.getEventDispatcher(), *this,
+              buildModeDataSystem}
 , teleportSystem{deps.simulation.getWorld()}
+, incrementalSaveSystem{world}
 {
     // Add our Lua bindings.
     projectLuaBindings.addBindings();
 
+    // Journal any templates that clients save.
+    buildModeDataSystem.setOnTemplateAdded(
+        [this](const EntityTemplates::Data& templateData) {
+            editJournal.recordTemplate(templateData);
+        });
+
+    // Journal any groups that are bulk spawned.
+    bulkSpawnSystem.setOnGroupSpawned(
+        [this](const BulkSpawnRequest& bulkSpawnRequest, bool isFromClient,
+               std::span<const entt::entity> entities) {
+            editJournal.recordBulkSpawn(bulkSpawnRequest, isFromClient,
+                                        entities);
+        });
+
     // Add an example item interaction handler.
     world.castHelper.setOnItemInteractionCompleted(
         ItemInteractionType::Test, [&](const CastInfo& castInfo) {
@@ -53,13 +74,25 @@ SimulationExtension::SimulationExtension(const SimulationExDependencies& deps)
                                          });
 }
 
-void SimulationExtension::beforeAll() {}
+void SimulationExtension::beforeAll()
+{
+    // Expand any extent edits into tile layer requests.
+    // Note: This must happen before the journal runs, so it journals the
+    //       expanded requests.
+    tileExtentEditSystem.processExtentEdits();
+
+    // Journal any new edits.
+    editJournal.processEdits();
+}
 
 void SimulationExtension::afterMapAndConnectionUpdates()
 {
     // Respond to any build mode data messages that aren't handled
     // by the engine.
     buildModeDataSystem.processMessages();
+
+    // Create any requested groups of entities.
+    bulkSpawnSystem.spawnEntities();
 }
 
 void SimulationExtension::afterSimUpdate()
@@ -70,7 +103,14 @@ void SimulationExtension::afterSimUpdate()
 
 void SimulationExtension::afterClientSync() {}
 
-void SimulationExtension::afterAll() {}
+void SimulationExtension::afterAll()
+{
+    // Match any newly created entities to their journaled init requests.
+    editJournal.resolveCreatedEntities();
+
+    // Save any entities whose persisted components have changed.
+    incrementalSaveSystem.saveDirtyEntities();
+}
 
 bool SimulationExtension::handleOSEvent([[maybe_unused]] SDL_Event& event)
 {
@@ -192,6 +232,11 @@ bool SimulationExtension::isItemChangeRequestValid(
     const ItemChangeRequest& itemChangeRequest) const
 {
     if (SharedConfig::RESTRICT_WORLD_CHANGES) {
+        // Protected items can never be changed.
+        if (std::ranges::contains(PROTECTED_ITEMS, itemChangeRequest.itemID)) {
+            return false;
+        }
+
         // Find the entity ID of the client that sent this request.
         auto it{world.netIDMap.find(itemChangeRequest.netID)};
         if (it == world.netIDMap.end()) {
@@ -200,12 +245,9 @@ bool SimulationExtension::isItemChangeRequestValid(
         }
         entt::entity clientEntity{it->second};
 
-        // Only return true if the entity is within a build area and the item
-        // isn't one of our protected items.
-        bool isEditable{!(
-            std::ranges::contains(PROTECTED_ITEMS, itemChangeRequest.itemID))};
+        // Only return true if the entity is within a build area.
         const auto& position{world.registry.get<Position>(clientEntity)};
-        return isInBuildArea(position) && isEditable;
+        return isInBuildArea(position);
     }
     else {
         // No restrictions, always return true;
@@ -0,0 +1,109 @@
+#include "TileExtentEditSystem.h"
+#include "ISimulationExtension.h"
+#include "TileAddLayer.h"
+#include "TileRemoveLayer.h"
+#include "Wall.h"
+#include "Log.h"
+
+namespace AM
+{
+namespace Server
+{
+TileExtentEditSystem::TileExtentEditSystem(
+    EventDispatcher& inNetworkEventDispatcher,
+    const ISimulationExtension& inExtension)
+: networkEventDispatcher{inNetworkEventDispatcher}
+, extension{inExtension}
+, tileExtentEditQueue{inNetworkEventDispatcher}
+{
+}
+
+void TileExtentEditSystem::processExtentEdits()
+{
+    TileExtentEdit tileExtentEdit{};
+    while (tileExtentEditQueue.pop(tileExtentEdit)) {
+        if (isEditValid(tileExtentEdit)) {
+            expandEdit(tileExtentEdit);
+        }
+    }
+}
+
+bool TileExtentEditSystem::isEditValid(
+    const TileExtentEdit& tileExtentEdit) const
+{
+    // The operation must be one that we know of.
+    if ((tileExtentEdit.operation != TileExtentEdit::Operation::AddLayer)
+        && (tileExtentEdit.operation
+            != TileExtentEdit::Operation::RemoveLayer)) {
+        LOG_INFO("Rejected extent edit with invalid operation.");
+        return false;
+    }
+
+    // The extent must be a single level, and within our size limit.
+    const TileExtent& extent{tileExtentEdit.tileExtent};
+    if ((extent.xLength < 1)
+        || (extent.xLength > TileExtentEdit::MAX_EXTENT_LENGTH)
+        || (extent.yLength < 1)
+        || (extent.yLength > TileExtentEdit::MAX_EXTENT_LENGTH)
+        || (extent.zLength != 1)) {
+        LOG_INFO("Rejected extent edit with invalid extent.");
+        return false;
+    }
+
+    // Only terrain, floors, and walls can be edited by extent.
+    switch (tileExtentEdit.layerType) {
+        case TileLayer::Type::Terrain:
+        case TileLayer::Type::Floor: {
+            break;
+        }
+        case TileLayer::Type::Wall: {
+            // Walls must be a straight line of North or West walls. Gap
+            // fills are handled by the tile map.
+            Wall::Type wallType{tileExtentEdit.graphicValue};
+            if (!(((wallType == Wall::Type::North) && (extent.yLength == 1))
+                  || ((wallType == Wall::Type::West)
+                      && (extent.xLength == 1)))) {
+                LOG_INFO("Rejected extent edit with invalid walls.");
+                return false;
+            }
+            break;
+        }
+        default: {
+            LOG_INFO("Rejected extent edit with invalid layer type.");
+            return false;
+        }
+    }
+
+    // Check that the whole extent is editable by this client.
+    return extension.isTileExtentEditable(tileExtentEdit.netID, extent);
+}
+
+void TileExtentEditSystem::expandEdit(const TileExtentEdit& tileExtentEdit)
+{
+    const TileExtent& extent{tileExtentEdit.tileExtent};
+    for (int y{extent.y}; y < (extent.y + extent.yLength); ++y) {
+        for (int x{extent.x}; x < (extent.x + extent.xLength); ++x) {
+            TilePosition tilePosition{x, y, extent.z};
+            if (tileExtentEdit.operation
+                == TileExtentEdit::Operation::AddLayer) {
+                TileAddLayer tileAddLayer{
+                    tilePosition, tileExtentEdit.tileOffset,
+                    tileExtentEdit.layerType, tileExtentEdit.graphicSetID,
+                    tileExtentEdit.graphicValue};
+                tileAddLayer.netID = tileExtentEdit.netID;
+                networkEventDispatcher.push<TileAddLayer>(tileAddLayer);
+            }
+            else {
+                TileRemoveLayer tileRemoveLayer{
+                    tilePosition, tileExtentEdit.tileOffset,
+                    tileExtentEdit.layerType, tileExtentEdit.graphicSetID,
+                    tileExtentEdit.graphicValue};
+                tileRemoveLayer.netID = tileExtentEdit.netID;
+                networkEventDispatcher.push<TileRemoveLayer>(tileRemoveLayer);
+            }
+        }
+    }
+}
+
+} // End namespace Server
+} // End namespace AM
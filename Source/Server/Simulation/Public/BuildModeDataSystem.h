@@ -4,6 +4,7 @@
 #include "EntityTemplatesRequest.h"
 #include "AddEntityTemplate.h"
 #include "QueuedEvents.h"
+#include <functional>
 
 namespace AM
 {
@@ -31,6 +32,21 @@ public:
      */
     void processMessages();
 
+    /**
+     * Adds the given template to the list.
+     *
+     * Note: This doesn't call onTemplateAdded, since it's used for restoring
+     *       templates that were already added.
+     */
+    void addTemplate(const EntityTemplates::Data& templateData);
+
+    /**
+     * @param inOnTemplateAdded A callback for when a client adds a new
+     *                          template.
+     */
+    void setOnTemplateAdded(
+        std::function<void(const EntityTemplates::Data&)> inOnTemplateAdded);
+
 private:
     /** Used to add/remove entities. */
     World& world;
@@ -46,6 +62,8 @@ private:
 
     EventQueue<EntityTemplatesRequest> entityTemplatesRequestQueue;
     EventQueue<AddEntityTemplate> addEntityTemplateQueue;
+
+    std::function<void(const EntityTemplates::Data&)> onTemplateAdded;
 };
 
 } // End namespace Server
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "BulkSpawnRequest.h"
+#include "Position.h"
+#include "QueuedEvents.h"
+#include "entt/fwd.hpp"
+#include <vector>
+#include <span>
+#include <random>
+#include <functional>
+
+namespace AM
+{
+namespace Server
+{
+
+class World;
+class GraphicData;
+class ISimulationExtension;
+
+/**
+ * Creates groups of entities in a single pass.
+ *
+ * Spawning entities one EntityInitRequest at a time means the components get
+ * added one entity at a time, spread across however many ticks the requests
+ * arrive in. This system instead reserves component storage up front, adds
+ * each component type to the whole group at once, and creates every entity
+ * in the same tick, so clients receive the whole group in one update.
+ *
+ * Requests come from clients (build mode) or from Lua (see
+ * ProjectLuaBindings).
+ */
+class BulkSpawnSystem
+{
+public:
+    BulkSpawnSystem(World& inWorld, EventDispatcher& inNetworkEventDispatcher,
+                    const GraphicData& inGraphicData,
+                    const ISimulationExtension& inExtension);
+
+    /**
+     * Queues a request to be processed during the next spawnEntities().
+     *
+     * Note: Queued requests skip the build area check that client requests
+     *       go through, since they come from trusted scripts.
+     */
+    void queueSpawn(const BulkSpawnRequest& bulkSpawnRequest);
+
+    /**
+     * Validates any waiting client requests, then creates the entities for
+     * all waiting requests.
+     */
+    void spawnEntities();
+
+    /**
+     * @param inOnGroupSpawned A callback for when a group is spawned.
+     *                         Given the request, whether it came from a
+     *                         client, and the created entities.
+     */
+    void setOnGroupSpawned(
+        std::function<void(const BulkSpawnRequest&, bool,
+                           std::span<const entt::entity>)>
+            inOnGroupSpawned);
+
+private:
+    /**
+     * A request that's ready to be processed.
+     */
+    struct PendingRequest {
+        BulkSpawnRequest request{};
+
+        /** If true, this request came from a client. If false, it came
+            from Lua. */
+        bool isFromClient{false};
+    };
+
+    /**
+     * Returns true if the given request's graphic set and behavior timings
+     * are valid, else false.
+     *
+     * Note: Applies to both client and Lua requests, since a bad value from
+     *       either would end up in a component.
+     */
+    bool isRequestValid(const BulkSpawnRequest& bulkSpawnRequest) const;
+
+    /**
+     * Returns the number of entities that can be created before we hit the
+     * entity cap, up to the given count.
+     */
+    std::size_t clampToEntityCap(std::size_t spawnCount) const;
+
+    /**
+     * Fills groupPositions with the given number of positions, scattered
+     * within the given request's extent.
+     */
+    void scatterPositions(const BulkSpawnRequest& bulkSpawnRequest,
+                          std::size_t spawnCount);
+
+    /**
+     * Creates an entity at each of the given positions, with the components
+     * described by the given request. Fills groupEntities with the created
+     * entities.
+     */
+    void createGroup(const BulkSpawnRequest& bulkSpawnRequest,
+                     std::span<const Position> positions);
+
+    /**
+     * Reserves room for the given number of additional components in each
+     * given component type's storage.
+     */
+    template<typename... ComponentTypes>
+    void reserveStorage(std::size_t additionalCount);
+
+    /** Used to create entities and add components. */
+    World& world;
+
+    /** Used to validate graphic set IDs. */
+    const GraphicData& graphicData;
+
+    /** Used to validate client requests. */
+    const ISimulationExtension& extension;
+
+    /** Requests that are ready to be processed. */
+    std::vector<PendingRequest> pendingRequests;
+
+    /** The positions of the entities in the current group.
+        Kept as a member to avoid reallocating. */
+    std::vector<Position> groupPositions;
+
+    /** The entities that are being created in the current group.
+        Kept as a member to avoid reallocating. */
+    std::vector<entt::entity> groupEntities;
+
+    std::random_device randomDevice;
+    std::mt19937 generator;
+
+    EventQueue<BulkSpawnRequest> bulkSpawnRequestQueue;
+
+    std::function<void(const BulkSpawnRequest&, bool,
+                       std::span<const entt::entity>)>
+        onGroupSpawned;
+};
+
+} // End namespace Server
+} // End namespace AM
@@ -0,0 +1,270 @@
+#pragma once
+
+#include "TileAddLayer.h"
+#include "TileRemoveLayer.h"
+#include "EntityInitRequest.h"
+#include "EntityDeleteRequest.h"
+#include "EntityNameChangeRequest.h"
+#include "GraphicStateChangeRequest.h"
+#include "ItemInitRequest.h"
+#include "ItemChangeRequest.h"
+#include "EntityTemplates.h"
+#include "BulkSpawnRequest.h"
+#include "EditJournalFormat.h"
+#include "Position.h"
+#include "QueuedEvents.h"
+#include "Timer.h"
+#include "entt/fwd.hpp"
+#include "entt/entity/entity.hpp"
+#include <SDL_stdinc.h>
+#include <string>
+#include <vector>
+#include <span>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace AM
+{
+namespace Server
+{
+
+class World;
+class ISimulationExtension;
+class BuildModeDataSystem;
+
+/**
+ * An append-only journal of the world edits that clients make.
+ *
+ * Edits are captured from the network event dispatcher, encoded into
+ * records (see EditJournalFormat.h), and written to disk in batches by a
+ * background thread.
+ *
+ * Validation: An edit is only journaled if it passes the same
+ * ISimulationExtension hook that the engine checks before applying it. We
+ * run in the same tick, before the engine, so the hooks see the same world
+ * state.
+ *
+ * Bulk spawns don't go through the dispatcher, so BulkSpawnSystem reports
+ * each spawned group to us, along with its entities' positions.
+ *
+ * Compaction: The engine doesn't tell us when it saves, but it does save
+ * once every Config::SAVE_PERIOD_S. We rotate the journal on the same
+ * period and keep one previous generation.
+ *
+ * Replay: Journaled world edits are NOT applied on startup. The rotation
+ * period isn't synced to the engine's save, so a generation can hold edits
+ * that are already in the save, and some records (item inits, object tile
+ * layers, anything keyed by an entt::entity) aren't safe to apply twice.
+ * Until the engine can tell us which records came after its last save,
+ * any edits that are found on startup are moved to an "unapplied" file for
+ * manual recovery. Templates aren't part of the engine's save, so they're
+ * still restored.
+ */
+class EditJournal
+{
+public:
+    EditJournal(World& inWorld, EventDispatcher& inNetworkEventDispatcher,
+                const ISimulationExtension& inExtension,
+                BuildModeDataSystem& inBuildModeDataSystem);
+
+    ~EditJournal();
+
+    /**
+     * Journals any edits that have been received.
+     *
+     * Must be called before the engine processes the tick's messages.
+     */
+    void processEdits();
+
+    /**
+     * Matches any entities that were created this tick to the init requests
+     * that created them.
+     *
+     * Must be called after the engine processes the tick's messages.
+     */
+    void resolveCreatedEntities();
+
+    /**
+     * Journals the given entity template.
+     */
+    void recordTemplate(const EntityTemplates::Data& templateData);
+
+    /**
+     * Journals the given bulk spawned group.
+     *
+     * @param isFromClient If true, the request came from a client.
+     * @param entities The entities that were created.
+     */
+    void recordBulkSpawn(const BulkSpawnRequest& bulkSpawnRequest,
+                         bool isFromClient,
+                         std::span<const entt::entity> entities);
+
+private:
+    using RecordType = EditJournalFormat::RecordType;
+    using Record = EditJournalFormat::Record;
+
+    /** How many ticks we'll wait for an entity init request to be processed
+        before assuming that it was rejected. */
+    static constexpr Uint32 MAX_INIT_RESOLVE_TICKS{30};
+
+    /**
+     * An entity init request that's waiting for its entity to be created.
+     */
+    struct PendingEntityInit {
+        EntityInitRequest request{};
+
+        Uint32 ticksWaited{0};
+    };
+
+    /**
+     * An entity that was recently created.
+     */
+    struct CreatedEntity {
+        entt::entity entity{entt::null};
+
+        /** The entity's position when it was created. */
+        Position position{};
+
+        Uint32 ticksWaited{0};
+
+        bool isClaimed{false};
+    };
+
+    /**
+     * Restores the templates from the given startup records, and moves any
+     * world edits into the unapplied file.
+     */
+    void handleStartupRecords(const std::vector<Record>& records);
+
+    /**
+     * Journals any edits that are waiting in our queues, if they're valid.
+     */
+    void journalQueuedEdits();
+
+    /**
+     * Serializes the given message into a record and appends it to the given
+     * buffer.
+     */
+    template<typename T>
+    void appendRecord(std::vector<Uint8>& buffer, RecordType type,
+                      const T& message,
+                      entt::entity createdEntity = entt::null);
+
+    /**
+     * Tracks the newly constructed entity, so we can match it to an init
+     * request.
+     */
+    void onPositionConstructed(entt::registry& registry, entt::entity entity);
+
+    /**
+     * Reads all of the records from the given file, appending them to the
+     * given vector.
+     * Stops at the first incomplete or undecodable record, in case we
+     * crashed mid-write or the file is corrupt.
+     */
+    void readJournalFile(const std::string& filePath,
+                         std::vector<Record>& records);
+
+    /**
+     * Writes the given records to the given path, replacing any existing
+     * file.
+     */
+    void replaceJournalFile(const std::string& filePath,
+                            const std::vector<Uint8>& recordData);
+
+    /**
+     * Thread function. Waits for record data and writes it to the current
+     * journal file.
+     */
+    void writeRecords();
+
+    /**
+     * Moves the current journal file to the previous generation and starts
+     * a new one.
+     */
+    void rotateJournalFiles();
+
+    /** Used to check entity state and track entity creation. */
+    World& world;
+
+    /** Used to validate edits before they're journaled. */
+    const ISimulationExtension& extension;
+
+    /** Used to restore templates. */
+    BuildModeDataSystem& buildModeDataSystem;
+
+    /** The journal file paths. */
+    std::string currentJournalPath;
+    std::string previousJournalPath;
+
+    /** The file that unapplied edits are moved to on startup. */
+    std::string unappliedJournalPath;
+
+    //-------------------------------------------------------------------------
+    // Journaling state
+    //-------------------------------------------------------------------------
+    /** Entity init requests that are waiting to be matched to an entity. */
+    std::vector<PendingEntityInit> pendingEntityInits;
+
+    /** Entities that were recently created. */
+    std::vector<CreatedEntity> createdEntities;
+
+    /** All template records. Templates aren't part of the engine's save, so
+        these are carried forward into each new journal generation. */
+    std::vector<Uint8> templateRecordData;
+
+    /** Record data that's waiting to be handed to the writer thread. */
+    std::vector<Uint8> captureBuffer;
+
+    /** Used for serializing messages. */
+    std::vector<Uint8> serializationBuffer;
+
+    /** Tracks when we should rotate the journal files. */
+    Timer rotationTimer;
+
+    //-------------------------------------------------------------------------
+    // Writer thread state
+    //-------------------------------------------------------------------------
+    /** Record data that's waiting to be written. */
+    std::vector<Uint8> pendingRecordData;
+
+    /** The record data that the writer thread is writing. */
+    std::vector<Uint8> writingRecordData;
+
+    /** If true, the writer thread should rotate the journal files after
+        writing any pending data. */
+    bool rotationIsPending;
+
+    /** The template records to start the next generation with. */
+    std::vector<Uint8> pendingTemplateRecordData;
+
+    /** If true, the writer thread should exit after writing any pending
+        data. */
+    bool exitRequested;
+
+    /** Guards the writer thread state above. */
+    std::mutex writerMutex;
+
+    /** Used to wake the writer thread. */
+    std::condition_variable writerCondition;
+
+    /** The current journal file. Only used by the writer thread, after
+        construction. */
+    std::ofstream journalFile;
+
+    std::thread writerThread;
+
+    EventQueue<TileAddLayer> tileAddLayerQueue;
+    EventQueue<TileRemoveLayer> tileRemoveLayerQueue;
+    EventQueue<EntityInitRequest> entityInitRequestQueue;
+    EventQueue<EntityDeleteRequest> entityDeleteRequestQueue;
+    EventQueue<EntityNameChangeRequest> entityNameChangeRequestQueue;
+    EventQueue<GraphicStateChangeRequest> graphicStateChangeRequestQueue;
+    EventQueue<ItemInitRequest> itemInitRequestQueue;
+    EventQueue<ItemChangeRequest> itemChangeRequestQueue;
+};
+
+} // End namespace Server
+} // End namespace AM
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <SDL_stdinc.h>
+#include <vector>
+#include <span>
+#include <cstring>
+
+namespace AM
+{
+namespace Server
+{
+/**
+ * The layout of an edit journal file.
+ *
+ * Layout:
+ *   Uint32 magic
+ *   Uint16 formatVersion
+ *   Records, until the end of the file.
+ *
+ * Each record is:
+ *   Uint8 type (a RecordType)
+ *   Uint32 createdEntity (the entity that an init request created, or
+ *                         entt::null)
+ *   Uint32 payloadSize
+ *   The serialized message, payloadSize bytes long.
+ *
+ * Values are stored as raw little-endian integers.
+ *
+ * This is kept separate from EditJournal so that the framing can be read
+ * and written without a World.
+ */
+namespace EditJournalFormat
+{
+/** Identifies an edit journal file. */
+static constexpr Uint32 MAGIC{0x4A454D41}; // "AMEJ"
+
+/** The version of the journal layout.
+    1: Initial version. */
+static constexpr Uint16 FORMAT_VERSION{1};
+
+/** The size, in bytes, of the file header. */
+static constexpr std::size_t HEADER_SIZE{sizeof(Uint32) + sizeof(Uint16)};
+
+/** The size, in bytes, of each record's header. */
+static constexpr std::size_t RECORD_HEADER_SIZE{sizeof(Uint8)
+                                                + (sizeof(Uint32) * 2)};
+
+/** The max size, in bytes, of a record's payload.
+    Far larger than any message that we journal. Used to reject corrupt
+    length fields before we allocate for them. */
+static constexpr std::size_t MAX_PAYLOAD_SIZE{1024 * 1024};
+
+enum class RecordType : Uint8 {
+    TileAddLayer,
+    TileRemoveLayer,
+    EntityInitRequest,
+    EntityDeleteRequest,
+    EntityNameChangeRequest,
+    GraphicStateChangeRequest,
+    ItemInitRequest,
+    ItemChangeRequest,
+    EntityTemplate,
+    BulkSpawn,
+    // Sentinel used to validate record types.
+    Count
+};
+
+/**
+ * A single record, with its payload still serialized.
+ */
+struct Record {
+    RecordType type{};
+
+    /** If this record is an entity init request that created a new entity,
+        this is that entity's ID. */
+    Uint32 createdEntity{0};
+
+    /** The serialized message. */
+    std::vector<Uint8> payload{};
+};
+
+/**
+ * Appends the given value's bytes to the given buffer.
+ */
+template<typename T>
+inline void appendValue(std::vector<Uint8>& buffer, T value)
+{
+    std::size_t startIndex{buffer.size()};
+    buffer.resize(startIndex + sizeof(T));
+    std::memcpy(&(buffer[startIndex]), &value, sizeof(T));
+}
+
+/**
+ * Appends a file header to the given buffer.
+ */
+inline void appendHeader(std::vector<Uint8>& buffer)
+{
+    appendValue(buffer, MAGIC);
+    appendValue(buffer, FORMAT_VERSION);
+}
+
+/**
+ * Appends a record with the given fields to the given buffer.
+ */
+inline void appendRecord(std::vector<Uint8>& buffer, RecordType type,
+                         Uint32 createdEntity,
+                         std::span<const Uint8> payload)
+{
+    appendValue(buffer, static_cast<Uint8>(type));
+    appendValue(buffer, createdEntity);
+    appendValue(buffer, static_cast<Uint32>(payload.size()));
+    buffer.insert(buffer.end(), payload.begin(), payload.end());
+}
+
+/**
+ * The result of readRecords().
+ */
+enum class ReadResult {
+    /** Every byte was read as a complete record. */
+    Complete,
+    /** The file ended partway through a record, e.g. because we crashed
+        mid-write. The records before it were read. */
+    Truncated,
+    /** A record had an invalid type or an oversized payload. The records
+        before it were read. */
+    Corrupt,
+    /** The header was missing, or had the wrong magic or version. No
+        records were read. */
+    InvalidHeader
+};
+
+/**
+ * Reads the records from the given file data, appending them to the given
+ * vector.
+ *
+ * Each record's payload size is checked against both MAX_PAYLOAD_SIZE and
+ * the bytes that are left in the data before anything is allocated.
+ */
+inline ReadResult readRecords(std::span<const Uint8> fileData,
+                              std::vector<Record>& records)
+{
+    auto readValue = [&](std::size_t& index, auto& value) {
+        std::memcpy(&value, (fileData.data() + index), sizeof(value));
+        index += sizeof(value);
+    };
+
+    std::size_t index{0};
+    if (fileData.size() < HEADER_SIZE) {
+        return ReadResult::InvalidHeader;
+    }
+    Uint32 magic{0};
+    Uint16 formatVersion{0};
+    readValue(index, magic);
+    readValue(index, formatVersion);
+    if ((magic != MAGIC) || (formatVersion != FORMAT_VERSION)) {
+        return ReadResult::InvalidHeader;
+    }
+
+    while (index < fileData.size()) {
+        if ((fileData.size() - index) < RECORD_HEADER_SIZE) {
+            return ReadResult::Truncated;
+        }
+
+        Uint8 type{0};
+        Uint32 createdEntity{0};
+        Uint32 payloadSize{0};
+        readValue(index, type);
+        readValue(index, createdEntity);
+        readValue(index, payloadSize);
+        if ((type >= static_cast<Uint8>(RecordType::Count))
+            || (payloadSize > MAX_PAYLOAD_SIZE)) {
+            return ReadResult::Corrupt;
+        }
+        else if (payloadSize > (fileData.size() - index)) {
+            return ReadResult::Truncated;
+        }
+
+        const Uint8* payloadStart{fileData.data() + index};
+        records.push_back(
+            {static_cast<RecordType>(type), createdEntity,
+             std::vector<Uint8>(payloadStart, (payloadStart + payloadSize))});
+        index += payloadSize;
+    }
+
+    return ReadResult::Complete;
+}
+
+} // End namespace EditJournalFormat
+} // End namespace Server
+} // End namespace AM
@@ -0,0 +1,187 @@
+#pragma once
+
+#include "ProjectPersistedComponentTypes.h"
+#include "Timer.h"
+#include "entt/fwd.hpp"
+#include "SQLiteCpp/Database.h"
+#include "SQLiteCpp/Statement.h"
+#include <unordered_set>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <SDL_stdinc.h>
+
+namespace AM
+{
+namespace Server
+{
+
+class World;
+
+/**
+ * Saves the project's persisted components for entities that have changed,
+ * without waiting for the engine's next full save.
+ *
+ * Registry observers mark an entity as dirty whenever one of its
+ * ProjectPersistedComponentTypes is constructed, updated, or destroyed.
+ * Every Config::INCREMENTAL_SAVE_PERIOD_S, the dirty entities' components are
+ * captured into a snapshot during the tick. The snapshot is then handed to
+ * a background thread, which writes it to the entities' existing rows in the
+ * database in a single transaction.
+ *
+ * If a snapshot fails to write, its entities are handed back to the sim
+ * thread and marked dirty again. On shutdown, any remaining dirty entities
+ * are written before we return.
+ *
+ * Note: This only moves our own database writes off the sim thread. The
+ *       capture (including serializing the components) still runs during the
+ *       tick, and the engine's full save of the tile map and world still
+ *       runs in-tick on its own schedule. That save lives in the engine and
+ *       has no snapshot hook, so it can't be copied or serialized off-thread
+ *       from here.
+ *
+ * Note: Entities that haven't been saved by the engine yet don't have a row to
+ *       update. They're skipped, since the engine's next full save will
+ *       write them.
+ *
+ * Note: The engine's full save writes to the same database through its own
+ *       connection. SQLite only allows one writer at a time, so the two
+ *       transactions never interleave (ours waits a few seconds for the
+ *       lock, then fails and is retried).
+ *       Either may commit first. If our snapshot commits after a full save,
+ *       it may overwrite newer data, but only for entities that changed
+ *       after the capture. Those entities are dirty again, so the next
+ *       capture writes their latest data.
+ */
+class IncrementalSaveSystem
+{
+public:
+    IncrementalSaveSystem(World& inWorld);
+
+    ~IncrementalSaveSystem();
+
+    /**
+     * If enough time has passed, captures all of the dirty entities and
+     * hands them to the save thread.
+     */
+    void saveDirtyEntities();
+
+private:
+    /** The amount of tick time that we allow a capture to take. If a capture
+        takes longer than this, we log a warning. */
+    static constexpr double CAPTURE_BUDGET_S{0.001};
+
+    /**
+     * The dirty entities' data, as captured during a tick.
+     *
+     * Note: We capture already-serialized component data instead of copying
+     *       the components. The persisted fields are small, so serializing
+     *       them is cheaper than copying the full components (e.g.
+     *       RandomWalkerAI's copy constructor re-seeds its generator).
+     */
+    struct Snapshot {
+        /** The captured entities' IDs. */
+        std::vector<Uint32> entityIDs;
+
+        /** The index within componentData where each entity's data starts.
+            Index-matched with entityIDs. */
+        std::vector<std::size_t> dataOffsets;
+
+        /** All of the captured entities' serialized components, back to
+            back. */
+        std::vector<Uint8> componentData;
+
+        void clear()
+        {
+            entityIDs.clear();
+            dataOffsets.clear();
+            componentData.clear();
+        }
+    };
+
+    /**
+     * Marks the given entity as dirty.
+     */
+    void onComponentChanged(entt::registry& registry, entt::entity entity);
+
+    /**
+     * Marks any entities that failed to save as dirty again.
+     */
+    void requeueFailedEntities();
+
+    /**
+     * Captures all of the dirty entities into captureSnapshot.
+     */
+    void captureDirtyEntities();
+
+    /**
+     * Serializes the given entity's persisted components into
+     * serializationBuffer.
+     * @return The number of bytes that were written.
+     */
+    std::size_t serializeComponents(entt::entity entity);
+
+    /**
+     * Thread function. Waits for snapshots and writes them to the database.
+     */
+    void writeSnapshots();
+
+    /**
+     * Writes the given snapshot to the database.
+     */
+    void writeSnapshot(const Snapshot& snapshot);
+
+    /** Used to get the persisted components. */
+    World& world;
+
+    /** Our connection to the database.
+        Only used by the save thread, after construction. */
+    SQLite::Database database;
+
+    /** Updates a single entity's project components. */
+    SQLite::Statement updateComponentsQuery;
+
+    /** The entities that have changed since the last capture. */
+    std::unordered_set<entt::entity> dirtyEntities;
+
+    /** Holds a single entity's components while we serialize them. */
+    std::vector<ProjectPersistedComponent> componentBuffer;
+
+    /** Holds a single entity's serialized components. */
+    std::vector<Uint8> serializationBuffer;
+
+    Timer saveTimer;
+
+    /** The snapshot that the sim thread captures into. */
+    Snapshot captureSnapshot;
+
+    /** The snapshot that's waiting to be written. */
+    Snapshot pendingSnapshot;
+
+    /** The snapshot that the save thread is writing. */
+    Snapshot writingSnapshot;
+
+    /** If true, pendingSnapshot holds data that hasn't been written yet. */
+    bool snapshotIsPending;
+
+    /** The IDs of entities in snapshots that failed to write. Handed back
+        to the sim thread to be re-captured. */
+    std::vector<Uint32> failedEntityIDs;
+
+    /** Guards pendingSnapshot, snapshotIsPending, and failedEntityIDs. */
+    std::mutex snapshotMutex;
+
+    /** Used to wake the save thread when a snapshot is pending. */
+    std::condition_variable snapshotCondition;
+
+    /** Set to true to signal that the save thread should exit. */
+    std::atomic<bool> exitRequested;
+
+    /** Writes snapshots to the database. */
+    std::thread saveThread;
+};
+
+} // End namespace Server
+} // End namespace AM
@@ -1,7 +1,9 @@
 #pragma once
 
+#include "BulkSpawnRequest.h"
 #include "entt/fwd.hpp"
 #include <string_view> 
+#include <string>
 
 namespace AM
 {
@@ -14,6 +16,7 @@ struct DialogueLua;
 struct DialogueChoiceConditionLua;
 class GraphicData;
 class World;
+class BulkSpawnSystem;
 
 /**
  * Holds any functionality that the project wants to expose to Lua.
@@ -28,7 +31,8 @@ public:
                        EntityItemHandlerLua& inEntityItemHandlerLua,
                        ItemInitLua& inItemInitLua, DialogueLua& inDialogueLua,
                        DialogueChoiceConditionLua& inDialogueChoiceConditionLua,
-                       const GraphicData& inGraphicData, World& inWorld);
+                       const GraphicData& inGraphicData, World& inWorld,
+                       BulkSpawnSystem& inBulkSpawnSystem);
 
     /**
      * Adds our bindings to the lua object.
@@ -36,6 +40,9 @@ public:
     void addBindings();
 
 private:
+    /** The max radius, in tiles, that a Lua bulk spawn can use. */
+    static constexpr int MAX_SPAWN_RADIUS{32};
+
     // Entity init
     /**
      * Makes the entity walk around randomly.
@@ -46,6 +53,37 @@ private:
     void addRandomWalkerAIBehavior(double timeToWalk, double timeToWait,
                                    double timeTillDirectionChange);
 
+    /**
+     * Spawns a group of entities around this entity, all in the same tick.
+     * @param name The name to give each entity.
+     * @param graphicSetID The string ID of each entity's graphic set.
+     * @param radius How far, in tiles, from this entity to spawn them.
+     *               Clamped to MAX_SPAWN_RADIUS.
+     * @param count How many entities to spawn.
+     */
+    void bulkSpawnEntities(const std::string& name,
+                           const std::string& graphicSetID, int radius,
+                           int count);
+
+    /**
+     * Spawns a group of random walkers around this entity, all in the same
+     * tick.
+     * See bulkSpawnEntities() and addRandomWalkerAIBehavior() for params.
+     */
+    void bulkSpawnRandomWalkers(const std::string& name,
+                                const std::string& graphicSetID, int radius,
+                                int count, double timeToWalk,
+                                double timeToWait,
+                                double timeTillDirectionChange);
+
+    /**
+     * Returns a spawn request for the given group, centered on this entity
+     * and limited to the tile map's extent.
+     */
+    BulkSpawnRequest buildSpawnRequest(const std::string& name,
+                                       const std::string& graphicSetID,
+                                       int radius, int count);
+
     // Entity item handler
 
     // Item init
@@ -58,6 +96,7 @@ private:
     DialogueChoiceConditionLua& dialogueChoiceConditionLua;
     const GraphicData& graphicData;
     World& world;
+    BulkSpawnSystem& bulkSpawnSystem;
 };
 
 } // namespace Server
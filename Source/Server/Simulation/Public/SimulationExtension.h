@@ -3,7 +3,11 @@
 #include "ISimulationExtension.h"
 #include "ProjectLuaBindings.h"
 #include "BuildModeDataSystem.h"
+#include "BulkSpawnSystem.h"
+#include "TileExtentEditSystem.h"
+#include "EditJournal.h"
 #include "TeleportSystem.h"
+#include "IncrementalSaveSystem.h"
 
 namespace AM
 {
@@ -102,11 +106,24 @@ private:
     /** Used to validate change requests. */
     World& world;
 
+    // Note: This must be constructed before projectLuaBindings, since the
+    //       bindings queue spawns through it.
+    BulkSpawnSystem bulkSpawnSystem;
+
     /** This project's Lua bindings. */
     ProjectLuaBindings projectLuaBindings;
 
     BuildModeDataSystem buildModeDataSystem;
+
+    TileExtentEditSystem tileExtentEditSystem;
+
+    // Note: This must be constructed after buildModeDataSystem and
+    //       bulkSpawnSystem, since it restores templates and groups through
+    //       them.
+    EditJournal editJournal;
+
     TeleportSystem teleportSystem;
+    IncrementalSaveSystem incrementalSaveSystem;
 };
 
 } // End namespace Server
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "TileExtentEdit.h"
+#include "QueuedEvents.h"
+
+namespace AM
+{
+namespace Server
+{
+
+class ISimulationExtension;
+
+/**
+ * Applies the extent-based tile edits that build mode sends when the user
+ * clicks and drags.
+ *
+ * Each edit is validated once, for its whole extent, and then expanded into
+ * the engine's per-tile layer requests.
+ *
+ * Note: The expanded requests go through the engine's usual tile update
+ *       path, so they're journaled and sent to clients like any other tile
+ *       edit. This means an N x N edit still costs N^2 dispatcher pushes,
+ *       N^2 journal records, and N^2 tile updates to each client in range.
+ *       The engine only accepts per-tile requests, so they can't be batched
+ *       per chunk from here. TileExtentEdit::MAX_EXTENT_LENGTH bounds the
+ *       fan-out instead.
+ */
+class TileExtentEditSystem
+{
+public:
+    TileExtentEditSystem(EventDispatcher& inNetworkEventDispatcher,
+                         const ISimulationExtension& inExtension);
+
+    /**
+     * Validates any waiting extent edits, then expands the valid ones.
+     *
+     * Must be called before the engine processes the tick's messages.
+     */
+    void processExtentEdits();
+
+private:
+    /**
+     * Returns true if the given edit is well-formed and its extent is
+     * editable, else false.
+     */
+    bool isEditValid(const TileExtentEdit& tileExtentEdit) const;
+
+    /**
+     * Pushes a layer request for each tile in the given edit's extent.
+     */
+    void expandEdit(const TileExtentEdit& tileExtentEdit);
+
+    /** Used to push the expanded layer requests. */
+    EventDispatcher& networkEventDispatcher;
+
+    /** Used to validate client requests. */
+    const ISimulationExtension& extension;
+
+    EventQueue<TileExtentEdit> tileExtentEditQueue;
+};
+
+} // End namespace Server
+} // End namespace AM
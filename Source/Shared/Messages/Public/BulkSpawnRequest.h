@@ -0,0 +1,82 @@
+#pragma once
+
+#include "ProjectMessageType.h"
+#include "Name.h"
+#include "GraphicState.h"
+#include "TileExtent.h"
+#include "NetworkID.h"
+#include <SDL_stdinc.h>
+
+namespace AM
+{
+
+/**
+ * Sent by a client to request that a group of entities be created with the
+ * given name and graphic state, scattered within the given extent.
+ *
+ * Note: This only copies a name and graphic state. No init script is run
+ *       for the created entities, so a group made from a template's name and
+ *       graphic state isn't made of instances of that template.
+ *
+ * All of the entities will be created in a single tick, so clients will
+ * receive them in a single update.
+ */
+struct BulkSpawnRequest {
+    // The ProjectMessageType enum value that this message corresponds to.
+    // Declares this struct as a message that the Network can send and receive.
+    static constexpr ProjectMessageType MESSAGE_TYPE{
+        ProjectMessageType::BulkSpawnRequest};
+
+    /** Used as a "we should never hit this" cap on the number of entities
+        that a single request can create. */
+    static constexpr std::size_t MAX_SPAWN_COUNT{500};
+
+    /** The name to give each entity. */
+    Name name{};
+
+    /** The graphic state to give each entity. */
+    GraphicState graphicState{};
+
+    /** The extent to scatter the entities within. */
+    TileExtent tileExtent{};
+
+    /** The number of entities to create. */
+    Uint16 spawnCount{0};
+
+    /** If true, a RandomWalkerAI will be added to each entity, using the
+        timings below. */
+    bool addRandomWalkerAI{false};
+
+    /** How long to walk for. */
+    float timeToWalk{0};
+    /** How long to wait for. */
+    float timeToWait{0};
+    /** How often to change direction. */
+    float timeTillDirectionChange{0};
+
+    //--------------------------------------------------------------------------
+    // Local data
+    //--------------------------------------------------------------------------
+    /**
+     * The network ID of the client that sent this message.
+     * Set by the server.
+     * No IDs are accepted from the client because we can't trust it,
+     * so we fill in the ID based on which socket the message came from.
+     */
+    NetworkID netID{0};
+};
+
+template<typename S>
+void serialize(S& serializer, BulkSpawnRequest& bulkSpawnRequest)
+{
+    serializer.object(bulkSpawnRequest.name);
+    serializer.object(bulkSpawnRequest.graphicState);
+    serializer.object(bulkSpawnRequest.tileExtent);
+    serializer.value2b(bulkSpawnRequest.spawnCount);
+    serializer.boolValue(bulkSpawnRequest.addRandomWalkerAI);
+    serializer.value4b(bulkSpawnRequest.timeToWalk);
+    serializer.value4b(bulkSpawnRequest.timeToWait);
+    serializer.value4b(bulkSpawnRequest.timeTillDirectionChange);
+}
+
+} // End namespace AM
@@ -21,6 +21,8 @@ enum class ProjectMessageType : Uint8 {
     = static_cast<Uint8>(EngineMessageType::PROJECT_START),
     AddEntityTemplate,
     TemplateInitScriptRequest,
+    BulkSpawnRequest,
+    TileExtentEdit,
 
     // Server -> Client Messages
     EntityTemplates,
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "ProjectMessageType.h"
+#include "TileExtent.h"
+#include "TileOffset.h"
+#include "TileLayer.h"
+#include "NetworkID.h"
+#include <SDL_stdinc.h>
+
+namespace AM
+{
+
+/**
+ * Sent by a client to request that a tile layer be added to, or removed
+ * from, every tile in an extent.
+ *
+ * Used by build mode's click-and-drag. Instead of sending a TileAddLayer or
+ * TileRemoveLayer for every tile, the client describes the whole edit in one
+ * message. The server validates the extent once, then expands it into the
+ * engine's per-tile requests (see TileExtentEditSystem).
+ */
+struct TileExtentEdit {
+    // The ProjectMessageType enum value that this message corresponds to.
+    // Declares this struct as a message that the Network can send and receive.
+    static constexpr ProjectMessageType MESSAGE_TYPE{
+        ProjectMessageType::TileExtentEdit};
+
+    /** The max length of each side of the extent, in tiles.
+        Each tile in the extent still costs the server a tile request, a
+        journal record, and a client update, so this keeps a single edit
+        to at most one chunk's worth (256 tiles). */
+    static constexpr int MAX_EXTENT_LENGTH{16};
+
+    enum class Operation : Uint8 {
+        /** Add the layer to each tile. */
+        AddLayer,
+        /** Remove the layer from each tile. */
+        RemoveLayer
+    };
+
+    /** Whether we're adding or removing the layer. */
+    Operation operation{Operation::AddLayer};
+
+    /** The tiles to edit. Must be 1 tile tall, and no longer than
+        MAX_EXTENT_LENGTH on each side. */
+    TileExtent tileExtent{};
+
+    /** The layer's offset within each tile. */
+    TileOffset tileOffset{};
+
+    /** The type of layer to add or remove. */
+    TileLayer::Type layerType{};
+
+    /** The numeric ID of the layer's graphic set. */
+    Uint16 graphicSetID{0};
+
+    /** The layer's graphic value (see TileAddLayer). For walls, this is the
+        wall type, and must be North or West. */
+    Uint8 graphicValue{0};
+
+    //--------------------------------------------------------------------------
+    // Local data
+    //--------------------------------------------------------------------------
+    /**
+     * The network ID of the client that sent this message.
+     * Set by the server.
+     * No IDs are accepted from the client because we can't trust it,
+     * so we fill in the ID based on which socket the message came from.
+     */
+    NetworkID netID{0};
+};
+
+template<typename S>
+void serialize(S& serializer, TileExtentEdit& tileExtentEdit)
+{
+    serializer.value1b(tileExtentEdit.operation);
+    serializer.object(tileExtentEdit.tileExtent);
+    serializer.object(tileExtentEdit.tileOffset);
+    serializer.value1b(tileExtentEdit.layerType);
+    serializer.value2b(tileExtentEdit.graphicSetID);
+    serializer.value1b(tileExtentEdit.graphicValue);
+}
+
+} // End namespace AM
@@ -0,0 +1,318 @@
+#include "IndexedTileMapReader.h"
+#include "IndexedTileMapWriter.h"
+#include "TileMapStreamWriter.h"
+#include "TileMapSnapshot.h"
+#include "Deserialize.h"
+#include "Timer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace AM;
+
+void printUsage()
+{
+    std::printf("Usage: ConvertTileMap.exe <InputPath> <OutputPath> "
+                "[--codec <none|rle|lz4|zstd>]\n"
+                "  Converts a snapshot map (TileMap.bin) to an indexed map, "
+                "or an indexed map back to a snapshot map.\n"
+                "  The input's format is detected automatically.\n"
+                "  The codec compresses each chunk of an indexed output.\n"
+                "Usage: ConvertTileMap.exe --benchmark <SnapshotMapPath>\n"
+                "  Converts the given snapshot map with each available codec, "
+                "and compares the file sizes and load times.\n");
+    std::fflush(stdout);
+}
+
+/**
+ * Decodes every chunk in the given map, split across the given number of
+ * threads, and passes each one to handleChunk.
+ *
+ * Each thread only holds the chunk that it's working on, so memory use
+ * doesn't depend on the map's size.
+ *
+ * @param handleChunk A callable that takes (std::size_t entryIndex,
+ *                    ChunkSnapshot* chunkSnapshot). chunkSnapshot is nullptr
+ *                    if the chunk failed to decode. Called on the worker
+ *                    threads.
+ * @return true if every chunk decoded successfully, else false.
+ */
+template<typename HandleChunkFunction>
+bool decodeEachChunk(const IndexedTileMapReader& reader,
+                     unsigned int threadCount,
+                     HandleChunkFunction&& handleChunk)
+{
+    // Each thread claims the next entry until there are none left.
+    std::size_t entryCount{reader.getIndex().size()};
+    std::atomic<std::size_t> nextEntryIndex{0};
+    std::atomic<bool> decodeFailed{false};
+    auto decodeEntries = [&]() {
+        ChunkSnapshot chunkSnapshot{};
+        std::vector<Uint8> decompressBuffer{};
+        for (std::size_t entryIndex{nextEntryIndex++};
+             entryIndex < entryCount; entryIndex = nextEntryIndex++) {
+            if (reader.decodeChunk(entryIndex, chunkSnapshot,
+                                   decompressBuffer)) {
+                handleChunk(entryIndex, &chunkSnapshot);
+            }
+            else {
+                // Note: We still call handleChunk, so anything waiting on
+                //       this entry (e.g. an ordered writer) can move on.
+                decodeFailed = true;
+                handleChunk(entryIndex, nullptr);
+            }
+        }
+    };
+
+    // Decode, using this thread as one of the workers.
+    std::vector<std::thread> workerThreads{};
+    for (unsigned int i{1}; i < threadCount; ++i) {
+        workerThreads.emplace_back(decodeEntries);
+    }
+    decodeEntries();
+    for (std::thread& workerThread : workerThreads) {
+        workerThread.join();
+    }
+
+    return !decodeFailed;
+}
+
+/**
+ * Converts the given snapshot map to an indexed map.
+ */
+bool snapshotToIndexed(const std::string& inputPath,
+                       const std::string& outputPath, ChunkCodec codec)
+{
+    // Load the whole snapshot, as the engine does.
+    Timer timer{};
+    TileMapSnapshot mapSnapshot{};
+    if (!Deserialize::fromFile(inputPath, mapSnapshot)) {
+        std::printf("Failed to deserialize map at path: %s\n",
+                    inputPath.c_str());
+        return false;
+    }
+    std::printf("Loaded snapshot map (%zu chunks) in %.3fms.\n",
+                mapSnapshot.chunks.size(), (timer.getTime() * 1000.0));
+
+    IndexedTileMapWriter writer{outputPath,
+                                mapSnapshot.version,
+                                mapSnapshot.xLengthChunks,
+                                mapSnapshot.yLengthChunks,
+                                mapSnapshot.zLengthChunks,
+                                mapSnapshot.chunks.size(),
+                                1,
+                                codec};
+    if (!(writer.isOpen())) {
+        std::printf("Failed to open output file: %s\n", outputPath.c_str());
+        return false;
+    }
+
+    std::vector<Uint8> buffer{};
+    std::size_t chunkIndex{0};
+    std::size_t chunkPaletteEntryCount{0};
+    for (auto& [chunkPosition, chunkSnapshot] : mapSnapshot.chunks) {
+        chunkPaletteEntryCount += chunkSnapshot.palette.size();
+        IndexedTileMapWriter::EncodedChunk encodedChunk{};
+        if (!(writer.encodeChunk(chunkSnapshot, buffer, encodedChunk))) {
+            std::printf("Failed to compress chunk (%d, %d, %d).\n",
+                        chunkPosition.x, chunkPosition.y, chunkPosition.z);
+            return false;
+        }
+        writer.writeChunk(chunkIndex, chunkPosition, std::move(encodedChunk));
+        chunkIndex++;
+    }
+
+    std::printf("Replaced %zu chunk palette entries with a %zu-entry palette "
+                "table.\n",
+                chunkPaletteEntryCount, writer.getPaletteEntryCount());
+
+    return writer.finish();
+}
+
+/**
+ * Converts the given indexed map to a snapshot map.
+ */
+bool indexedToSnapshot(const std::string& inputPath,
+                       const std::string& outputPath)
+{
+    // Open the indexed map. Chunks aren't decoded until we access them.
+    Timer timer{};
+    IndexedTileMapReader reader{};
+    if (!(reader.open(inputPath))) {
+        std::printf("Failed to open indexed map at path: %s\n",
+                    inputPath.c_str());
+        return false;
+    }
+    const IndexedTileMapFormat::Header& header{reader.getHeader()};
+    std::printf("Opened indexed map (%u chunks) in %.3fms.\n",
+                header.chunkCount, (timer.getTime() * 1000.0));
+
+    unsigned int threadCount{std::max(std::thread::hardware_concurrency(), 1U)};
+    TileMapStreamWriter writer{outputPath,
+                               header.mapVersion,
+                               header.xLengthChunks,
+                               header.yLengthChunks,
+                               header.zLengthChunks,
+                               header.chunkCount,
+                               (threadCount * 2)};
+    if (!(writer.isOpen())) {
+        std::printf("Failed to open output file: %s\n", outputPath.c_str());
+        return false;
+    }
+
+    // Decode and serialize each chunk on the worker threads. The writer puts
+    // the entries back in index order.
+    std::span<const IndexedTileMapFormat::IndexEntry> index{reader.getIndex()};
+    timer.reset();
+    bool decodeSuccessful{decodeEachChunk(
+        reader, threadCount,
+        [&](std::size_t entryIndex, ChunkSnapshot* chunkSnapshot) {
+            if (!chunkSnapshot) {
+                writer.writeChunkEntry(entryIndex, {});
+                return;
+            }
+
+            thread_local std::vector<Uint8> buffer{};
+            const IndexedTileMapFormat::IndexEntry& entry{index[entryIndex]};
+            std::size_t entrySize{TileMapStreamWriter::serializeChunkEntry(
+                {entry.x, entry.y, entry.z}, *chunkSnapshot, buffer)};
+            writer.writeChunkEntry(
+                entryIndex, std::vector<Uint8>(buffer.begin(),
+                                               (buffer.begin() + entrySize)));
+        })};
+    if (!decodeSuccessful) {
+        std::printf("Failed to decode chunks.\n");
+        writer.finish();
+        return false;
+    }
+    std::printf("Decoded and wrote all chunks on %u threads in %.3fms.\n",
+                threadCount, (timer.getTime() * 1000.0));
+
+    return writer.finish();
+}
+
+/**
+ * Converts the given snapshot map to an indexed map with each available
+ * codec, and prints how each compares to the snapshot map's size and load
+ * time.
+ */
+bool runBenchmark(const std::string& inputPath)
+{
+    // Time a full load of the snapshot map, as the engine does.
+    Timer timer{};
+    TileMapSnapshot mapSnapshot{};
+    if (!Deserialize::fromFile(inputPath, mapSnapshot)) {
+        std::printf("Failed to deserialize map at path: %s\n",
+                    inputPath.c_str());
+        return false;
+    }
+    double snapshotLoadTime{timer.getTime()};
+    std::uintmax_t snapshotSize{std::filesystem::file_size(inputPath)};
+    std::size_t chunkCount{mapSnapshot.chunks.size()};
+    mapSnapshot = {};
+
+    // Convert with each codec and time opening and decoding every chunk.
+    std::string outputPath{(std::filesystem::temp_directory_path()
+                            / "ConvertTileMapBenchmark.bin")
+                               .string()};
+    unsigned int threadCount{std::max(std::thread::hardware_concurrency(), 1U)};
+    std::printf("\n%-10s %12s %8s %12s %12s\n", "Format", "Bytes", "Size",
+                "Open (ms)", "Load (ms)");
+    std::printf("%-10s %12ju %7.1f%% %12s %12.3f\n", "snapshot", snapshotSize,
+                100.0, "-", (snapshotLoadTime * 1000.0));
+    for (ChunkCodec codec : {ChunkCodec::None, ChunkCodec::RunLength,
+                             ChunkCodec::LZ4, ChunkCodec::Zstd}) {
+        if (!ChunkCodecs::isAvailable(codec)) {
+            continue;
+        }
+        if (!snapshotToIndexed(inputPath, outputPath, codec)) {
+            return false;
+        }
+
+        // Note: The reader is scoped so the file is unmapped before it's
+        //       replaced.
+        double openTime{0};
+        double loadTime{0};
+        {
+            timer.reset();
+            IndexedTileMapReader reader{};
+            if (!(reader.open(outputPath))) {
+                std::printf("Failed to open indexed map.\n");
+                return false;
+            }
+            openTime = timer.getTime();
+            if (!decodeEachChunk(reader, threadCount,
+                                 [](std::size_t, ChunkSnapshot*) {})) {
+                std::printf("Failed to decode chunks.\n");
+                return false;
+            }
+            loadTime = timer.getTime();
+        }
+
+        std::uintmax_t indexedSize{std::filesystem::file_size(outputPath)};
+        std::printf("%-10s %12ju %7.1f%% %12.3f %12.3f\n",
+                    ChunkCodecs::toString(codec), indexedSize,
+                    (100.0 * indexedSize / snapshotSize), (openTime * 1000.0),
+                    (loadTime * 1000.0));
+    }
+    std::printf("(%zu chunks, indexed loads decoded on %u threads)\n",
+                chunkCount, threadCount);
+    std::filesystem::remove(outputPath);
+
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    if ((argc == 3) && (std::strcmp(argv[1], "--benchmark") == 0)) {
+        return runBenchmark(argv[2]) ? 0 : 1;
+    }
+
+    bool hasCodec{(argc == 5) && (std::strcmp(argv[3], "--codec") == 0)};
+    if ((argc != 3) && !hasCodec) {
+        printUsage();
+        return 1;
+    }
+
+    std::string inputPath{argv[1]};
+    std::string outputPath{argv[2]};
+    ChunkCodec codec{ChunkCodec::None};
+    if (hasCodec) {
+        if (!ChunkCodecs::fromString(argv[4], codec)) {
+            std::printf("Invalid codec. Valid values: none, rle, lz4, zstd\n");
+            return 1;
+        }
+        else if (!ChunkCodecs::isAvailable(codec)) {
+            std::printf("Codec \"%s\" isn't available in this build.\n",
+                        argv[4]);
+            return 1;
+        }
+    }
+
+    bool conversionSuccessful{false};
+    Timer timer{};
+    if (IndexedTileMapReader::isIndexedMap(inputPath)) {
+        conversionSuccessful = indexedToSnapshot(inputPath, outputPath);
+    }
+    else {
+        conversionSuccessful = snapshotToIndexed(inputPath, outputPath, codec);
+    }
+
+    if (!conversionSuccessful) {
+        std::printf("Conversion failed.\n");
+        return 1;
+    }
+
+    std::printf("Converted in %.3fms: %ju -> %ju bytes\n",
+                (timer.getTime() * 1000.0),
+                std::filesystem::file_size(inputPath),
+                std::filesystem::file_size(outputPath));
+    std::fflush(stdout);
+
+    return 0;
+}
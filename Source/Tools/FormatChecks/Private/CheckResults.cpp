@@ -0,0 +1,37 @@
+#include "CheckResults.h"
+#include <cstdio>
+
+namespace AM
+{
+namespace FC
+{
+CheckResults::CheckResults()
+: checkCount{0}
+, failureCount{0}
+{
+}
+
+bool CheckResults::check(bool condition, const std::string& description)
+{
+    checkCount++;
+    if (!condition) {
+        failureCount++;
+        std::printf("  FAILED: %s\n", description.c_str());
+        std::fflush(stdout);
+    }
+
+    return condition;
+}
+
+std::size_t CheckResults::getCheckCount() const
+{
+    return checkCount;
+}
+
+std::size_t CheckResults::getFailureCount() const
+{
+    return failureCount;
+}
+
+} // End namespace FC
+} // End namespace AM
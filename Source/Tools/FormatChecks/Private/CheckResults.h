@@ -0,0 +1,36 @@
+#pragma once
+
+#include <string>
+
+namespace AM
+{
+namespace FC
+{
+/**
+ * Tracks the results of the checks that have been run, and prints any that
+ * fail.
+ */
+class CheckResults
+{
+public:
+    CheckResults();
+
+    /**
+     * Records the result of a single check. If it failed, prints the given
+     * description.
+     *
+     * @return The given condition, so callers can skip checks that depend
+     *         on this one.
+     */
+    bool check(bool condition, const std::string& description);
+
+    std::size_t getCheckCount() const;
+    std::size_t getFailureCount() const;
+
+private:
+    std::size_t checkCount;
+    std::size_t failureCount;
+};
+
+} // End namespace FC
+} // End namespace AM
@@ -0,0 +1,195 @@
+#include "CodecChecks.h"
+#include "CheckResults.h"
+#include "ChunkCodec.h"
+#include <SDL_stdinc.h>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace AM
+{
+namespace FC
+{
+namespace CodecChecks
+{
+/** The seed for the random inputs, so failures are reproducible. */
+static constexpr Uint32 RANDOM_SEED{12345};
+
+/** How many random inputs to check. */
+static constexpr std::size_t RANDOM_INPUT_COUNT{200};
+
+/**
+ * An input to round-trip.
+ */
+struct Input {
+    std::string name{};
+    std::vector<Uint8> data{};
+};
+
+/**
+ * Appends count copies of the given byte to the given data.
+ */
+static void appendRun(std::vector<Uint8>& data, std::size_t count, Uint8 value)
+{
+    data.insert(data.end(), count, value);
+}
+
+/**
+ * Appends count bytes that never repeat back to back.
+ */
+static void appendLiterals(std::vector<Uint8>& data, std::size_t count)
+{
+    for (std::size_t i{0}; i < count; ++i) {
+        data.push_back(static_cast<Uint8>(i % 251));
+    }
+}
+
+/**
+ * Returns inputs on either side of the run-length codec's limits: 128-byte
+ * literal runs, 3-byte minimum repeats, and 130-byte maximum repeats.
+ */
+static std::vector<Input> getEdgeInputs()
+{
+    std::vector<Input> inputs{};
+    inputs.push_back({"empty", {}});
+    for (std::size_t count : {1, 2, 127, 128, 129, 256, 257}) {
+        Input input{"literals x" + std::to_string(count), {}};
+        appendLiterals(input.data, count);
+        inputs.push_back(std::move(input));
+    }
+    for (std::size_t count : {1, 2, 3, 4, 129, 130, 131, 132, 1000}) {
+        Input input{"repeat x" + std::to_string(count), {}};
+        appendRun(input.data, count, 7);
+        inputs.push_back(std::move(input));
+    }
+
+    // Short repeats between literals shouldn't split the literal runs.
+    Input mixed{"mixed runs", {}};
+    for (std::size_t i{0}; i < 50; ++i) {
+        appendLiterals(mixed.data, (i % 5));
+        appendRun(mixed.data, (i % 7), static_cast<Uint8>(i));
+    }
+    inputs.push_back(std::move(mixed));
+
+    return inputs;
+}
+
+/**
+ * Returns seeded random inputs. Like real chunks, they're mostly runs of a
+ * few values.
+ */
+static std::vector<Input> getRandomInputs()
+{
+    std::mt19937 generator{RANDOM_SEED};
+    std::uniform_int_distribution<std::size_t> runCountDistribution{0, 64};
+    std::uniform_int_distribution<std::size_t> runLengthDistribution{1, 300};
+    std::uniform_int_distribution<int> valueDistribution{0, 3};
+
+    std::vector<Input> inputs{};
+    for (std::size_t i{0}; i < RANDOM_INPUT_COUNT; ++i) {
+        Input input{"random #" + std::to_string(i), {}};
+        std::size_t runCount{runCountDistribution(generator)};
+        for (std::size_t run{0}; run < runCount; ++run) {
+            appendRun(input.data, runLengthDistribution(generator),
+                      static_cast<Uint8>(valueDistribution(generator)));
+        }
+        inputs.push_back(std::move(input));
+    }
+
+    return inputs;
+}
+
+/**
+ * Checks that the given input survives a round trip through the given
+ * codec.
+ */
+static void checkRoundTrip(ChunkCodec codec, const Input& input,
+                           CheckResults& results)
+{
+    std::string context{std::string{ChunkCodecs::toString(codec)} + " codec, "
+                        + input.name};
+    std::vector<Uint8> compressed{};
+    if (!results.check(ChunkCodecs::compress(codec, input.data.data(),
+                                             input.data.size(), compressed),
+                       context + ": compresses")) {
+        return;
+    }
+
+    std::vector<Uint8> decompressed{};
+    results.check(ChunkCodecs::decompress(codec, compressed.data(),
+                                          compressed.size(),
+                                          input.data.size(), decompressed)
+                      && (decompressed == input.data),
+                  context + ": decompresses to the input");
+}
+
+/**
+ * Checks that the run-length codec rejects the given input's compressed
+ * data if it's cut short or paired with the wrong decoded size.
+ */
+static void checkRunLengthRejects(const Input& input, CheckResults& results)
+{
+    if (input.data.empty()) {
+        return;
+    }
+
+    std::string context{"rle codec, " + input.name};
+    std::vector<Uint8> compressed{};
+    ChunkCodecs::compress(ChunkCodec::RunLength, input.data.data(),
+                          input.data.size(), compressed);
+
+    std::vector<Uint8> decompressed{};
+    results.check(!ChunkCodecs::decompress(
+                      ChunkCodec::RunLength, compressed.data(),
+                      (compressed.size() - 1), input.data.size(),
+                      decompressed),
+                  context + ": truncated data is rejected");
+    results.check(!ChunkCodecs::decompress(
+                      ChunkCodec::RunLength, compressed.data(),
+                      compressed.size(), (input.data.size() - 1),
+                      decompressed),
+                  context + ": a smaller decoded size is rejected");
+    results.check(!ChunkCodecs::decompress(
+                      ChunkCodec::RunLength, compressed.data(),
+                      compressed.size(), (input.data.size() + 1),
+                      decompressed),
+                  context + ": a larger decoded size is rejected");
+}
+
+void run(CheckResults& results)
+{
+    std::vector<Input> inputs{getEdgeInputs()};
+    std::vector<Input> randomInputs{getRandomInputs()};
+    inputs.insert(inputs.end(), randomInputs.begin(), randomInputs.end());
+
+    for (ChunkCodec codec : {ChunkCodec::None, ChunkCodec::RunLength,
+                             ChunkCodec::LZ4, ChunkCodec::Zstd}) {
+        if (!ChunkCodecs::isAvailable(codec)) {
+            std::printf("  Skipped the %s codec: not available in this "
+                        "build.\n",
+                        ChunkCodecs::toString(codec));
+            continue;
+        }
+
+        for (const Input& input : inputs) {
+            checkRoundTrip(codec, input, results);
+        }
+    }
+
+    for (const Input& input : inputs) {
+        checkRunLengthRejects(input, results);
+    }
+
+    // Long runs should actually shrink. Each 130-byte repeat is 2 bytes.
+    std::vector<Uint8> longRun(1300, 7);
+    std::vector<Uint8> compressed{};
+    ChunkCodecs::compress(ChunkCodec::RunLength, longRun.data(),
+                          longRun.size(), compressed);
+    results.check((compressed.size() == 20),
+                  "rle codec: a 1300-byte run compresses to 20 bytes");
+}
+
+} // namespace CodecChecks
+} // End namespace FC
+} // End namespace AM
@@ -0,0 +1,22 @@
+#pragma once
+
+namespace AM
+{
+namespace FC
+{
+class CheckResults;
+
+namespace CodecChecks
+{
+/**
+ * Compresses and decompresses inputs that sit on the run-length codec's
+ * run boundaries, plus seeded random data, with each available codec.
+ *
+ * Also checks that the run-length codec rejects truncated data and
+ * mismatched decoded sizes.
+ */
+void run(CheckResults& results);
+
+} // namespace CodecChecks
+} // End namespace FC
+} // End namespace AM
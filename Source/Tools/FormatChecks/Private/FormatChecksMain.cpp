@@ -0,0 +1,88 @@
+#include "CheckResults.h"
+#include "CodecChecks.h"
+#include "IndexedMapChecks.h"
+#include "JournalChecks.h"
+#include "MapDiffChecks.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace AM;
+using namespace AM::FC;
+
+/**
+ * A group of checks for a single format.
+ */
+struct CheckSet {
+    const char* name{nullptr};
+    void (*run)(CheckResults& results){nullptr};
+};
+
+/** Every check set, in the order they're run. */
+const std::vector<CheckSet> CHECK_SETS{{"codec", CodecChecks::run},
+                                       {"indexed", IndexedMapChecks::run},
+                                       {"diff", MapDiffChecks::run},
+                                       {"journal", JournalChecks::run}};
+
+void printUsage()
+{
+    std::printf("Usage: FormatChecks.exe [<CheckSetName>...]\n"
+                "  Writes each versioned on-disk format, reads it back, and "
+                "checks that nothing was lost.\n"
+                "  Runs every check set unless some are named. Check sets:");
+    for (const CheckSet& checkSet : CHECK_SETS) {
+        std::printf(" %s", checkSet.name);
+    }
+    std::printf("\n  Returns 1 if any check fails.\n");
+    std::fflush(stdout);
+}
+
+/**
+ * Returns true if the given check set was named on the command line, or if
+ * none were.
+ */
+bool isSelected(const CheckSet& checkSet, int argc, char** argv)
+{
+    if (argc == 1) {
+        return true;
+    }
+
+    for (int i{1}; i < argc; ++i) {
+        if (std::strcmp(argv[i], checkSet.name) == 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+int main(int argc, char** argv)
+{
+    // Make sure every named check set exists.
+    for (int i{1}; i < argc; ++i) {
+        bool isKnown{false};
+        for (const CheckSet& checkSet : CHECK_SETS) {
+            isKnown |= (std::strcmp(argv[i], checkSet.name) == 0);
+        }
+        if (!isKnown) {
+            std::printf("Unknown check set: %s\n", argv[i]);
+            printUsage();
+            return 1;
+        }
+    }
+
+    CheckResults results{};
+    for (const CheckSet& checkSet : CHECK_SETS) {
+        if (isSelected(checkSet, argc, argv)) {
+            std::printf("Checking %s...\n", checkSet.name);
+            std::fflush(stdout);
+            checkSet.run(results);
+        }
+    }
+
+    std::printf("%zu of %zu checks passed.\n",
+                (results.getCheckCount() - results.getFailureCount()),
+                results.getCheckCount());
+    return (results.getFailureCount() == 0) ? 0 : 1;
+}
@@ -0,0 +1,132 @@
+#include "IndexedMapChecks.h"
+#include "CheckResults.h"
+#include "MapFixtures.h"
+#include "IndexedTileMapReader.h"
+#include "TileMapStreamReader.h"
+#include "TileMapStreamWriter.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace AM
+{
+namespace FC
+{
+namespace IndexedMapChecks
+{
+/** The seed and density to generate the fixture with. */
+static constexpr Uint32 FIXTURE_SEED{12345};
+static constexpr float FIXTURE_DENSITY{0.3f};
+
+/**
+ * Checks that the given indexed map holds the same chunks as the given
+ * snapshot map.
+ */
+static void checkMatchesSnapshot(const std::string& snapshotPath,
+                                 const std::string& indexedPath,
+                                 const std::string& context,
+                                 CheckResults& results)
+{
+    TileMapStreamReader snapshotReader{};
+    IndexedTileMapReader indexedReader{};
+    if (!results.check(snapshotReader.open(snapshotPath)
+                           && indexedReader.open(indexedPath),
+                       context + ": opens")) {
+        return;
+    }
+
+    const IndexedTileMapFormat::Header& header{indexedReader.getHeader()};
+    results.check(
+        (header.mapVersion == snapshotReader.getVersion())
+            && (header.xLengthChunks == snapshotReader.getXLengthChunks())
+            && (header.yLengthChunks == snapshotReader.getYLengthChunks())
+            && (header.zLengthChunks == snapshotReader.getZLengthChunks())
+            && (header.chunkCount == snapshotReader.getChunkCount()),
+        context + ": header matches the snapshot map");
+
+    // Re-serialize each decoded chunk as a snapshot entry. If the palette
+    // table, compression, or chunk layout lost anything, it won't match.
+    std::size_t mismatchCount{0};
+    ChunkPosition chunkPosition{};
+    ChunkSnapshot snapshotChunk{};
+    std::vector<Uint8> buffer{};
+    while (snapshotReader.readChunkEntry(chunkPosition, snapshotChunk)) {
+        const ChunkSnapshot* indexedChunk{
+            indexedReader.getChunk(chunkPosition)};
+        if (!indexedChunk) {
+            mismatchCount++;
+            continue;
+        }
+
+        ChunkSnapshot decodedChunk{*indexedChunk};
+        std::size_t entrySize{TileMapStreamWriter::serializeChunkEntry(
+            chunkPosition, decodedChunk, buffer)};
+        std::span<const Uint8> snapshotEntry{
+            snapshotReader.getLastEntryData()};
+        if (!std::ranges::equal(snapshotEntry,
+                                std::span{buffer.data(), entrySize})) {
+            mismatchCount++;
+        }
+    }
+    results.check(snapshotReader.isAtEnd() && (mismatchCount == 0),
+                  context + ": every chunk matches the snapshot map ("
+                      + std::to_string(mismatchCount) + " mismatched)");
+}
+
+/**
+ * Checks that the given indexed map is rejected if it's cut short.
+ */
+static void checkTruncatedIsRejected(const std::string& indexedPath,
+                                     const std::string& context,
+                                     CheckResults& results)
+{
+    // Cut the file in half, so the palette table and some blocks are gone.
+    std::string truncatedPath{indexedPath + ".truncated"};
+    std::filesystem::copy_file(
+        indexedPath, truncatedPath,
+        std::filesystem::copy_options::overwrite_existing);
+    std::filesystem::resize_file(truncatedPath,
+                                 (std::filesystem::file_size(indexedPath)
+                                  / 2));
+
+    {
+        IndexedTileMapReader reader{};
+        results.check(!(reader.open(truncatedPath)),
+                      context + ": a truncated file is rejected");
+    }
+    std::filesystem::remove(truncatedPath);
+}
+
+void run(CheckResults& results)
+{
+    std::string snapshotPath{MapFixtures::generate(
+        "FormatChecks_Snapshot.bin", FIXTURE_SEED, FIXTURE_DENSITY,
+        MG::OutputFormat::Snapshot)};
+
+    for (ChunkCodec codec : {ChunkCodec::None, ChunkCodec::RunLength,
+                             ChunkCodec::LZ4, ChunkCodec::Zstd}) {
+        std::string context{std::string{"indexed map ("}
+                            + ChunkCodecs::toString(codec) + ")"};
+        if (!ChunkCodecs::isAvailable(codec)) {
+            std::printf("  Skipped %s: not available in this build.\n",
+                        context.c_str());
+            continue;
+        }
+
+        std::string indexedPath{MapFixtures::generate(
+            "FormatChecks_Indexed.bin", FIXTURE_SEED, FIXTURE_DENSITY,
+            MG::OutputFormat::Indexed, codec)};
+        checkMatchesSnapshot(snapshotPath, indexedPath, context, results);
+        checkTruncatedIsRejected(indexedPath, context, results);
+        std::filesystem::remove(indexedPath);
+    }
+
+    std::filesystem::remove(snapshotPath);
+}
+
+} // namespace IndexedMapChecks
+} // End namespace FC
+} // End namespace AM
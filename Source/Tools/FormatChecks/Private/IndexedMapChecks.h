@@ -0,0 +1,22 @@
+#pragma once
+
+namespace AM
+{
+namespace FC
+{
+class CheckResults;
+
+namespace IndexedMapChecks
+{
+/**
+ * Generates the same map as a snapshot map and as an indexed map with each
+ * available codec, then checks that every indexed chunk decodes to the
+ * snapshot map's entry, byte for byte.
+ *
+ * Also checks that a truncated indexed map is rejected.
+ */
+void run(CheckResults& results);
+
+} // namespace IndexedMapChecks
+} // End namespace FC
+} // End namespace AM
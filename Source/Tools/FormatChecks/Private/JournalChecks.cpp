@@ -0,0 +1,220 @@
+#include "JournalChecks.h"
+#include "CheckResults.h"
+#include "EditJournalFormat.h"
+#include <SDL_stdinc.h>
+#include <cstring>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace AM
+{
+namespace FC
+{
+namespace JournalChecks
+{
+using namespace Server::EditJournalFormat;
+
+/**
+ * Returns a payload of the given size, filled with a pattern that differs
+ * per record.
+ */
+static std::vector<Uint8> makePayload(std::size_t size, Uint8 seed)
+{
+    std::vector<Uint8> payload(size);
+    for (std::size_t i{0}; i < size; ++i) {
+        payload[i] = static_cast<Uint8>((i * 31) + seed);
+    }
+    return payload;
+}
+
+/**
+ * Returns one small record of each type.
+ */
+static std::vector<Record> makeRecords()
+{
+    std::vector<Record> records{};
+    for (Uint8 type{0}; type < static_cast<Uint8>(RecordType::Count);
+         ++type) {
+        records.push_back({static_cast<RecordType>(type),
+                           (type * 1000u),
+                           makePayload((type * 7u), type)});
+    }
+    return records;
+}
+
+/**
+ * Returns a journal file holding the given records.
+ */
+static std::vector<Uint8> makeFile(const std::vector<Record>& records)
+{
+    std::vector<Uint8> fileData{};
+    appendHeader(fileData);
+    for (const Record& record : records) {
+        appendRecord(fileData, record.type, record.createdEntity,
+                     record.payload);
+    }
+    return fileData;
+}
+
+/**
+ * Returns true if the given records match the first expectedCount of the
+ * expected records.
+ */
+static bool recordsMatch(const std::vector<Record>& records,
+                         const std::vector<Record>& expectedRecords,
+                         std::size_t expectedCount)
+{
+    if (records.size() != expectedCount) {
+        return false;
+    }
+
+    for (std::size_t i{0}; i < expectedCount; ++i) {
+        const Record& record{records[i]};
+        const Record& expected{expectedRecords[i]};
+        if ((record.type != expected.type)
+            || (record.createdEntity != expected.createdEntity)
+            || (record.payload != expected.payload)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Checks that the given records survive a round trip.
+ */
+static void checkRoundTrip(const std::vector<Record>& expectedRecords,
+                           const std::string& context, CheckResults& results)
+{
+    std::vector<Uint8> fileData{makeFile(expectedRecords)};
+    std::vector<Record> records{};
+    results.check((readRecords(fileData, records) == ReadResult::Complete)
+                      && recordsMatch(records, expectedRecords,
+                                      expectedRecords.size()),
+                  context + ": records read back unchanged");
+}
+
+/**
+ * Cuts the journal off at every byte, as if we crashed mid-write, and checks
+ * that each complete record before the cut is still read.
+ */
+static void checkTruncation(CheckResults& results)
+{
+    std::vector<Record> expectedRecords{makeRecords()};
+    std::vector<Uint8> fileData{makeFile(expectedRecords)};
+
+    // Find where each record ends.
+    std::vector<std::size_t> recordEnds{};
+    std::size_t recordEnd{HEADER_SIZE};
+    for (const Record& record : expectedRecords) {
+        recordEnd += (RECORD_HEADER_SIZE + record.payload.size());
+        recordEnds.push_back(recordEnd);
+    }
+
+    std::size_t failureCount{0};
+    for (std::size_t size{0}; size < fileData.size(); ++size) {
+        std::vector<Record> records{};
+        ReadResult result{
+            readRecords(std::span{fileData.data(), size}, records)};
+
+        // Cuts inside the header lose the file. Cuts on a record boundary
+        // are indistinguishable from a complete file.
+        std::size_t completeCount{0};
+        while ((completeCount < recordEnds.size())
+               && (recordEnds[completeCount] <= size)) {
+            completeCount++;
+        }
+        ReadResult expectedResult{ReadResult::Truncated};
+        if (size < HEADER_SIZE) {
+            expectedResult = ReadResult::InvalidHeader;
+        }
+        else if ((size == HEADER_SIZE)
+                 || ((completeCount > 0)
+                     && (recordEnds[completeCount - 1] == size))) {
+            expectedResult = ReadResult::Complete;
+        }
+
+        if ((result != expectedResult)
+            || !recordsMatch(records, expectedRecords, completeCount)) {
+            failureCount++;
+        }
+    }
+    results.check((failureCount == 0),
+                  "journal: every cut keeps the records before it ("
+                      + std::to_string(failureCount) + " cuts failed)");
+}
+
+/**
+ * Checks that corrupt record headers and file headers are rejected.
+ */
+static void checkCorruption(CheckResults& results)
+{
+    std::vector<Record> expectedRecords{makeRecords()};
+    std::vector<Uint8> validFile{makeFile(expectedRecords)};
+
+    // The second record's header starts after the first record.
+    std::size_t secondRecordStart{HEADER_SIZE + RECORD_HEADER_SIZE
+                                  + expectedRecords[0].payload.size()};
+    std::size_t sizeOffset{secondRecordStart + sizeof(Uint8)
+                           + sizeof(Uint32)};
+    auto writeSize = [&](std::vector<Uint8>& fileData, Uint32 size) {
+        std::memcpy(&(fileData[sizeOffset]), &size, sizeof(size));
+    };
+
+    std::vector<Uint8> fileData{validFile};
+    fileData[secondRecordStart] = static_cast<Uint8>(RecordType::Count);
+    std::vector<Record> records{};
+    results.check((readRecords(fileData, records) == ReadResult::Corrupt)
+                      && recordsMatch(records, expectedRecords, 1),
+                  "journal: an invalid record type is rejected");
+
+    fileData = validFile;
+    writeSize(fileData, static_cast<Uint32>(MAX_PAYLOAD_SIZE + 1));
+    records.clear();
+    results.check((readRecords(fileData, records) == ReadResult::Corrupt)
+                      && recordsMatch(records, expectedRecords, 1),
+                  "journal: an oversized payload is rejected");
+
+    // A size that's allowed but runs past the end of the file should be
+    // caught before anything is allocated.
+    fileData = validFile;
+    writeSize(fileData, static_cast<Uint32>(MAX_PAYLOAD_SIZE));
+    records.clear();
+    results.check((readRecords(fileData, records) == ReadResult::Truncated)
+                      && recordsMatch(records, expectedRecords, 1),
+                  "journal: a payload past the end of the file is rejected");
+
+    fileData = validFile;
+    fileData[0] ^= 0xFF;
+    records.clear();
+    results.check((readRecords(fileData, records)
+                   == ReadResult::InvalidHeader)
+                      && records.empty(),
+                  "journal: a wrong magic value is rejected");
+
+    fileData = validFile;
+    fileData[sizeof(Uint32)] ^= 0xFF;
+    records.clear();
+    results.check((readRecords(fileData, records)
+                   == ReadResult::InvalidHeader)
+                      && records.empty(),
+                  "journal: a wrong format version is rejected");
+}
+
+void run(CheckResults& results)
+{
+    checkRoundTrip(makeRecords(), "journal, one record of each type",
+                   results);
+    checkRoundTrip({}, "journal, no records", results);
+    checkRoundTrip({{RecordType::BulkSpawn, 0xFFFFFFFF,
+                     makePayload(MAX_PAYLOAD_SIZE, 1)}},
+                   "journal, max size payload", results);
+    checkTruncation(results);
+    checkCorruption(results);
+}
+
+} // namespace JournalChecks
+} // End namespace FC
+} // End namespace AM
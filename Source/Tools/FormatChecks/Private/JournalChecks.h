@@ -0,0 +1,23 @@
+#pragma once
+
+namespace AM
+{
+namespace FC
+{
+class CheckResults;
+
+namespace JournalChecks
+{
+/**
+ * Writes edit journal records (see EditJournalFormat.h) and checks that
+ * they read back unchanged.
+ *
+ * Also checks that a journal cut off at any byte reads every complete
+ * record before the cut, and that corrupt records and headers are
+ * rejected.
+ */
+void run(CheckResults& results);
+
+} // namespace JournalChecks
+} // End namespace FC
+} // End namespace AM
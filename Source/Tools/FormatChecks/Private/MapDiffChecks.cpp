@@ -0,0 +1,114 @@
+#include "MapDiffChecks.h"
+#include "CheckResults.h"
+#include "MapFixtures.h"
+#include "MapDiffer.h"
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+namespace AM
+{
+namespace FC
+{
+namespace MapDiffChecks
+{
+/** The fixtures' shared seed. Only the density differs, so some chunks
+    change and the rest stay the same. */
+static constexpr Uint32 FIXTURE_SEED{12345};
+static constexpr float BASE_DENSITY{0.1f};
+static constexpr float TARGET_DENSITY{0.4f};
+
+/**
+ * Checks that diffing the given maps and applying the result to the base
+ * map reproduces the target map.
+ *
+ * @param expectChanges If true, the maps are expected to differ.
+ */
+static void checkRoundTrip(const std::string& basePath,
+                           const std::string& targetPath, ChunkCodec codec,
+                           bool expectChanges, const std::string& context,
+                           CheckResults& results)
+{
+    std::string diffPath{basePath + ".diff"};
+    std::string outputPath{basePath + ".patched"};
+    MD::MapDiffer mapDiffer{};
+    if (!results.check(
+            mapDiffer.createDiff(basePath, targetPath, diffPath, codec),
+            context + ": diff is created")) {
+        return;
+    }
+    if (expectChanges) {
+        results.check((mapDiffer.getChangedCount() > 0),
+                      context + ": diff holds changed chunks");
+    }
+    else {
+        results.check((mapDiffer.getChangedCount() == 0)
+                          && (mapDiffer.getRemovedCount() == 0),
+                      context + ": diff is empty");
+    }
+
+    results.check(mapDiffer.applyDiff(basePath, diffPath, outputPath)
+                      && MapFixtures::filesMatch(outputPath, targetPath),
+                  context + ": patched map matches the target map");
+
+    std::filesystem::remove(diffPath);
+    std::filesystem::remove(outputPath);
+}
+
+/**
+ * Checks that a diff from the given base map is refused by the given other
+ * map.
+ */
+static void checkWrongBaseIsRefused(const std::string& basePath,
+                                    const std::string& targetPath,
+                                    CheckResults& results)
+{
+    std::string diffPath{basePath + ".diff"};
+    std::string outputPath{basePath + ".patched"};
+    MD::MapDiffer mapDiffer{};
+    if (!results.check(mapDiffer.createDiff(basePath, targetPath, diffPath,
+                                            ChunkCodec::RunLength),
+                       "map diff, wrong base: diff is created")) {
+        return;
+    }
+
+    results.check(!(mapDiffer.applyDiff(targetPath, diffPath, outputPath))
+                      && !(std::filesystem::exists(outputPath)),
+                  "map diff, wrong base: diff is refused");
+
+    std::filesystem::remove(diffPath);
+    std::filesystem::remove(outputPath);
+}
+
+void run(CheckResults& results)
+{
+    std::string basePath{MapFixtures::generate("FormatChecks_DiffBase.bin",
+                                               FIXTURE_SEED, BASE_DENSITY,
+                                               MG::OutputFormat::Snapshot)};
+    std::string targetPath{MapFixtures::generate(
+        "FormatChecks_DiffTarget.bin", FIXTURE_SEED, TARGET_DENSITY,
+        MG::OutputFormat::Snapshot)};
+
+    for (ChunkCodec codec : {ChunkCodec::None, ChunkCodec::RunLength,
+                             ChunkCodec::LZ4, ChunkCodec::Zstd}) {
+        std::string context{std::string{"map diff ("}
+                            + ChunkCodecs::toString(codec) + ")"};
+        if (!ChunkCodecs::isAvailable(codec)) {
+            std::printf("  Skipped %s: not available in this build.\n",
+                        context.c_str());
+            continue;
+        }
+
+        checkRoundTrip(basePath, targetPath, codec, true, context, results);
+    }
+    checkRoundTrip(basePath, basePath, ChunkCodec::RunLength, false,
+                   "map diff, identical maps", results);
+    checkWrongBaseIsRefused(basePath, targetPath, results);
+
+    std::filesystem::remove(basePath);
+    std::filesystem::remove(targetPath);
+}
+
+} // namespace MapDiffChecks
+} // End namespace FC
+} // End namespace AM
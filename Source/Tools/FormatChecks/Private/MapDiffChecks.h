@@ -0,0 +1,23 @@
+#pragma once
+
+namespace AM
+{
+namespace FC
+{
+class CheckResults;
+
+namespace MapDiffChecks
+{
+/**
+ * Generates two maps that share a seed but differ in density, diffs them
+ * with each available codec, and checks that applying the diff to the base
+ * map reproduces the target map byte for byte.
+ *
+ * Also checks that a diff of identical maps is empty, and that a diff is
+ * refused by any map other than its base.
+ */
+void run(CheckResults& results);
+
+} // namespace MapDiffChecks
+} // End namespace FC
+} // End namespace AM
@@ -0,0 +1,54 @@
+#include "MapFixtures.h"
+#include "MappedFile.h"
+#include "Paths.h"
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+namespace AM
+{
+namespace FC
+{
+namespace MapFixtures
+{
+std::string generate(const std::string& fileName, Uint32 seed, float density,
+                     MG::OutputFormat outputFormat, ChunkCodec codec)
+{
+    MG::MapGenerator mapGenerator{X_LENGTH_CHUNKS,
+                                  Y_LENGTH_CHUNKS,
+                                  1,
+                                  0,
+                                  TERRAIN_GRAPHIC_SET_ID,
+                                  std::max(std::thread::hardware_concurrency(),
+                                           1U)};
+    MG::ProceduralSettings proceduralSettings{};
+    proceduralSettings.isEnabled = true;
+    proceduralSettings.seed = seed;
+    proceduralSettings.density = density;
+    proceduralSettings.floorGraphicSetID = FLOOR_GRAPHIC_SET_ID;
+    proceduralSettings.wallGraphicSetID = WALL_GRAPHIC_SET_ID;
+    proceduralSettings.objectGraphicSetID = OBJECT_GRAPHIC_SET_ID;
+    mapGenerator.setProceduralSettings(proceduralSettings);
+    mapGenerator.setOutputFormat(outputFormat);
+    mapGenerator.setChunkCodec(codec);
+    mapGenerator.generateAndSave(fileName);
+
+    return Paths::BASE_PATH + fileName;
+}
+
+bool filesMatch(const std::string& pathA, const std::string& pathB)
+{
+    MappedFile fileA{};
+    MappedFile fileB{};
+    if (!(fileA.open(pathA)) || !(fileB.open(pathB))) {
+        return false;
+    }
+
+    return (fileA.getSize() == fileB.getSize())
+           && (std::memcmp(fileA.getData(), fileB.getData(), fileA.getSize())
+               == 0);
+}
+
+} // namespace MapFixtures
+} // End namespace FC
+} // End namespace AM
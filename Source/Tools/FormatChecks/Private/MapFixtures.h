@@ -0,0 +1,45 @@
+#pragma once
+
+#include "MapGenerator.h"
+#include "ChunkCodec.h"
+#include <SDL_stdinc.h>
+#include <string>
+
+namespace AM
+{
+namespace FC
+{
+namespace MapFixtures
+{
+/** The graphic sets to generate fixtures with. They don't need to exist,
+    since the maps are never loaded by the engine. */
+inline const std::string TERRAIN_GRAPHIC_SET_ID{"check_terrain"};
+inline const std::string FLOOR_GRAPHIC_SET_ID{"check_floor"};
+inline const std::string WALL_GRAPHIC_SET_ID{"check_wall"};
+inline const std::string OBJECT_GRAPHIC_SET_ID{"check_object"};
+
+/** The map's lengths, in chunks. Large enough to hold a mix of flat and
+    built-up chunks. */
+static constexpr Uint16 X_LENGTH_CHUNKS{8};
+static constexpr Uint16 Y_LENGTH_CHUNKS{8};
+
+/**
+ * Generates a procedural map with the given settings.
+ *
+ * The same settings always produce the same map, so fixtures in different
+ * formats hold the same chunks.
+ *
+ * @return The generated file's path.
+ */
+std::string generate(const std::string& fileName, Uint32 seed, float density,
+                     MG::OutputFormat outputFormat,
+                     ChunkCodec codec = ChunkCodec::None);
+
+/**
+ * Returns true if the files at the given paths have identical contents.
+ */
+bool filesMatch(const std::string& pathA, const std::string& pathB);
+
+} // namespace MapFixtures
+} // End namespace FC
+} // End namespace AM
@@ -2,7 +2,10 @@
 #include "Timer.h"
 
 #include <cstdint>
+#include <cstring>
+#include <algorithm>
 #include <iostream>
+#include <thread>
 
 using namespace AM;
 using namespace AM::MG;
@@ -11,8 +14,206 @@ const int MAX_X_LENGTH{64};
 const int MAX_Y_LENGTH{64};
 const int MAX_Z_LENGTH{10};
 
-int main(int, char**)
+/** The max axis lengths when running from the command line. Chunks are
+    streamed to disk, so these are only limited by the file format. */
+const int MAX_CLI_LENGTH{1024};
+
+void printUsage()
+{
+    std::printf(
+        "Usage: GenerateMap.exe\n"
+        "  Asks for each parameter interactively.\n"
+        "Usage: GenerateMap.exe --size <X> <Y> <Z> --ground <Z> --graphic-set "
+        "<ID> [--threads <Count>] [--output <FileName>]\n"
+        "       [--format <snapshot|indexed>] [--codec <none|rle|lz4|zstd>]\n"
+        "       [--seed <Seed> [--density <0-1>] [--floor-set <ID>] "
+        "[--wall-set <ID>] [--object-set <ID>]]\n"
+        "  Generates the map without prompting. Lengths are in chunks.\n"
+        "  The snapshot format is loadable by the engine. The indexed format "
+        "is for tools, see ConvertTileMap.\n"
+        "  The codec compresses each chunk of an indexed map.\n"
+        "  If a seed is given, generates procedural terrain using the "
+        "ground graphic set, and places any given floor, wall, and object "
+        "sets.\n");
+    std::fflush(stdout);
+}
+
+/**
+ * Parses the given string as a whole number in [min, max].
+ * @return true if successful, else false.
+ */
+bool parseInt(const char* string, int min, int max, int& outValue)
+{
+    char* end;
+    long value{std::strtol(string, &end, 10)};
+    if ((*end != '\0') || (value < min) || (value > max)) {
+        return false;
+    }
+
+    outValue = static_cast<int>(value);
+    return true;
+}
+
+/**
+ * Generates the map using the given command line arguments.
+ */
+int generateFromArguments(int argc, char** argv)
+{
+    int mapLengthX{0};
+    int mapLengthY{0};
+    int mapLengthZ{0};
+    int groundLevel{-1};
+    std::string fillGraphicSetID{""};
+    int threadCount{
+        static_cast<int>(std::max(std::thread::hardware_concurrency(), 1U))};
+    std::string fileName{"TileMap.bin"};
+    ProceduralSettings proceduralSettings{};
+    OutputFormat outputFormat{OutputFormat::Snapshot};
+    ChunkCodec chunkCodec{ChunkCodec::None};
+
+    for (int i{1}; i < argc; ++i) {
+        int remainingArgs{argc - i - 1};
+        if ((std::strcmp(argv[i], "--size") == 0) && (remainingArgs >= 3)) {
+            if (!parseInt(argv[i + 1], 1, MAX_CLI_LENGTH, mapLengthX)
+                || !parseInt(argv[i + 2], 1, MAX_CLI_LENGTH, mapLengthY)
+                || !parseInt(argv[i + 3], 1, MAX_CLI_LENGTH, mapLengthZ)) {
+                std::printf("Invalid size. Valid values: 1 - %d\n",
+                            MAX_CLI_LENGTH);
+                return 1;
+            }
+            i += 3;
+        }
+        else if ((std::strcmp(argv[i], "--ground") == 0)
+                 && (remainingArgs >= 1)) {
+            if (!parseInt(argv[++i], 0, (MAX_CLI_LENGTH - 1), groundLevel)) {
+                std::printf("Invalid ground level.\n");
+                return 1;
+            }
+        }
+        else if ((std::strcmp(argv[i], "--graphic-set") == 0)
+                 && (remainingArgs >= 1)) {
+            fillGraphicSetID = argv[++i];
+        }
+        else if ((std::strcmp(argv[i], "--threads") == 0)
+                 && (remainingArgs >= 1)) {
+            if (!parseInt(argv[++i], 1, 256, threadCount)) {
+                std::printf("Invalid thread count.\n");
+                return 1;
+            }
+        }
+        else if ((std::strcmp(argv[i], "--output") == 0)
+                 && (remainingArgs >= 1)) {
+            fileName = argv[++i];
+        }
+        else if ((std::strcmp(argv[i], "--format") == 0)
+                 && (remainingArgs >= 1)) {
+            std::string format{argv[++i]};
+            if (format == "snapshot") {
+                outputFormat = OutputFormat::Snapshot;
+            }
+            else if (format == "indexed") {
+                outputFormat = OutputFormat::Indexed;
+            }
+            else {
+                std::printf("Invalid format. Valid values: snapshot, "
+                            "indexed\n");
+                return 1;
+            }
+        }
+        else if ((std::strcmp(argv[i], "--codec") == 0)
+                 && (remainingArgs >= 1)) {
+            if (!ChunkCodecs::fromString(argv[++i], chunkCodec)) {
+                std::printf(
+                    "Invalid codec. Valid values: none, rle, lz4, zstd\n");
+                return 1;
+            }
+            else if (!ChunkCodecs::isAvailable(chunkCodec)) {
+                std::printf("Codec \"%s\" isn't available in this build.\n",
+                            argv[i]);
+                return 1;
+            }
+        }
+        else if ((std::strcmp(argv[i], "--seed") == 0)
+                 && (remainingArgs >= 1)) {
+            char* end;
+            unsigned long seed{std::strtoul(argv[++i], &end, 10)};
+            if (*end != '\0') {
+                std::printf("Invalid seed.\n");
+                return 1;
+            }
+            proceduralSettings.isEnabled = true;
+            proceduralSettings.seed = static_cast<uint32_t>(seed);
+        }
+        else if ((std::strcmp(argv[i], "--density") == 0)
+                 && (remainingArgs >= 1)) {
+            char* end;
+            float density{std::strtof(argv[++i], &end)};
+            if ((*end != '\0') || (density < 0) || (density > 1)) {
+                std::printf("Invalid density. Valid values: 0 - 1\n");
+                return 1;
+            }
+            proceduralSettings.density = density;
+        }
+        else if ((std::strcmp(argv[i], "--floor-set") == 0)
+                 && (remainingArgs >= 1)) {
+            proceduralSettings.floorGraphicSetID = argv[++i];
+        }
+        else if ((std::strcmp(argv[i], "--wall-set") == 0)
+                 && (remainingArgs >= 1)) {
+            proceduralSettings.wallGraphicSetID = argv[++i];
+        }
+        else if ((std::strcmp(argv[i], "--object-set") == 0)
+                 && (remainingArgs >= 1)) {
+            proceduralSettings.objectGraphicSetID = argv[++i];
+        }
+        else {
+            std::printf("Unknown or incomplete argument: %s\n", argv[i]);
+            printUsage();
+            return 1;
+        }
+    }
+
+    if ((mapLengthX == 0) || (groundLevel < 0) || fillGraphicSetID.empty()) {
+        std::printf("Missing a required argument.\n");
+        printUsage();
+        return 1;
+    }
+    else if (groundLevel > (mapLengthZ - 1)) {
+        std::printf("Ground level must be less than the Z length.\n");
+        return 1;
+    }
+    else if ((chunkCodec != ChunkCodec::None)
+             && (outputFormat != OutputFormat::Indexed)) {
+        std::printf("A codec can only be used with the indexed format.\n");
+        return 1;
+    }
+
+    Timer timer{};
+    MapGenerator mapGenerator(
+        static_cast<uint16_t>(mapLengthX), static_cast<uint16_t>(mapLengthY),
+        static_cast<uint16_t>(mapLengthZ), static_cast<uint16_t>(groundLevel),
+        fillGraphicSetID, static_cast<unsigned int>(threadCount));
+    if (proceduralSettings.isEnabled) {
+        mapGenerator.setProceduralSettings(proceduralSettings);
+    }
+    mapGenerator.setOutputFormat(outputFormat);
+    mapGenerator.setChunkCodec(chunkCodec);
+    mapGenerator.generateAndSave(fileName);
+
+    double timeTaken{timer.getTime()};
+    std::printf("Map generated and saved in %.6fs.\n", timeTaken);
+    std::fflush(stdout);
+
+    return 0;
+}
+
+int main(int argc, char** argv)
 {
+    // If we were given arguments, run non-interactively.
+    if (argc > 1) {
+        return generateFromArguments(argc, argv);
+    }
+
     std::printf("##################################\n");
     std::printf("## Amalgam Engine Map Generator ##\n");
     std::printf("##################################\n");
@@ -98,7 +299,7 @@ int main(int, char**)
     MapGenerator mapGenerator(
         static_cast<uint16_t>(mapLengthX), static_cast<uint16_t>(mapLengthY),
         static_cast<uint16_t>(mapLengthZ), static_cast<uint16_t>(groundLevel),
-        fillGraphicSetID);
+        fillGraphicSetID, std::thread::hardware_concurrency());
     mapGenerator.generateAndSave("TileMap.bin");
 
     double timeTaken{timer.getTime()};
@@ -1,9 +1,16 @@
 #include "MapGenerator.h"
 #include "Paths.h"
-#include "TileMapSnapshot.h"
+#include "TileMapStreamWriter.h"
+#include "IndexedTileMapWriter.h"
 #include "ChunkExtent.h"
-#include "Serialize.h"
+#include "Terrain.h"
+#include "Wall.h"
+#include "Rotation.h"
 #include "Log.h"
+#include <thread>
+#include <algorithm>
+#include <cmath>
+#include <vector>
 
 namespace AM
 {
@@ -11,53 +18,239 @@ namespace MG
 {
 MapGenerator::MapGenerator(uint16_t inMapLengthX, uint16_t inMapLengthY,
                            uint16_t inMapLengthZ, uint16_t inGroundLevel,
-                           const std::string& inFillGraphicSetID)
+                           const std::string& inFillGraphicSetID,
+                           unsigned int inThreadCount)
 : mapXLength{inMapLengthX}
 , mapYLength{inMapLengthY}
 , mapZLength{inMapLengthZ}
 , groundLevel{inGroundLevel}
 , fillGraphicSetID{inFillGraphicSetID}
+, threadCount{std::max(inThreadCount, 1U)}
+, chunkCount{static_cast<std::size_t>(mapXLength) * mapYLength}
+, nextChunkIndex{0}
+, proceduralSettings{}
+, noiseGenerator{0}
+, outputFormat{OutputFormat::Snapshot}
+, chunkCodec{ChunkCodec::None}
 {
 }
 
 void MapGenerator::generateAndSave(const std::string& fileName)
 {
-    // Fill the map's version and size.
-    TileMapSnapshot mapSnapshot{};
-    mapSnapshot.version = MAP_FORMAT_VERSION;
-    mapSnapshot.xLengthChunks = mapXLength;
-    mapSnapshot.yLengthChunks = mapYLength;
-    mapSnapshot.zLengthChunks = mapZLength;
+    // Note: We only generate the ground level, so there's one chunk per
+    //       (x, y) column.
+    std::string filePath{Paths::BASE_PATH + fileName};
+    std::size_t maxBufferedChunks{threadCount * BUFFERED_CHUNKS_PER_THREAD};
+    bool saveSuccessful{false};
+    if (outputFormat == OutputFormat::Indexed) {
+        IndexedTileMapWriter writer{filePath,   MAP_FORMAT_VERSION,
+                                    mapXLength, mapYLength,
+                                    mapZLength, chunkCount,
+                                    maxBufferedChunks, chunkCodec};
+        if (!(writer.isOpen())) {
+            LOG_FATAL("Failed to open the map file for writing.");
+        }
 
-    // Fill in the ground tiles.
-    ChunkExtent mapChunkExtent{
-        ChunkExtent::fromMapLengths(mapXLength, mapYLength, mapZLength)};
-    for (int x{mapChunkExtent.x}; x <= mapChunkExtent.xMax(); ++x) {
-        for (int y{mapChunkExtent.y}; y <= mapChunkExtent.yMax(); ++y) {
-            ChunkPosition chunkPosition{x, y, groundLevel};
-            ChunkSnapshot& chunkSnapshot{mapSnapshot.chunks[chunkPosition]};
-
-            // Push the terrain that we're filling the map with into this 
-            // chunk's palette.
-            chunkSnapshot.getPaletteIndex(TileLayer::Type::Terrain,
-                                          fillGraphicSetID, Terrain::Flat);
-
-            // Push the palette index of the graphic into each tile.
-            for (std::size_t i{0}; i < SharedConfig::CHUNK_TILE_COUNT;
-                 ++i) {
-                chunkSnapshot.tileLayerCounts[i] = 1;
-                chunkSnapshot.tileLayers.push_back(0);
+        generateAllChunks([&](std::size_t chunkIndex,
+                              const ChunkPosition& chunkPosition,
+                              ChunkSnapshot& chunkSnapshot,
+                              std::vector<Uint8>& buffer) {
+            // Compress on this worker thread, so the writer only copies.
+            IndexedTileMapWriter::EncodedChunk encodedChunk{};
+            if (!(writer.encodeChunk(chunkSnapshot, buffer, encodedChunk))) {
+                LOG_FATAL("Failed to compress a chunk.");
             }
+            writer.writeChunk(chunkIndex, chunkPosition,
+                              std::move(encodedChunk));
+        });
+        saveSuccessful = writer.finish();
+    }
+    else {
+        // Open the file and write the map's version and size.
+        TileMapStreamWriter writer{filePath,   MAP_FORMAT_VERSION,
+                                   mapXLength, mapYLength,
+                                   mapZLength, chunkCount,
+                                   maxBufferedChunks};
+        if (!(writer.isOpen())) {
+            LOG_FATAL("Failed to open the map file for writing.");
         }
+
+        generateAllChunks([&](std::size_t chunkIndex,
+                              const ChunkPosition& chunkPosition,
+                              ChunkSnapshot& chunkSnapshot,
+                              std::vector<Uint8>& buffer) {
+            std::size_t entrySize{TileMapStreamWriter::serializeChunkEntry(
+                chunkPosition, chunkSnapshot, buffer)};
+            writer.writeChunkEntry(
+                chunkIndex, std::vector<Uint8>(buffer.begin(),
+                                               (buffer.begin() + entrySize)));
+        });
+        saveSuccessful = writer.finish();
     }
 
-    // Serialize the map snapshot and write it to the file.
-    bool saveSuccessful{
-        Serialize::toFile((Paths::BASE_PATH + fileName), mapSnapshot)};
     if (!saveSuccessful) {
         LOG_FATAL("Failed to serialize and save the map.");
     }
 }
 
+void MapGenerator::setProceduralSettings(
+    const ProceduralSettings& inProceduralSettings)
+{
+    proceduralSettings = inProceduralSettings;
+    noiseGenerator = NoiseGenerator{proceduralSettings.seed};
+}
+
+void MapGenerator::setOutputFormat(OutputFormat inOutputFormat)
+{
+    outputFormat = inOutputFormat;
+}
+
+void MapGenerator::setChunkCodec(ChunkCodec inChunkCodec)
+{
+    chunkCodec = inChunkCodec;
+}
+
+void MapGenerator::generateAllChunks(const WriteChunkFunction& writeChunk)
+{
+    // Generate the chunks, using this thread as one of the workers.
+    nextChunkIndex = 0;
+    std::vector<std::thread> workerThreads{};
+    for (unsigned int i{1}; i < threadCount; ++i) {
+        workerThreads.emplace_back(&MapGenerator::generateChunks, this,
+                                   std::cref(writeChunk));
+    }
+    generateChunks(writeChunk);
+    for (std::thread& workerThread : workerThreads) {
+        workerThread.join();
+    }
+}
+
+void MapGenerator::generateChunks(const WriteChunkFunction& writeChunk)
+{
+    ChunkExtent mapChunkExtent{
+        ChunkExtent::fromMapLengths(mapXLength, mapYLength, mapZLength)};
+    std::vector<Uint8> buffer{};
+    while (true) {
+        std::size_t chunkIndex{nextChunkIndex++};
+        if (chunkIndex >= chunkCount) {
+            return;
+        }
+
+        // Generate the chunk.
+        ChunkPosition chunkPosition{
+            (mapChunkExtent.x + static_cast<int>(chunkIndex / mapYLength)),
+            (mapChunkExtent.y + static_cast<int>(chunkIndex % mapYLength)),
+            groundLevel};
+        ChunkSnapshot chunkSnapshot{};
+        if (proceduralSettings.isEnabled) {
+            generateProceduralChunk(chunkPosition, chunkSnapshot);
+        }
+        else {
+            generateChunk(chunkPosition, chunkSnapshot);
+        }
+
+        // Serialize it and pass it to the writer.
+        writeChunk(chunkIndex, chunkPosition, chunkSnapshot, buffer);
+    }
+}
+
+void MapGenerator::generateChunk(const ChunkPosition&,
+                                 ChunkSnapshot& chunkSnapshot)
+{
+    // Push the terrain that we're filling the map with into this chunk's
+    // palette.
+    chunkSnapshot.getPaletteIndex(TileLayer::Type::Terrain, fillGraphicSetID,
+                                  Terrain::Flat);
+
+    // Push the palette index of the graphic into each tile.
+    for (std::size_t i{0}; i < SharedConfig::CHUNK_TILE_COUNT; ++i) {
+        chunkSnapshot.tileLayerCounts[i] = 1;
+        chunkSnapshot.tileLayers.push_back(0);
+    }
+}
+
+void MapGenerator::generateProceduralChunk(const ChunkPosition& chunkPosition,
+                                           ChunkSnapshot& chunkSnapshot)
+{
+    static constexpr int CHUNK_WIDTH{
+        static_cast<int>(SharedConfig::CHUNK_WIDTH)};
+    int originTileX{chunkPosition.x * CHUNK_WIDTH};
+    int originTileY{chunkPosition.y * CHUNK_WIDTH};
+
+    // Generate this chunk's terrain heights.
+    NoiseGenerator::ChunkValues noiseValues{};
+    noiseGenerator.fillChunk(originTileX, originTileY, noiseValues);
+
+    float density{std::clamp(proceduralSettings.density, 0.f, 1.f)};
+    for (std::size_t i{0}; i < SharedConfig::CHUNK_TILE_COUNT; ++i) {
+        int tileX{originTileX + static_cast<int>(i % CHUNK_WIDTH)};
+        int tileY{originTileY + static_cast<int>(i / CHUNK_WIDTH)};
+        Uint8 layerCount{0};
+
+        // Add the terrain.
+        int heightStep{static_cast<int>(
+            (noiseValues[i] - FLAT_THRESHOLD) * HEIGHT_STEPS_PER_UNIT)};
+        auto height{static_cast<Terrain::Height>(std::clamp(
+            heightStep, 0, static_cast<int>(Terrain::Height::Full)))};
+        chunkSnapshot.tileLayers.push_back(chunkSnapshot.getPaletteIndex(
+            TileLayer::Type::Terrain, fillGraphicSetID,
+            static_cast<Uint8>(Terrain::toValue(height, Terrain::Flat))));
+        layerCount++;
+
+        // Only build on flat ground.
+        if (height != Terrain::Flat) {
+            chunkSnapshot.tileLayerCounts[i] = layerCount;
+            continue;
+        }
+
+        // If this tile is in a room, add its floor and any edge walls.
+        // Note: Rooms are aligned to a grid, so the decision is shared by
+        //       every tile in the room, even across chunks.
+        int roomX{static_cast<int>(std::floor(tileX / float{ROOM_WIDTH}))};
+        int roomY{static_cast<int>(std::floor(tileY / float{ROOM_WIDTH}))};
+        bool isInRoom{noiseGenerator.hashToUnit(roomX, roomY, ROOM_SALT)
+                      < density};
+        if (isInRoom) {
+            if (!(proceduralSettings.floorGraphicSetID.empty())) {
+                chunkSnapshot.tileLayers.push_back(
+                    chunkSnapshot.getPaletteIndex(
+                        TileLayer::Type::Floor,
+                        proceduralSettings.floorGraphicSetID, 0));
+                layerCount++;
+            }
+
+            if (!(proceduralSettings.wallGraphicSetID.empty())) {
+                if ((tileX - (roomX * ROOM_WIDTH)) == 0) {
+                    chunkSnapshot.tileLayers.push_back(
+                        chunkSnapshot.getPaletteIndex(
+                            TileLayer::Type::Wall,
+                            proceduralSettings.wallGraphicSetID,
+                            Wall::Type::West));
+                    layerCount++;
+                }
+                if ((tileY - (roomY * ROOM_WIDTH)) == 0) {
+                    chunkSnapshot.tileLayers.push_back(
+                        chunkSnapshot.getPaletteIndex(
+                            TileLayer::Type::Wall,
+                            proceduralSettings.wallGraphicSetID,
+                            Wall::Type::North));
+                    layerCount++;
+                }
+            }
+        }
+        // Otherwise, maybe add an object.
+        else if (!(proceduralSettings.objectGraphicSetID.empty())
+                 && (noiseGenerator.hashToUnit(tileX, tileY, OBJECT_SALT)
+                     < (density * OBJECT_DENSITY_SCALE))) {
+            chunkSnapshot.tileLayers.push_back(chunkSnapshot.getPaletteIndex(
+                TileLayer::Type::Object, proceduralSettings.objectGraphicSetID,
+                Rotation::Direction::South));
+            layerCount++;
+        }
+
+        chunkSnapshot.tileLayerCounts[i] = layerCount;
+    }
+}
+
 } // End namespace MG
 } // End namespace AM
@@ -1,21 +1,64 @@
 #pragma once
 
+#include "ChunkPosition.h"
+#include "TileMapSnapshot.h"
+#include "NoiseGenerator.h"
+#include "ChunkCodec.h"
 #include <string>
 #include <cstdint>
+#include <SDL_stdinc.h>
+#include <atomic>
+#include <functional>
+#include <vector>
 
 namespace AM
 {
 namespace MG
 {
+/**
+ * Settings for procedural generation.
+ */
+struct ProceduralSettings {
+    /** If false, the map is filled with flat terrain. */
+    bool isEnabled{false};
+
+    /** The seed for all random generation. The same seed and settings will
+        always produce the same map. */
+    uint32_t seed{0};
+
+    /** How densely floors, walls, and objects are placed, in [0, 1]. */
+    float density{0.1f};
+
+    /** The graphic sets to place. If a set is empty, that layer type won't
+        be placed. */
+    std::string floorGraphicSetID{};
+    std::string wallGraphicSetID{};
+    std::string objectGraphicSetID{};
+};
+
+/**
+ * The file formats that the map can be saved in.
+ */
+enum class OutputFormat {
+    /** A single serialized TileMapSnapshot. Loadable by the engine. */
+    Snapshot,
+    /** An indexed map. See IndexedTileMapFormat.h. */
+    Indexed
+};
+
 /**
  * Generates the TileMap.bin file based on the given parameters.
+ *
+ * Chunks are generated in parallel and streamed to the file as they finish,
+ * so the whole map is never held in memory.
  */
 class MapGenerator
 {
 public:
     MapGenerator(uint16_t inMapLengthX, uint16_t inMapLengthY,
                  uint16_t inMapLengthZ, uint16_t inGroundLevel,
-                 const std::string& inFillGraphicSetID);
+                 const std::string& inFillGraphicSetID,
+                 unsigned int inThreadCount);
 
     /**
      * Generates the map and saves it to a file with the given name, placed in
@@ -23,11 +66,84 @@ public:
      */
     void generateAndSave(const std::string& fileName);
 
+    /**
+     * Enables procedural generation with the given settings.
+     * If not called, the map will be filled with flat terrain.
+     */
+    void setProceduralSettings(const ProceduralSettings& inProceduralSettings);
+
+    /**
+     * Sets the format to save the map in. Defaults to Snapshot.
+     */
+    void setOutputFormat(OutputFormat inOutputFormat);
+
+    /**
+     * Sets the codec to compress chunks with. Only used by the Indexed
+     * format. Defaults to None.
+     */
+    void setChunkCodec(ChunkCodec inChunkCodec);
+
 private:
     /** The version of the map format. Kept as just a 16-bit int for now, we
         can see later if we care to make it more complicated. */
     static constexpr uint16_t MAP_FORMAT_VERSION{1};
 
+    /** How many finished chunks each thread may have waiting to be written
+        before it blocks. */
+    static constexpr std::size_t BUFFERED_CHUNKS_PER_THREAD{4};
+
+    /** Noise values below this produce flat terrain. */
+    static constexpr float FLAT_THRESHOLD{0.5f};
+
+    /** How many terrain height steps each unit of noise above
+        FLAT_THRESHOLD produces. */
+    static constexpr float HEIGHT_STEPS_PER_UNIT{10.f};
+
+    /** The width, in tiles, of the square areas that floors and walls are
+        placed in. */
+    static constexpr int ROOM_WIDTH{4};
+
+    /** Objects are placed at this fraction of the density setting, since
+        they're placed per-tile instead of per-room. */
+    static constexpr float OBJECT_DENSITY_SCALE{0.25f};
+
+    /** Salts for each placement decision, so they aren't correlated. */
+    static constexpr uint32_t ROOM_SALT{101};
+    static constexpr uint32_t OBJECT_SALT{102};
+
+    /** Serializes the given chunk (using the given buffer) and passes it
+        to a writer. Must be thread-safe. */
+    using WriteChunkFunction
+        = std::function<void(std::size_t chunkIndex,
+                             const ChunkPosition& chunkPosition,
+                             ChunkSnapshot& chunkSnapshot,
+                             std::vector<Uint8>& buffer)>;
+
+    /**
+     * Generates every chunk on threadCount threads, passing each to the
+     * given function.
+     */
+    void generateAllChunks(const WriteChunkFunction& writeChunk);
+
+    /**
+     * Thread function. Generates chunks until there are none left, passing
+     * each to the given function.
+     */
+    void generateChunks(const WriteChunkFunction& writeChunk);
+
+    /**
+     * Fills the given chunk's tiles.
+     */
+    void generateChunk(const ChunkPosition& chunkPosition,
+                       ChunkSnapshot& chunkSnapshot);
+
+    /**
+     * Fills the given chunk's tiles with noise-based terrain, floors, walls,
+     * and objects.
+     */
+    void generateProceduralChunk(const ChunkPosition& chunkPosition,
+                                 ChunkSnapshot& chunkSnapshot);
+
     /** The length, in chunks, of the map's X axis. */
     uint16_t mapXLength;
 
@@ -42,6 +158,24 @@ private:
 
     /** The ID of the graphic set to fill the map with. */
     std::string fillGraphicSetID;
+
+    /** The number of threads to generate chunks on. */
+    unsigned int threadCount;
+
+    /** The total number of chunks that we'll generate. */
+    std::size_t chunkCount;
+
+    /** The index of the next chunk to generate. */
+    std::atomic<std::size_t> nextChunkIndex;
+
+    ProceduralSettings proceduralSettings;
+
+    /** Generates terrain heights. Seeded from proceduralSettings. */
+    NoiseGenerator noiseGenerator;
+
+    OutputFormat outputFormat;
+
+    ChunkCodec chunkCodec;
 };
 
 } // End namespace MG
@@ -0,0 +1,99 @@
+#include "NoiseGenerator.h"
+#include <cmath>
+
+namespace AM
+{
+namespace MG
+{
+NoiseGenerator::NoiseGenerator(uint32_t inSeed)
+: seed{inSeed}
+{
+}
+
+void NoiseGenerator::fillChunk(int originTileX, int originTileY,
+                               ChunkValues& outValues) const
+{
+    static constexpr std::size_t WIDTH{SharedConfig::CHUNK_WIDTH};
+    outValues.fill(0);
+
+    float amplitude{1};
+    float totalAmplitude{0};
+    for (int octave{0}; octave < OCTAVE_COUNT; ++octave) {
+        float cellWidth{BASE_CELL_WIDTH / static_cast<float>(1 << octave)};
+        uint32_t octaveSalt{static_cast<uint32_t>(octave)};
+
+        // Calculate each column's lattice cell and smoothed weight. These are
+        // shared by every row.
+        std::array<int, WIDTH> cellX{};
+        std::array<float, WIDTH> weightX{};
+        for (std::size_t x{0}; x < WIDTH; ++x) {
+            float position{(originTileX + static_cast<int>(x)) / cellWidth};
+            float cell{std::floor(position)};
+            float fraction{position - cell};
+            cellX[x] = static_cast<int>(cell);
+            weightX[x] = fraction * fraction * (3.f - (2.f * fraction));
+        }
+
+        for (std::size_t y{0}; y < WIDTH; ++y) {
+            float position{(originTileY + static_cast<int>(y)) / cellWidth};
+            float cell{std::floor(position)};
+            float fraction{position - cell};
+            int cellY{static_cast<int>(cell)};
+            float weightY{fraction * fraction * (3.f - (2.f * fraction))};
+
+            // Gather the corner values of each column's cell.
+            std::array<float, WIDTH> topLeft{};
+            std::array<float, WIDTH> topRight{};
+            std::array<float, WIDTH> bottomLeft{};
+            std::array<float, WIDTH> bottomRight{};
+            for (std::size_t x{0}; x < WIDTH; ++x) {
+                topLeft[x] = hashToUnit(cellX[x], cellY, octaveSalt);
+                topRight[x] = hashToUnit((cellX[x] + 1), cellY, octaveSalt);
+                bottomLeft[x] = hashToUnit(cellX[x], (cellY + 1), octaveSalt);
+                bottomRight[x]
+                    = hashToUnit((cellX[x] + 1), (cellY + 1), octaveSalt);
+            }
+
+            // Blend them.
+            float* row{&(outValues[y * WIDTH])};
+            for (std::size_t x{0}; x < WIDTH; ++x) {
+                float top{topLeft[x] + ((topRight[x] - topLeft[x]) * weightX[x])};
+                float bottom{bottomLeft[x]
+                             + ((bottomRight[x] - bottomLeft[x]) * weightX[x])};
+                row[x] += amplitude * (top + ((bottom - top) * weightY));
+            }
+        }
+
+        totalAmplitude += amplitude;
+        amplitude *= PERSISTENCE;
+    }
+
+    // Normalize back to [0, 1].
+    for (float& value : outValues) {
+        value /= totalAmplitude;
+    }
+}
+
+float NoiseGenerator::hashToUnit(int x, int y, uint32_t salt) const
+{
+    // Use the top 24 bits, since that's all a float can exactly represent.
+    return static_cast<float>(hash(x, y, salt) >> 8) / 16777216.f;
+}
+
+uint32_t NoiseGenerator::hash(int x, int y, uint32_t salt) const
+{
+    // Mix the inputs together, then avalanche the bits (murmur3's finalizer).
+    uint32_t value{seed ^ (static_cast<uint32_t>(x) * 0x8DA6B343U)
+                   ^ (static_cast<uint32_t>(y) * 0xD8163841U)
+                   ^ (salt * 0xCB1AB31FU)};
+    value ^= value >> 16;
+    value *= 0x85EBCA6BU;
+    value ^= value >> 13;
+    value *= 0xC2B2AE35U;
+    value ^= value >> 16;
+
+    return value;
+}
+
+} // End namespace MG
+} // End namespace AM
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "SharedConfig.h"
+#include <array>
+#include <cstdint>
+
+namespace AM
+{
+namespace MG
+{
+/**
+ * Generates deterministic fractal value noise over tile coordinates.
+ *
+ * The same seed always produces the same values, regardless of which thread
+ * generates which chunk.
+ */
+class NoiseGenerator
+{
+public:
+    /** One value per tile in a chunk, in row-major order. */
+    using ChunkValues = std::array<float, SharedConfig::CHUNK_TILE_COUNT>;
+
+    NoiseGenerator(uint32_t inSeed);
+
+    /**
+     * Fills the given array with noise values in [0, 1], for the chunk whose
+     * first tile is at the given coordinates.
+     *
+     * Note: Values are generated a row at a time with branch-free loops, so
+     *       the compiler can vectorize them.
+     */
+    void fillChunk(int originTileX, int originTileY,
+                   ChunkValues& outValues) const;
+
+    /**
+     * Returns a value in [0, 1) that's unique to the given coordinates and
+     * salt. Used for per-tile placement decisions.
+     */
+    float hashToUnit(int x, int y, uint32_t salt) const;
+
+private:
+    /** The number of noise layers that are summed together. */
+    static constexpr int OCTAVE_COUNT{4};
+
+    /** The width, in tiles, of the first octave's lattice cells. */
+    static constexpr float BASE_CELL_WIDTH{64.f};
+
+    /** How much each octave's amplitude is scaled relative to the last. */
+    static constexpr float PERSISTENCE{0.5f};
+
+    /**
+     * Returns a 32-bit hash of the given coordinates and salt.
+     */
+    uint32_t hash(int x, int y, uint32_t salt) const;
+
+    uint32_t seed;
+};
+
+} // End namespace MG
+} // End namespace AM
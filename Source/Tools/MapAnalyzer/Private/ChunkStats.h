@@ -0,0 +1,43 @@
+#pragma once
+
+#include "ChunkPosition.h"
+#include <SDL_stdinc.h>
+#include <array>
+
+namespace AM
+{
+namespace MA
+{
+/**
+ * The analysis results for a single chunk.
+ */
+struct ChunkStats {
+    /** The number of tile layer types. Matches TileLayer::Type. */
+    static constexpr std::size_t LAYER_TYPE_COUNT{4};
+
+    ChunkPosition chunkPosition{};
+
+    /** The total number of tile layers in the chunk. */
+    std::size_t layerCount{0};
+
+    /** The number of tile layers of each type, indexed by
+        TileLayer::Type. */
+    std::array<std::size_t, LAYER_TYPE_COUNT> layerCountsByType{};
+
+    /** The most layers in any single tile. */
+    std::size_t maxTileLayerCount{0};
+
+    /** The number of entries in the chunk's palette. */
+    std::size_t paletteSize{0};
+
+    /** The number of palette entries that no tile layer uses. These would
+        be removed by compaction. */
+    std::size_t unusedPaletteEntryCount{0};
+
+    /** The estimated size, in bytes, of the chunk's ChunkSnapshot,
+        including its heap allocations. */
+    std::size_t estimatedBytes{0};
+};
+
+} // End namespace MA
+} // End namespace AM
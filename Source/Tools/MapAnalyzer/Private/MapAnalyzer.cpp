@@ -0,0 +1,240 @@
+#include "MapAnalyzer.h"
+#include "TileMapStreamReader.h"
+#include "IndexedTileMapReader.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+namespace AM
+{
+namespace MA
+{
+MapAnalyzer::MapAnalyzer(unsigned int inThreadCount)
+: threadCount{std::max(inThreadCount, 1U)}
+, xLengthChunks{0}
+, yLengthChunks{0}
+, zLengthChunks{0}
+, chunkStats{}
+, graphicSetUsage{}
+, corruptChunks{}
+{
+}
+
+bool MapAnalyzer::analyzeSnapshotMap(const std::string& mapPath)
+{
+    TileMapStreamReader reader{};
+    if (!(reader.open(mapPath))) {
+        return false;
+    }
+    xLengthChunks = reader.getXLengthChunks();
+    yLengthChunks = reader.getYLengthChunks();
+    zLengthChunks = reader.getZLengthChunks();
+
+    // Each thread reads the next entry, then analyzes it on its own.
+    std::mutex readerMutex{};
+    std::atomic<bool> readFailed{false};
+    std::vector<ThreadResults> threadResults(threadCount);
+    auto analyzeChunks = [&](ThreadResults& results) {
+        ChunkPosition chunkPosition{};
+        ChunkSnapshot chunkSnapshot{};
+        while (true) {
+            {
+                std::scoped_lock lock{readerMutex};
+                if (readFailed || reader.isAtEnd()) {
+                    return;
+                }
+
+                chunkSnapshot = ChunkSnapshot{};
+                if (!(reader.readChunkEntry(chunkPosition, chunkSnapshot))) {
+                    readFailed = true;
+                    return;
+                }
+            }
+
+            if (!analyzeChunk(chunkPosition, chunkSnapshot, results)) {
+                results.corruptChunks.push_back(chunkPosition);
+            }
+        }
+    };
+
+    // Analyze, using this thread as one of the workers.
+    std::vector<std::thread> workerThreads{};
+    for (unsigned int i{1}; i < threadCount; ++i) {
+        workerThreads.emplace_back(analyzeChunks, std::ref(threadResults[i]));
+    }
+    analyzeChunks(threadResults[0]);
+    for (std::thread& workerThread : workerThreads) {
+        workerThread.join();
+    }
+
+    mergeResults(threadResults);
+    return !readFailed;
+}
+
+bool MapAnalyzer::analyzeIndexedMap(const std::string& mapPath)
+{
+    IndexedTileMapReader reader{};
+    if (!(reader.open(mapPath))) {
+        return false;
+    }
+    const IndexedTileMapFormat::Header& header{reader.getHeader()};
+    xLengthChunks = header.xLengthChunks;
+    yLengthChunks = header.yLengthChunks;
+    zLengthChunks = header.zLengthChunks;
+
+    // Each thread claims the next entry, then decodes and analyzes it.
+    std::span<const IndexedTileMapFormat::IndexEntry> index{reader.getIndex()};
+    std::atomic<std::size_t> nextEntryIndex{0};
+    std::atomic<bool> decodeFailed{false};
+    std::vector<ThreadResults> threadResults(threadCount);
+    auto analyzeChunks = [&](ThreadResults& results) {
+        ChunkSnapshot chunkSnapshot{};
+        std::vector<Uint8> decompressBuffer{};
+        std::size_t entryIndex{nextEntryIndex++};
+        while ((entryIndex < index.size()) && !decodeFailed) {
+            chunkSnapshot = ChunkSnapshot{};
+            if (!(reader.decodeChunk(entryIndex, chunkSnapshot,
+                                     decompressBuffer))) {
+                decodeFailed = true;
+                return;
+            }
+
+            const IndexedTileMapFormat::IndexEntry& entry{index[entryIndex]};
+            ChunkPosition chunkPosition{entry.x, entry.y, entry.z};
+            if (!analyzeChunk(chunkPosition, chunkSnapshot, results)) {
+                results.corruptChunks.push_back(chunkPosition);
+            }
+            entryIndex = nextEntryIndex++;
+        }
+    };
+
+    // Analyze, using this thread as one of the workers.
+    std::vector<std::thread> workerThreads{};
+    for (unsigned int i{1}; i < threadCount; ++i) {
+        workerThreads.emplace_back(analyzeChunks, std::ref(threadResults[i]));
+    }
+    analyzeChunks(threadResults[0]);
+    for (std::thread& workerThread : workerThreads) {
+        workerThread.join();
+    }
+
+    mergeResults(threadResults);
+    return !decodeFailed;
+}
+
+Uint16 MapAnalyzer::getXLengthChunks() const
+{
+    return xLengthChunks;
+}
+
+Uint16 MapAnalyzer::getYLengthChunks() const
+{
+    return yLengthChunks;
+}
+
+Uint16 MapAnalyzer::getZLengthChunks() const
+{
+    return zLengthChunks;
+}
+
+const std::vector<ChunkStats>& MapAnalyzer::getChunkStats() const
+{
+    return chunkStats;
+}
+
+const std::map<MapAnalyzer::GraphicSetKey, std::size_t>&
+    MapAnalyzer::getGraphicSetUsage() const
+{
+    return graphicSetUsage;
+}
+
+const std::vector<ChunkPosition>& MapAnalyzer::getCorruptChunks() const
+{
+    return corruptChunks;
+}
+
+bool MapAnalyzer::analyzeChunk(const ChunkPosition& chunkPosition,
+                               const ChunkSnapshot& chunkSnapshot,
+                               ThreadResults& results)
+{
+    ChunkStats stats{};
+    stats.chunkPosition = chunkPosition;
+    stats.layerCount = chunkSnapshot.tileLayers.size();
+    stats.paletteSize = chunkSnapshot.palette.size();
+    for (auto tileLayerCount : chunkSnapshot.tileLayerCounts) {
+        stats.maxTileLayerCount = std::max(
+            stats.maxTileLayerCount, static_cast<std::size_t>(tileLayerCount));
+    }
+
+    // Count how many layers use each palette entry.
+    std::vector<std::size_t> paletteUseCounts(chunkSnapshot.palette.size(),
+                                              0);
+    for (auto paletteIndex : chunkSnapshot.tileLayers) {
+        // If the chunk is corrupt, fail.
+        if (paletteIndex >= chunkSnapshot.palette.size()) {
+            return false;
+        }
+        paletteUseCounts[paletteIndex]++;
+    }
+
+    // Estimate the snapshot's size. Short IDs are stored inline by the
+    // small string optimization, so they only cost sizeof(std::string).
+    static const std::size_t INLINE_STRING_CAPACITY{std::string{}.capacity()};
+    stats.estimatedBytes
+        = sizeof(ChunkSnapshot)
+          + (chunkSnapshot.palette.size() * sizeof(ChunkSnapshot::PaletteEntry))
+          + (chunkSnapshot.tileLayers.size()
+             * sizeof(chunkSnapshot.tileLayers[0]));
+
+    for (std::size_t i{0}; i < chunkSnapshot.palette.size(); ++i) {
+        const ChunkSnapshot::PaletteEntry& paletteEntry{
+            chunkSnapshot.palette[i]};
+        if (paletteEntry.graphicSetID.size() > INLINE_STRING_CAPACITY) {
+            stats.estimatedBytes += paletteEntry.graphicSetID.size() + 1;
+        }
+
+        if (paletteUseCounts[i] == 0) {
+            stats.unusedPaletteEntryCount++;
+            continue;
+        }
+
+        auto layerType{static_cast<std::size_t>(paletteEntry.layerType)};
+        if (layerType < ChunkStats::LAYER_TYPE_COUNT) {
+            stats.layerCountsByType[layerType] += paletteUseCounts[i];
+        }
+        results.graphicSetUsage[{static_cast<Uint8>(layerType),
+                                 paletteEntry.graphicSetID}]
+            += paletteUseCounts[i];
+    }
+
+    results.chunkStats.push_back(stats);
+    return true;
+}
+
+void MapAnalyzer::mergeResults(std::vector<ThreadResults>& threadResults)
+{
+    chunkStats.clear();
+    graphicSetUsage.clear();
+    corruptChunks.clear();
+    for (ThreadResults& results : threadResults) {
+        chunkStats.insert(chunkStats.end(), results.chunkStats.begin(),
+                          results.chunkStats.end());
+        corruptChunks.insert(corruptChunks.end(),
+                             results.corruptChunks.begin(),
+                             results.corruptChunks.end());
+        for (const auto& [graphicSetKey, useCount] : results.graphicSetUsage) {
+            graphicSetUsage[graphicSetKey] += useCount;
+        }
+    }
+
+    // Sort the chunks so the output doesn't depend on thread timing.
+    std::sort(chunkStats.begin(), chunkStats.end(),
+              [](const ChunkStats& a, const ChunkStats& b) {
+                  return a.chunkPosition < b.chunkPosition;
+              });
+    std::sort(corruptChunks.begin(), corruptChunks.end());
+}
+
+} // End namespace MA
+} // End namespace AM
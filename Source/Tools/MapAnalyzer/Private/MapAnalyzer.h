@@ -0,0 +1,110 @@
+#pragma once
+
+#include "ChunkStats.h"
+#include "TileMapSnapshot.h"
+#include <SDL_stdinc.h>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace AM
+{
+namespace MA
+{
+/**
+ * Gathers per-chunk stats and graphic set usage from a tile map.
+ *
+ * Chunks are analyzed on multiple threads, and the map is streamed, so the
+ * whole map is never held in memory.
+ */
+class MapAnalyzer
+{
+public:
+    /** A graphic set, identified by its layer type and string ID. */
+    using GraphicSetKey = std::pair<Uint8, std::string>;
+
+    explicit MapAnalyzer(unsigned int inThreadCount);
+
+    /**
+     * Analyzes a snapshot map (TileMap.bin).
+     *
+     * Entries have to be deserialized in order to find where the next one
+     * starts, so only the analysis itself runs in parallel.
+     *
+     * @return true if successful, else false.
+     */
+    bool analyzeSnapshotMap(const std::string& mapPath);
+
+    /**
+     * Analyzes an indexed map (see IndexedTileMapFormat.h). Chunks are
+     * decoded and analyzed fully in parallel.
+     *
+     * @return true if successful, else false.
+     */
+    bool analyzeIndexedMap(const std::string& mapPath);
+
+    Uint16 getXLengthChunks() const;
+    Uint16 getYLengthChunks() const;
+    Uint16 getZLengthChunks() const;
+
+    /**
+     * Returns the stats of every chunk in the map, sorted by position.
+     */
+    const std::vector<ChunkStats>& getChunkStats() const;
+
+    /**
+     * Returns the number of tile layers that use each graphic set.
+     * Sets that are only in palettes, but not used by a tile layer, aren't
+     * included.
+     */
+    const std::map<GraphicSetKey, std::size_t>& getGraphicSetUsage() const;
+
+    /**
+     * Returns the chunks that couldn't be analyzed because they're corrupt
+     * (e.g. a tile layer refers to a palette entry that doesn't exist),
+     * sorted by position. These chunks aren't in getChunkStats().
+     */
+    const std::vector<ChunkPosition>& getCorruptChunks() const;
+
+private:
+    /**
+     * The results gathered by a single thread.
+     */
+    struct ThreadResults {
+        std::vector<ChunkStats> chunkStats{};
+        std::map<GraphicSetKey, std::size_t> graphicSetUsage{};
+        std::vector<ChunkPosition> corruptChunks{};
+    };
+
+    /**
+     * Analyzes the given chunk, adding the results to the given struct.
+     *
+     * @return true if successful. false if the chunk is corrupt, in which
+     *         case nothing is added.
+     */
+    static bool analyzeChunk(const ChunkPosition& chunkPosition,
+                             const ChunkSnapshot& chunkSnapshot,
+                             ThreadResults& results);
+
+    /**
+     * Combines each thread's results into our members.
+     */
+    void mergeResults(std::vector<ThreadResults>& threadResults);
+
+    /** The number of threads to analyze chunks on. */
+    unsigned int threadCount;
+
+    Uint16 xLengthChunks;
+    Uint16 yLengthChunks;
+    Uint16 zLengthChunks;
+
+    std::vector<ChunkStats> chunkStats;
+
+    std::map<GraphicSetKey, std::size_t> graphicSetUsage;
+
+    std::vector<ChunkPosition> corruptChunks;
+};
+
+} // End namespace MA
+} // End namespace AM
@@ -0,0 +1,360 @@
+#include "MapAnalyzer.h"
+#include "IndexedTileMapReader.h"
+#include "ChunkExtent.h"
+#include "StringTools.h"
+#include "Timer.h"
+#include "nlohmann/json.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace AM;
+using namespace AM::MA;
+
+/** The names of each tile layer type, indexed by TileLayer::Type. */
+static constexpr const char* LAYER_TYPE_NAMES[ChunkStats::LAYER_TYPE_COUNT]{
+    "Terrain", "Floor", "Wall", "Object"};
+
+/** The ResourceData.json arrays that hold each tile layer type's graphic
+    sets, indexed by TileLayer::Type. */
+static constexpr const char* GRAPHIC_SET_ARRAYS[ChunkStats::LAYER_TYPE_COUNT]{
+    "terrain", "floors", "walls", "objects"};
+
+/**
+ * Parses the given string as a whole number in [min, max].
+ * @return true if successful, else false.
+ */
+bool parseInt(const char* string, int min, int max, int& outValue)
+{
+    char* end;
+    long value{std::strtol(string, &end, 10)};
+    if ((end == string) || (*end != '\0') || (value < min) || (value > max)) {
+        return false;
+    }
+
+    outValue = static_cast<int>(value);
+    return true;
+}
+
+void printUsage()
+{
+    std::printf(
+        "Usage: MapAnalyzer.exe <MapPath> [--resources <ResourceDataPath>] "
+        "[--csv <Path>] [--heatmap <Path>] [--top <Count>] "
+        "[--threads <Count>]\n"
+        "  Reports layer counts, palette sizes, and estimated memory for "
+        "each chunk of the given map (snapshot or indexed).\n"
+        "  If ResourceData.json is given, also lists the graphic sets that "
+        "the map never uses.\n"
+        "  Writes per-chunk stats to a CSV file (default: MapStats.csv) and "
+        "a layer count heatmap to a PPM image (default: MapHeatmap.ppm), "
+        "with one pixel per chunk column.\n");
+    std::fflush(stdout);
+}
+
+/**
+ * Prints the map-wide totals.
+ */
+void printSummary(const std::vector<ChunkStats>& chunkStats)
+{
+    ChunkStats totals{};
+    for (const ChunkStats& stats : chunkStats) {
+        totals.layerCount += stats.layerCount;
+        for (std::size_t i{0}; i < ChunkStats::LAYER_TYPE_COUNT; ++i) {
+            totals.layerCountsByType[i] += stats.layerCountsByType[i];
+        }
+        totals.maxTileLayerCount
+            = std::max(totals.maxTileLayerCount, stats.maxTileLayerCount);
+        totals.paletteSize += stats.paletteSize;
+        totals.unusedPaletteEntryCount += stats.unusedPaletteEntryCount;
+        totals.estimatedBytes += stats.estimatedBytes;
+    }
+
+    std::printf("\nChunks: %zu\n", chunkStats.size());
+    std::printf("Tile layers: %zu (", totals.layerCount);
+    for (std::size_t i{0}; i < ChunkStats::LAYER_TYPE_COUNT; ++i) {
+        std::printf("%s%s: %zu", ((i == 0) ? "" : ", "), LAYER_TYPE_NAMES[i],
+                    totals.layerCountsByType[i]);
+    }
+    std::printf(")\n");
+    std::printf("Most layers in a tile: %zu\n", totals.maxTileLayerCount);
+    std::printf("Palette entries: %zu, %zu unused\n", totals.paletteSize,
+                totals.unusedPaletteEntryCount);
+    std::printf("Estimated snapshot memory: %.2f MiB\n",
+                (totals.estimatedBytes / (1024.0 * 1024.0)));
+}
+
+/**
+ * Prints the chunks with the most tile layers.
+ */
+void printDensestChunks(const std::vector<ChunkStats>& chunkStats,
+                        std::size_t count)
+{
+    std::vector<const ChunkStats*> densestChunks{};
+    for (const ChunkStats& stats : chunkStats) {
+        densestChunks.push_back(&stats);
+    }
+    count = std::min(count, densestChunks.size());
+    std::partial_sort(densestChunks.begin(), (densestChunks.begin() + count),
+                      densestChunks.end(),
+                      [](const ChunkStats* a, const ChunkStats* b) {
+                          return a->layerCount > b->layerCount;
+                      });
+
+    std::printf("\nDensest chunks:\n");
+    std::printf("  %-18s %8s %8s %8s %10s\n", "Position", "Layers",
+                "Palette", "Unused", "Est. bytes");
+    for (std::size_t i{0}; i < count; ++i) {
+        const ChunkStats& stats{*(densestChunks[i])};
+        std::string position{std::to_string(stats.chunkPosition.x) + ", "
+                             + std::to_string(stats.chunkPosition.y) + ", "
+                             + std::to_string(stats.chunkPosition.z)};
+        std::printf("  %-18s %8zu %8zu %8zu %10zu\n", position.c_str(),
+                    stats.layerCount, stats.paletteSize,
+                    stats.unusedPaletteEntryCount, stats.estimatedBytes);
+    }
+}
+
+/**
+ * Prints the graphic sets in the given ResourceData.json that the map
+ * doesn't use.
+ * @return true if successful, else false.
+ */
+bool printUnusedGraphicSets(
+    const std::string& resourceDataPath,
+    const std::map<MapAnalyzer::GraphicSetKey, std::size_t>& graphicSetUsage)
+{
+    std::ifstream file{resourceDataPath};
+    if (!(file.is_open())) {
+        std::printf("Failed to open %s\n", resourceDataPath.c_str());
+        return false;
+    }
+
+    // Gather every tile graphic set's string ID.
+    std::set<MapAnalyzer::GraphicSetKey> graphicSets{};
+    try {
+        nlohmann::json json = nlohmann::json::parse(file, nullptr, true, true);
+        for (std::size_t i{0}; i < ChunkStats::LAYER_TYPE_COUNT; ++i) {
+            for (auto& graphicSetJson : json.at(GRAPHIC_SET_ARRAYS[i])) {
+                std::string stringID{};
+                StringTools::deriveStringID(
+                    graphicSetJson.at("displayName").get<std::string>(),
+                    stringID);
+                graphicSets.insert({static_cast<Uint8>(i), stringID});
+            }
+        }
+    } catch (nlohmann::json::exception& e) {
+        std::printf("Failed to parse %s: %s\n", resourceDataPath.c_str(),
+                    e.what());
+        return false;
+    }
+
+    std::printf("\nUnused graphic sets:\n");
+    std::size_t unusedCount{0};
+    for (const MapAnalyzer::GraphicSetKey& graphicSet : graphicSets) {
+        if (!(graphicSetUsage.contains(graphicSet))) {
+            std::printf("  %s: %s\n", LAYER_TYPE_NAMES[graphicSet.first],
+                        graphicSet.second.c_str());
+            unusedCount++;
+        }
+    }
+    if (unusedCount == 0) {
+        std::printf("  None\n");
+    }
+
+    // Sets that the map uses, but that no longer exist, will fail to load.
+    for (const auto& [graphicSet, useCount] : graphicSetUsage) {
+        if (!(graphicSets.contains(graphicSet))) {
+            std::printf("Warning: Map uses missing %s graphic set \"%s\" in "
+                        "%zu tile layers.\n",
+                        LAYER_TYPE_NAMES[graphicSet.first],
+                        graphicSet.second.c_str(), useCount);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Writes every chunk's stats to a CSV file.
+ * @return true if successful, else false.
+ */
+bool writeCsv(const std::string& csvPath,
+              const std::vector<ChunkStats>& chunkStats)
+{
+    std::ofstream file{csvPath};
+    if (!(file.is_open())) {
+        return false;
+    }
+
+    file << "x,y,z,layers,terrain,floors,walls,objects,maxTileLayers,"
+            "paletteSize,unusedPaletteEntries,estimatedBytes\n";
+    for (const ChunkStats& stats : chunkStats) {
+        file << stats.chunkPosition.x << ',' << stats.chunkPosition.y << ','
+             << stats.chunkPosition.z << ',' << stats.layerCount;
+        for (std::size_t layerCount : stats.layerCountsByType) {
+            file << ',' << layerCount;
+        }
+        file << ',' << stats.maxTileLayerCount << ',' << stats.paletteSize
+             << ',' << stats.unusedPaletteEntryCount << ','
+             << stats.estimatedBytes << '\n';
+    }
+
+    return !(file.fail());
+}
+
+/**
+ * Writes a heatmap of each chunk column's layer count to a binary PPM file.
+ * Empty columns are black, and denser columns go from red to yellow to
+ * white.
+ * @return true if successful, else false.
+ */
+bool writeHeatmap(const std::string& heatmapPath,
+                  const MapAnalyzer& mapAnalyzer)
+{
+    ChunkExtent mapChunkExtent{ChunkExtent::fromMapLengths(
+        mapAnalyzer.getXLengthChunks(), mapAnalyzer.getYLengthChunks(),
+        mapAnalyzer.getZLengthChunks())};
+    std::size_t width{mapAnalyzer.getXLengthChunks()};
+    std::size_t height{mapAnalyzer.getYLengthChunks()};
+
+    // Sum the layers in each column.
+    std::vector<std::size_t> columnLayerCounts(width * height, 0);
+    for (const ChunkStats& stats : mapAnalyzer.getChunkStats()) {
+        int x{stats.chunkPosition.x - mapChunkExtent.x};
+        int y{stats.chunkPosition.y - mapChunkExtent.y};
+        if ((x >= 0) && (y >= 0) && (static_cast<std::size_t>(x) < width)
+            && (static_cast<std::size_t>(y) < height)) {
+            columnLayerCounts[(y * width) + x] += stats.layerCount;
+        }
+    }
+    std::size_t maxLayerCount{1};
+    for (std::size_t layerCount : columnLayerCounts) {
+        maxLayerCount = std::max(maxLayerCount, layerCount);
+    }
+
+    std::ofstream file{heatmapPath, std::ios::binary};
+    if (!(file.is_open())) {
+        return false;
+    }
+    file << "P6\n" << width << ' ' << height << "\n255\n";
+    for (std::size_t layerCount : columnLayerCounts) {
+        // Map the count to [0, 765], then spread it over red, green, blue.
+        int heat{static_cast<int>((layerCount * 765) / maxLayerCount)};
+        char pixel[3]{static_cast<char>(std::clamp(heat, 0, 255)),
+                      static_cast<char>(std::clamp((heat - 255), 0, 255)),
+                      static_cast<char>(std::clamp((heat - 510), 0, 255))};
+        file.write(pixel, sizeof(pixel));
+    }
+
+    return !(file.fail());
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        printUsage();
+        return 1;
+    }
+
+    std::string mapPath{argv[1]};
+    std::string resourceDataPath{};
+    std::string csvPath{"MapStats.csv"};
+    std::string heatmapPath{"MapHeatmap.ppm"};
+    int topCount{20};
+    unsigned int threadCount{
+        std::max(std::thread::hardware_concurrency(), 1U)};
+    for (int i{2}; i < argc; ++i) {
+        int remainingArgs{argc - i - 1};
+        if ((std::strcmp(argv[i], "--resources") == 0)
+            && (remainingArgs >= 1)) {
+            resourceDataPath = argv[++i];
+        }
+        else if ((std::strcmp(argv[i], "--csv") == 0)
+                 && (remainingArgs >= 1)) {
+            csvPath = argv[++i];
+        }
+        else if ((std::strcmp(argv[i], "--heatmap") == 0)
+                 && (remainingArgs >= 1)) {
+            heatmapPath = argv[++i];
+        }
+        else if ((std::strcmp(argv[i], "--top") == 0)
+                 && (remainingArgs >= 1)) {
+            if (!parseInt(argv[++i], 1, INT_MAX, topCount)) {
+                std::printf("Invalid count.\n");
+                return 1;
+            }
+        }
+        else if ((std::strcmp(argv[i], "--threads") == 0)
+                 && (remainingArgs >= 1)) {
+            int count{0};
+            if (!parseInt(argv[++i], 1, 256, count)) {
+                std::printf("Invalid thread count.\n");
+                return 1;
+            }
+            threadCount = static_cast<unsigned int>(count);
+        }
+        else {
+            std::printf("Unknown or incomplete argument: %s\n", argv[i]);
+            printUsage();
+            return 1;
+        }
+    }
+
+    // Analyze the map.
+    Timer timer{};
+    MapAnalyzer mapAnalyzer{threadCount};
+    bool analysisSuccessful{false};
+    if (IndexedTileMapReader::isIndexedMap(mapPath)) {
+        analysisSuccessful = mapAnalyzer.analyzeIndexedMap(mapPath);
+    }
+    else {
+        analysisSuccessful = mapAnalyzer.analyzeSnapshotMap(mapPath);
+    }
+    if (!analysisSuccessful) {
+        std::printf("Failed to analyze map at path: %s\n", mapPath.c_str());
+        return 1;
+    }
+    std::printf("Analyzed map on %u threads in %.3fs.\n", threadCount,
+                timer.getTime());
+
+    // Report any chunks that couldn't be analyzed.
+    const std::vector<ChunkPosition>& corruptChunks{
+        mapAnalyzer.getCorruptChunks()};
+    for (const ChunkPosition& chunkPosition : corruptChunks) {
+        std::printf("Error: Chunk (%d, %d, %d) has a tile layer that refers "
+                    "to a missing palette entry. Skipped it.\n",
+                    chunkPosition.x, chunkPosition.y, chunkPosition.z);
+    }
+
+    // Report the results.
+    const std::vector<ChunkStats>& chunkStats{mapAnalyzer.getChunkStats()};
+    printSummary(chunkStats);
+    printDensestChunks(chunkStats, static_cast<std::size_t>(topCount));
+    if (!(resourceDataPath.empty())
+        && !printUnusedGraphicSets(resourceDataPath,
+                                   mapAnalyzer.getGraphicSetUsage())) {
+        return 1;
+    }
+
+    if (!writeCsv(csvPath, chunkStats)) {
+        std::printf("Failed to write %s\n", csvPath.c_str());
+        return 1;
+    }
+    if (!writeHeatmap(heatmapPath, mapAnalyzer)) {
+        std::printf("Failed to write %s\n", heatmapPath.c_str());
+        return 1;
+    }
+    std::printf("\nWrote %s and %s\n", csvPath.c_str(), heatmapPath.c_str());
+    std::fflush(stdout);
+
+    // If any chunks were skipped, report the map as corrupt.
+    return corruptChunks.empty() ? 0 : 1;
+}
@@ -0,0 +1,63 @@
+#include "AllocationCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace AM
+{
+namespace MB
+{
+static std::atomic<std::size_t> allocationCount{0};
+static std::atomic<std::size_t> allocatedBytes{0};
+
+AllocationStats getAllocationStats()
+{
+    return {allocationCount.load(), allocatedBytes.load()};
+}
+
+static void* countedAllocate(std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+
+    // Note: new must return a unique pointer, even for size 0.
+    void* pointer{std::malloc((size > 0) ? size : 1)};
+    if (!pointer) {
+        throw std::bad_alloc{};
+    }
+
+    return pointer;
+}
+
+} // End namespace MB
+} // End namespace AM
+
+void* operator new(std::size_t size)
+{
+    return AM::MB::countedAllocate(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    return AM::MB::countedAllocate(size);
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+
+namespace AM
+{
+namespace MB
+{
+/**
+ * Counts heap allocations made through the global operator new.
+ *
+ * AllocationCounter.cpp replaces the global allocation functions, so every
+ * allocation in the process (including those made by the engine's
+ * serialization code) is counted.
+ */
+struct AllocationStats {
+    /** The number of allocations. */
+    std::size_t count{0};
+
+    /** The total number of bytes that were requested. */
+    std::size_t bytes{0};
+};
+
+/**
+ * Returns the allocations made since the program started.
+ * Subtract two results to get the allocations made in between.
+ */
+AllocationStats getAllocationStats();
+
+} // End namespace MB
+} // End namespace AM
@@ -0,0 +1,261 @@
+#include "AllocationCounter.h"
+#include "MemoryUsage.h"
+#include "MapGenerator.h"
+#include "TileMapSnapshot.h"
+#include "Serialize.h"
+#include "Deserialize.h"
+#include "Paths.h"
+#include "Timer.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace AM;
+using namespace AM::MG;
+using namespace AM::MB;
+
+/**
+ * A generated map to benchmark.
+ */
+struct Fixture {
+    std::string name{};
+
+    /** The map's lengths, in chunks. */
+    uint16_t xLengthChunks{0};
+    uint16_t yLengthChunks{0};
+
+    /** If true, the map is procedurally generated with the given density.
+        Otherwise, it's filled with flat terrain. */
+    bool isProcedural{false};
+    float density{0};
+};
+
+/**
+ * The results of benchmarking a single fixture.
+ */
+struct FixtureResults {
+    std::size_t fileSize{0};
+
+    /** The fastest load and save times, in seconds. */
+    double loadTime{0};
+    double saveTime{0};
+
+    /** The allocations made by a single load or save. */
+    AllocationStats loadAllocations{};
+    AllocationStats saveAllocations{};
+
+    /** The peak resident memory while loading. */
+    std::size_t loadPeakResidentBytes{0};
+};
+
+/** The fixtures to benchmark: each size at each density. */
+const std::vector<Fixture> FIXTURES{
+    {"4x4_Flat", 4, 4, false, 0},
+    {"4x4_Sparse", 4, 4, true, 0.1f},
+    {"4x4_Dense", 4, 4, true, 0.6f},
+    {"16x16_Flat", 16, 16, false, 0},
+    {"16x16_Sparse", 16, 16, true, 0.1f},
+    {"16x16_Dense", 16, 16, true, 0.6f},
+    {"64x64_Flat", 64, 64, false, 0},
+    {"64x64_Sparse", 64, 64, true, 0.1f},
+    {"64x64_Dense", 64, 64, true, 0.6f}};
+
+/** The graphic sets to generate fixtures with. They don't need to exist,
+    since the maps are never loaded by the engine. */
+const std::string TERRAIN_GRAPHIC_SET_ID{"benchmark_terrain"};
+const std::string FLOOR_GRAPHIC_SET_ID{"benchmark_floor"};
+const std::string WALL_GRAPHIC_SET_ID{"benchmark_wall"};
+const std::string OBJECT_GRAPHIC_SET_ID{"benchmark_object"};
+
+/** The seed to generate procedural fixtures with, so runs are
+    comparable. */
+const uint32_t FIXTURE_SEED{12345};
+
+void printUsage()
+{
+    std::printf(
+        "Usage: MapBenchmark.exe [--iterations <Count>] [--csv <Path>] "
+        "[--keep-fixtures]\n"
+        "  Generates map fixtures of several sizes and densities, then "
+        "measures Deserialize::fromFile and Serialize::toFile on each.\n"
+        "  Reports the fastest time of each, the throughput, allocations per "
+        "call, and peak resident memory while loading.\n");
+    std::fflush(stdout);
+}
+
+/**
+ * Generates the given fixture and returns its file name.
+ */
+std::string generateFixture(const Fixture& fixture)
+{
+    std::string fileName{"BenchmarkFixture_" + fixture.name + ".bin"};
+    MapGenerator mapGenerator{fixture.xLengthChunks,
+                              fixture.yLengthChunks,
+                              1,
+                              0,
+                              TERRAIN_GRAPHIC_SET_ID,
+                              std::max(std::thread::hardware_concurrency(),
+                                       1U)};
+    if (fixture.isProcedural) {
+        ProceduralSettings proceduralSettings{};
+        proceduralSettings.isEnabled = true;
+        proceduralSettings.seed = FIXTURE_SEED;
+        proceduralSettings.density = fixture.density;
+        proceduralSettings.floorGraphicSetID = FLOOR_GRAPHIC_SET_ID;
+        proceduralSettings.wallGraphicSetID = WALL_GRAPHIC_SET_ID;
+        proceduralSettings.objectGraphicSetID = OBJECT_GRAPHIC_SET_ID;
+        mapGenerator.setProceduralSettings(proceduralSettings);
+    }
+    mapGenerator.generateAndSave(fileName);
+
+    return fileName;
+}
+
+/**
+ * Loads and saves the given fixture the given number of times.
+ * @return true if successful, else false.
+ */
+bool benchmarkFixture(const std::string& fixturePath,
+                      const std::string& outputPath, int iterations,
+                      FixtureResults& outResults)
+{
+    outResults.fileSize = std::filesystem::file_size(fixturePath);
+    outResults.loadTime = 0;
+    outResults.saveTime = 0;
+
+    Timer timer{};
+    for (int i{0}; i < iterations; ++i) {
+        // Load.
+        TileMapSnapshot mapSnapshot{};
+        resetPeakResidentBytes();
+        AllocationStats startAllocations{getAllocationStats()};
+        timer.reset();
+        if (!Deserialize::fromFile(fixturePath, mapSnapshot)) {
+            return false;
+        }
+        double loadTime{timer.getTime()};
+        AllocationStats endAllocations{getAllocationStats()};
+        outResults.loadPeakResidentBytes = getPeakResidentBytes();
+        outResults.loadAllocations
+            = {(endAllocations.count - startAllocations.count),
+               (endAllocations.bytes - startAllocations.bytes)};
+
+        // Save.
+        startAllocations = getAllocationStats();
+        timer.reset();
+        if (!Serialize::toFile(outputPath, mapSnapshot)) {
+            return false;
+        }
+        double saveTime{timer.getTime()};
+        endAllocations = getAllocationStats();
+        outResults.saveAllocations
+            = {(endAllocations.count - startAllocations.count),
+               (endAllocations.bytes - startAllocations.bytes)};
+
+        // Keep the fastest times, since they're the least affected by
+        // whatever else the machine is doing.
+        if ((i == 0) || (loadTime < outResults.loadTime)) {
+            outResults.loadTime = loadTime;
+        }
+        if ((i == 0) || (saveTime < outResults.saveTime)) {
+            outResults.saveTime = saveTime;
+        }
+    }
+
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    int iterations{5};
+    std::string csvPath{};
+    bool keepFixtures{false};
+    for (int i{1}; i < argc; ++i) {
+        int remainingArgs{argc - i - 1};
+        if ((std::strcmp(argv[i], "--iterations") == 0)
+            && (remainingArgs >= 1)) {
+            iterations = std::atoi(argv[++i]);
+            if (iterations < 1) {
+                std::printf("Invalid iteration count.\n");
+                return 1;
+            }
+        }
+        else if ((std::strcmp(argv[i], "--csv") == 0)
+                 && (remainingArgs >= 1)) {
+            csvPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--keep-fixtures") == 0) {
+            keepFixtures = true;
+        }
+        else {
+            std::printf("Unknown or incomplete argument: %s\n", argv[i]);
+            printUsage();
+            return 1;
+        }
+    }
+
+    if (!canResetPeakResidentBytes()) {
+        std::printf("Note: Peak memory can't be reset on this platform, so "
+                    "it's the peak since the benchmark started.\n");
+    }
+
+    std::printf("%-14s %10s %10s %9s %10s %9s %10s %10s %10s\n", "Fixture",
+                "Size (KiB)", "Load (ms)", "Load MB/s", "Load alloc",
+                "Save (ms)", "Save MB/s", "Save alloc", "Peak (MiB)");
+    std::vector<FixtureResults> allResults{};
+    std::string outputPath{Paths::BASE_PATH + "BenchmarkOutput.bin"};
+    for (const Fixture& fixture : FIXTURES) {
+        std::string fixturePath{Paths::BASE_PATH + generateFixture(fixture)};
+
+        FixtureResults results{};
+        if (!benchmarkFixture(fixturePath, outputPath, iterations, results)) {
+            std::printf("Failed to load or save fixture: %s\n",
+                        fixturePath.c_str());
+            return 1;
+        }
+        allResults.push_back(results);
+
+        double megabytes{results.fileSize / (1000.0 * 1000.0)};
+        std::printf("%-14s %10.1f %10.3f %9.1f %10zu %9.3f %10.1f %10zu "
+                    "%10.1f\n",
+                    fixture.name.c_str(), (results.fileSize / 1024.0),
+                    (results.loadTime * 1000.0),
+                    (megabytes / results.loadTime),
+                    results.loadAllocations.count,
+                    (results.saveTime * 1000.0),
+                    (megabytes / results.saveTime),
+                    results.saveAllocations.count,
+                    (results.loadPeakResidentBytes / (1024.0 * 1024.0)));
+        std::fflush(stdout);
+
+        if (!keepFixtures) {
+            std::filesystem::remove(fixturePath);
+        }
+    }
+    std::filesystem::remove(outputPath);
+
+    // If requested, write the results so runs can be compared.
+    if (!(csvPath.empty())) {
+        std::ofstream file{csvPath};
+        file << "fixture,fileBytes,loadSeconds,loadAllocations,loadBytes,"
+                "saveSeconds,saveAllocations,saveBytes,loadPeakResidentBytes\n";
+        for (std::size_t i{0}; i < FIXTURES.size(); ++i) {
+            const FixtureResults& results{allResults[i]};
+            file << FIXTURES[i].name << ',' << results.fileSize << ','
+                 << results.loadTime << ',' << results.loadAllocations.count
+                 << ',' << results.loadAllocations.bytes << ','
+                 << results.saveTime << ',' << results.saveAllocations.count
+                 << ',' << results.saveAllocations.bytes << ','
+                 << results.loadPeakResidentBytes << '\n';
+        }
+        std::printf("Wrote %s\n", csvPath.c_str());
+    }
+
+    return 0;
+}
@@ -0,0 +1,65 @@
+#include "MemoryUsage.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__linux__)
+#include <fstream>
+#include <string>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace AM
+{
+namespace MB
+{
+void resetPeakResidentBytes()
+{
+#if defined(__linux__)
+    // Writing 5 to clear_refs resets VmHWM (the peak RSS) to the current
+    // RSS.
+    std::ofstream clearRefs{"/proc/self/clear_refs"};
+    clearRefs << "5";
+#endif
+}
+
+std::size_t getPeakResidentBytes()
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters,
+                              sizeof(counters))) {
+        return 0;
+    }
+    return counters.PeakWorkingSetSize;
+#elif defined(__linux__)
+    std::ifstream status{"/proc/self/status"};
+    std::string line{};
+    while (std::getline(status, line)) {
+        if (line.starts_with("VmHWM:")) {
+            // The value is in kB.
+            return std::stoull(line.substr(6)) * 1024;
+        }
+    }
+    return 0;
+#else
+    // Note: macOS reports ru_maxrss in bytes.
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<std::size_t>(usage.ru_maxrss);
+#endif
+}
+
+bool canResetPeakResidentBytes()
+{
+#if defined(__linux__)
+    return true;
+#else
+    return false;
+#endif
+}
+
+} // End namespace MB
+} // End namespace AM
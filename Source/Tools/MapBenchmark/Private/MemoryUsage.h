@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+
+namespace AM
+{
+namespace MB
+{
+/**
+ * Resets the process's peak resident memory to its current resident memory,
+ * if the platform supports it.
+ *
+ * Only Linux supports this. On other platforms, getPeakResidentBytes()
+ * returns the peak since the process started.
+ */
+void resetPeakResidentBytes();
+
+/**
+ * Returns the process's peak resident memory, in bytes, or 0 if it isn't
+ * available.
+ */
+std::size_t getPeakResidentBytes();
+
+/**
+ * Returns true if resetPeakResidentBytes() works on this platform.
+ */
+bool canResetPeakResidentBytes();
+
+} // End namespace MB
+} // End namespace AM
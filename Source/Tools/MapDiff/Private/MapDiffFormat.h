@@ -0,0 +1,121 @@
+#pragma once
+
+#include "ChunkPosition.h"
+#include "bitsery/bitsery.h"
+#include "bitsery/traits/vector.h"
+#include <SDL_stdinc.h>
+#include <span>
+#include <vector>
+
+namespace AM
+{
+namespace MD
+{
+/**
+ * The layout of a map diff file.
+ *
+ * A diff holds every chunk entry that differs between a base map and a
+ * target map, and the positions of any chunks that were removed. Applying
+ * it to the base map produces a byte-identical copy of the target map.
+ *
+ * Layout:
+ *   Header
+ *   Body (a serialized MapDiff, compressed with the codec in the header)
+ */
+namespace MapDiffFormat
+{
+/** Identifies a map diff file. */
+static constexpr Uint32 MAGIC{0x46444D41}; // "AMDF"
+
+/** The version of the diff file layout. */
+static constexpr Uint16 FORMAT_VERSION{1};
+
+struct Header {
+    Uint32 magic{MAGIC};
+    Uint16 formatVersion{FORMAT_VERSION};
+
+    /** The ChunkCodec that the body was compressed with. */
+    Uint8 codec{0};
+    Uint8 padding{0};
+
+    /** The hash of the map file that this diff applies to. */
+    Uint64 baseMapHash{0};
+
+    /** The hash of the map file that applying this diff produces. */
+    Uint64 targetMapHash{0};
+
+    /** The size, in bytes, of the body before it was compressed. */
+    Uint64 decodedBodySize{0};
+};
+
+static_assert(sizeof(Header) == 32);
+
+} // namespace MapDiffFormat
+
+/**
+ * A chunk entry that was added or changed in the target map.
+ */
+struct ChangedChunk {
+    ChunkPosition chunkPosition{};
+
+    /** The chunk's serialized entry, exactly as it appears in the target
+        map. */
+    std::vector<Uint8> entryData{};
+};
+
+template<typename S>
+void serialize(S& serializer, ChangedChunk& changedChunk)
+{
+    serializer.object(changedChunk.chunkPosition);
+    serializer.container1b(changedChunk.entryData, UINT32_MAX);
+}
+
+/**
+ * The changes between two maps.
+ */
+struct MapDiff {
+    /** The target map's header values. */
+    Uint16 version{0};
+    Uint16 xLengthChunks{0};
+    Uint16 yLengthChunks{0};
+    Uint16 zLengthChunks{0};
+
+    /** The number of chunks in the target map. */
+    Uint32 chunkCount{0};
+
+    /** Chunks that are in the base map but not the target map, in map
+        order. */
+    std::vector<ChunkPosition> removedChunks{};
+
+    /** Chunks that were added or changed in the target map, in map order. */
+    std::vector<ChangedChunk> changedChunks{};
+};
+
+template<typename S>
+void serialize(S& serializer, MapDiff& mapDiff)
+{
+    serializer.value2b(mapDiff.version);
+    serializer.value2b(mapDiff.xLengthChunks);
+    serializer.value2b(mapDiff.yLengthChunks);
+    serializer.value2b(mapDiff.zLengthChunks);
+    serializer.value4b(mapDiff.chunkCount);
+    serializer.container(mapDiff.removedChunks, UINT32_MAX);
+    serializer.container(mapDiff.changedChunks, UINT32_MAX);
+}
+
+/**
+ * Returns a 64-bit FNV-1a hash of the given data.
+ */
+inline Uint64 hashBytes(std::span<const Uint8> data)
+{
+    Uint64 hash{0xCBF29CE484222325ULL};
+    for (Uint8 byte : data) {
+        hash ^= byte;
+        hash *= 0x100000001B3ULL;
+    }
+
+    return hash;
+}
+
+} // End namespace MD
+} // End namespace AM
@@ -0,0 +1,120 @@
+#include "MapDiffer.h"
+#include "TempFile.h"
+#include "Timer.h"
+
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+using namespace AM;
+using namespace AM::MD;
+
+void printUsage()
+{
+    std::printf(
+        "Usage: MapDiff.exe create <BaseMapPath> <TargetMapPath> <DiffPath> "
+        "[--codec <none|rle|lz4|zstd>]\n"
+        "  Writes a diff containing every chunk that differs between the two "
+        "maps. Defaults to the rle codec.\n"
+        "Usage: MapDiff.exe apply <MapPath> <DiffPath> [--output "
+        "<OutputPath>]\n"
+        "  Applies the diff to the given map. The map must be the base map "
+        "that the diff was created from.\n"
+        "  The map is patched in place unless an output path is given. If "
+        "the diff doesn't match the map, nothing is written.\n");
+    std::fflush(stdout);
+}
+
+/**
+ * Creates a diff using the given command line arguments.
+ */
+int createDiff(int argc, char** argv)
+{
+    ChunkCodec codec{ChunkCodec::RunLength};
+    if ((argc == 7) && (std::strcmp(argv[5], "--codec") == 0)) {
+        if (!ChunkCodecs::fromString(argv[6], codec)
+            || !ChunkCodecs::isAvailable(codec)) {
+            std::printf("Invalid or unavailable codec: %s\n", argv[6]);
+            return 1;
+        }
+    }
+    else if (argc != 5) {
+        printUsage();
+        return 1;
+    }
+
+    std::string diffPath{argv[4]};
+    Timer timer{};
+    MapDiffer mapDiffer{};
+    if (!(mapDiffer.createDiff(argv[2], argv[3], diffPath, codec))) {
+        std::printf("Failed to create diff.\n");
+        return 1;
+    }
+
+    std::printf("Created diff in %.3fs: %zu changed, %zu removed, %zu "
+                "unchanged chunks. Diff size: %ju bytes\n",
+                timer.getTime(), mapDiffer.getChangedCount(),
+                mapDiffer.getRemovedCount(), mapDiffer.getUnchangedCount(),
+                std::filesystem::file_size(diffPath));
+    return 0;
+}
+
+/**
+ * Applies a diff using the given command line arguments.
+ */
+int applyDiff(int argc, char** argv)
+{
+    bool hasOutput{(argc == 6) && (std::strcmp(argv[4], "--output") == 0)};
+    if ((argc != 4) && !hasOutput) {
+        printUsage();
+        return 1;
+    }
+
+    std::string mapPath{argv[2]};
+    std::string outputPath{hasOutput ? argv[5] : mapPath};
+
+    // Patch the map, then swap it in over the output.
+    Timer timer{};
+    MapDiffer mapDiffer{};
+    std::error_code errorCode{};
+    TempFile::Result result{TempFile::writeAndReplace(
+        outputPath,
+        [&](const std::string& tempPath) {
+            return mapDiffer.applyDiff(mapPath, argv[3], tempPath);
+        },
+        errorCode)};
+    if (result == TempFile::Result::WriteFailed) {
+        std::printf("Failed to apply diff. The map has not been modified.\n"
+                    "Make sure it's the map that the diff was created "
+                    "from.\n");
+        return 1;
+    }
+    else if (result == TempFile::Result::ReplaceFailed) {
+        std::printf("Failed to replace %s: %s\n", outputPath.c_str(),
+                    errorCode.message().c_str());
+        return 1;
+    }
+
+    std::printf("Applied diff in %.3fs: %zu changed, %zu removed, %zu "
+                "unchanged chunks.\n",
+                timer.getTime(), mapDiffer.getChangedCount(),
+                mapDiffer.getRemovedCount(), mapDiffer.getUnchangedCount());
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    int result{1};
+    if ((argc >= 2) && (std::strcmp(argv[1], "create") == 0)) {
+        result = createDiff(argc, argv);
+    }
+    else if ((argc >= 2) && (std::strcmp(argv[1], "apply") == 0)) {
+        result = applyDiff(argc, argv);
+    }
+    else {
+        printUsage();
+    }
+
+    std::fflush(stdout);
+    return result;
+}
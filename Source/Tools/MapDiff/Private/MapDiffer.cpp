@@ -0,0 +1,257 @@
+#include "MapDiffer.h"
+#include "MapDiffFormat.h"
+#include "MappedFile.h"
+#include "TileMapStreamReader.h"
+#include "TileMapStreamWriter.h"
+#include "TileMapSnapshot.h"
+#include "bitsery/adapter/buffer.h"
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace AM
+{
+namespace MD
+{
+MapDiffer::MapDiffer()
+: unchangedCount{0}
+, changedCount{0}
+, removedCount{0}
+{
+}
+
+bool MapDiffer::createDiff(const std::string& baseMapPath,
+                           const std::string& targetMapPath,
+                           const std::string& diffPath, ChunkCodec codec)
+{
+    unchangedCount = 0;
+    changedCount = 0;
+    removedCount = 0;
+
+    TileMapStreamReader baseReader{};
+    TileMapStreamReader targetReader{};
+    if (!(baseReader.open(baseMapPath))
+        || !(targetReader.open(targetMapPath))) {
+        return false;
+    }
+
+    MapDiff mapDiff{};
+    mapDiff.version = targetReader.getVersion();
+    mapDiff.xLengthChunks = targetReader.getXLengthChunks();
+    mapDiff.yLengthChunks = targetReader.getYLengthChunks();
+    mapDiff.zLengthChunks = targetReader.getZLengthChunks();
+    mapDiff.chunkCount = static_cast<Uint32>(targetReader.getChunkCount());
+
+    // Walk both maps in order. Chunks are serialized sorted by position, so
+    // we can match them up like a merge.
+    ChunkPosition basePosition{};
+    ChunkPosition targetPosition{};
+    ChunkSnapshot chunkSnapshot{};
+    bool hasBase{baseReader.readChunkEntry(basePosition, chunkSnapshot)};
+    bool hasTarget{targetReader.readChunkEntry(targetPosition, chunkSnapshot)};
+    while (hasBase || hasTarget) {
+        if (hasBase && (!hasTarget || (basePosition < targetPosition))) {
+            // The chunk was removed.
+            mapDiff.removedChunks.push_back(basePosition);
+            hasBase = baseReader.readChunkEntry(basePosition, chunkSnapshot);
+            continue;
+        }
+
+        std::span<const Uint8> targetData{targetReader.getLastEntryData()};
+        if (hasBase && (basePosition == targetPosition)) {
+            // If the chunk is unchanged, skip it.
+            // Note: The hash rules out most changed chunks cheaply. We still
+            //       compare the bytes, so a collision can't drop a change.
+            std::span<const Uint8> baseData{baseReader.getLastEntryData()};
+            if ((baseData.size() == targetData.size())
+                && (hashBytes(baseData) == hashBytes(targetData))
+                && (std::memcmp(baseData.data(), targetData.data(),
+                                targetData.size())
+                    == 0)) {
+                unchangedCount++;
+            }
+            else {
+                mapDiff.changedChunks.push_back(
+                    {targetPosition,
+                     std::vector<Uint8>(targetData.begin(),
+                                        targetData.end())});
+            }
+            hasBase = baseReader.readChunkEntry(basePosition, chunkSnapshot);
+        }
+        else {
+            // The chunk was added.
+            mapDiff.changedChunks.push_back(
+                {targetPosition,
+                 std::vector<Uint8>(targetData.begin(), targetData.end())});
+        }
+        hasTarget = targetReader.readChunkEntry(targetPosition, chunkSnapshot);
+    }
+    changedCount = mapDiff.changedChunks.size();
+    removedCount = mapDiff.removedChunks.size();
+
+    // If either map stopped early, an entry failed to deserialize.
+    if (!(baseReader.isAtEnd()) || !(targetReader.isAtEnd())) {
+        return false;
+    }
+    baseReader.close();
+    targetReader.close();
+
+    // Serialize and compress the diff.
+    std::vector<Uint8> bodyBuffer{};
+    using OutputAdapter = bitsery::OutputBufferAdapter<std::vector<Uint8>>;
+    std::size_t bodySize{
+        bitsery::quickSerialization(OutputAdapter{bodyBuffer}, mapDiff)};
+    std::vector<Uint8> compressedBody{};
+    if (!ChunkCodecs::compress(codec, bodyBuffer.data(), bodySize,
+                               compressedBody)) {
+        return false;
+    }
+
+    MapDiffFormat::Header header{};
+    header.codec = static_cast<Uint8>(codec);
+    header.baseMapHash = hashFile(baseMapPath);
+    header.targetMapHash = hashFile(targetMapPath);
+    header.decodedBodySize = bodySize;
+
+    std::ofstream file{diffPath, std::ios::binary};
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(compressedBody.data()),
+               compressedBody.size());
+    file.close();
+
+    return !(file.fail());
+}
+
+bool MapDiffer::applyDiff(const std::string& mapPath,
+                          const std::string& diffPath,
+                          const std::string& outputPath)
+{
+    unchangedCount = 0;
+    changedCount = 0;
+    removedCount = 0;
+
+    // Load the diff and make sure it applies to this map.
+    MappedFile diffFile{};
+    if (!(diffFile.open(diffPath))
+        || (diffFile.getSize() < sizeof(MapDiffFormat::Header))) {
+        return false;
+    }
+    MapDiffFormat::Header header{};
+    std::memcpy(&header, diffFile.getData(), sizeof(header));
+    ChunkCodec codec{static_cast<ChunkCodec>(header.codec)};
+    if ((header.magic != MapDiffFormat::MAGIC)
+        || (header.formatVersion != MapDiffFormat::FORMAT_VERSION)
+        || !ChunkCodecs::isAvailable(codec)
+        || (header.baseMapHash != hashFile(mapPath))) {
+        return false;
+    }
+
+    std::vector<Uint8> bodyBuffer{};
+    if (!ChunkCodecs::decompress(
+            codec, (diffFile.getData() + sizeof(header)),
+            (diffFile.getSize() - sizeof(header)),
+            static_cast<std::size_t>(header.decodedBodySize), bodyBuffer)) {
+        return false;
+    }
+    diffFile.close();
+
+    MapDiff mapDiff{};
+    using InputAdapter = bitsery::InputBufferAdapter<const Uint8*>;
+    auto state{bitsery::quickDeserialization(
+        InputAdapter{bodyBuffer.data(), bodyBuffer.size()}, mapDiff)};
+    if ((state.first != bitsery::ReaderError::NoError) || !(state.second)) {
+        return false;
+    }
+
+    TileMapStreamReader reader{};
+    if (!(reader.open(mapPath))) {
+        return false;
+    }
+    TileMapStreamWriter writer{outputPath,
+                               mapDiff.version,
+                               mapDiff.xLengthChunks,
+                               mapDiff.yLengthChunks,
+                               mapDiff.zLengthChunks,
+                               mapDiff.chunkCount,
+                               1};
+    if (!(writer.isOpen())) {
+        return false;
+    }
+
+    // Merge the diff into the map. Like createDiff(), this relies on both
+    // being in map order.
+    std::size_t entryIndex{0};
+    std::size_t nextChanged{0};
+    std::size_t nextRemoved{0};
+    ChunkPosition chunkPosition{};
+    ChunkSnapshot chunkSnapshot{};
+    bool hasBase{reader.readChunkEntry(chunkPosition, chunkSnapshot)};
+    while (hasBase || (nextChanged < mapDiff.changedChunks.size())) {
+        // If the next changed chunk comes before or replaces this one,
+        // write it.
+        if ((nextChanged < mapDiff.changedChunks.size())
+            && (!hasBase
+                || !(chunkPosition
+                     < mapDiff.changedChunks[nextChanged].chunkPosition))) {
+            ChangedChunk& changedChunk{mapDiff.changedChunks[nextChanged]};
+            if (hasBase && (changedChunk.chunkPosition == chunkPosition)) {
+                hasBase = reader.readChunkEntry(chunkPosition, chunkSnapshot);
+            }
+            writer.writeChunkEntry(entryIndex++,
+                                   std::move(changedChunk.entryData));
+            changedCount++;
+            nextChanged++;
+        }
+        // If this chunk was removed, skip it.
+        else if ((nextRemoved < mapDiff.removedChunks.size())
+                 && (mapDiff.removedChunks[nextRemoved] == chunkPosition)) {
+            hasBase = reader.readChunkEntry(chunkPosition, chunkSnapshot);
+            removedCount++;
+            nextRemoved++;
+        }
+        // This chunk is unchanged, copy it.
+        else {
+            std::span<const Uint8> entryData{reader.getLastEntryData()};
+            writer.writeChunkEntry(
+                entryIndex++,
+                std::vector<Uint8>(entryData.begin(), entryData.end()));
+            hasBase = reader.readChunkEntry(chunkPosition, chunkSnapshot);
+            unchangedCount++;
+        }
+    }
+    bool readAllEntries{reader.isAtEnd()};
+    reader.close();
+
+    // Make sure we produced exactly the target map.
+    return writer.finish() && readAllEntries
+           && (nextRemoved == mapDiff.removedChunks.size())
+           && (hashFile(outputPath) == header.targetMapHash);
+}
+
+std::size_t MapDiffer::getUnchangedCount() const
+{
+    return unchangedCount;
+}
+
+std::size_t MapDiffer::getChangedCount() const
+{
+    return changedCount;
+}
+
+std::size_t MapDiffer::getRemovedCount() const
+{
+    return removedCount;
+}
+
+Uint64 MapDiffer::hashFile(const std::string& filePath)
+{
+    MappedFile mappedFile{};
+    if (!(mappedFile.open(filePath))) {
+        return 0;
+    }
+
+    return hashBytes({mappedFile.getData(), mappedFile.getSize()});
+}
+
+} // End namespace MD
+} // End namespace AM
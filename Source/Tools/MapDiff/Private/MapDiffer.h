@@ -0,0 +1,64 @@
+#pragma once
+
+#include "ChunkCodec.h"
+#include <SDL_stdinc.h>
+#include <string>
+
+namespace AM
+{
+namespace MD
+{
+/**
+ * Creates and applies chunk-level diffs between tile map files.
+ *
+ * Both maps are streamed in map order, so neither is ever fully loaded.
+ * Chunks are compared by hashing their serialized entries, so unchanged
+ * chunks are skipped without being compared field by field, and are
+ * copied byte-for-byte when a diff is applied.
+ */
+class MapDiffer
+{
+public:
+    MapDiffer();
+
+    /**
+     * Writes a diff that turns the base map into the target map.
+     *
+     * @param codec The codec to compress the diff with.
+     * @return true if successful, else false.
+     */
+    bool createDiff(const std::string& baseMapPath,
+                    const std::string& targetMapPath,
+                    const std::string& diffPath, ChunkCodec codec);
+
+    /**
+     * Applies the given diff to the given map, writing the result to the
+     * output path.
+     *
+     * The map's hash must match the one that the diff was created from,
+     * and the result's hash is checked against the target map's.
+     *
+     * @return true if successful, else false.
+     */
+    bool applyDiff(const std::string& mapPath, const std::string& diffPath,
+                   const std::string& outputPath);
+
+    /** The stats of the last createDiff() or applyDiff(). */
+    std::size_t getUnchangedCount() const;
+    std::size_t getChangedCount() const;
+    std::size_t getRemovedCount() const;
+
+private:
+    /**
+     * Returns the hash of the file at the given path, or 0 if it couldn't
+     * be opened.
+     */
+    static Uint64 hashFile(const std::string& filePath);
+
+    std::size_t unchangedCount;
+    std::size_t changedCount;
+    std::size_t removedCount;
+};
+
+} // End namespace MD
+} // End namespace AM
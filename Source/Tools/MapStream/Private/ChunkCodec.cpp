@@ -0,0 +1,255 @@
+#include "ChunkCodec.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(MAPSTREAM_HAS_LZ4)
+#include <lz4.h>
+#endif
+#if defined(MAPSTREAM_HAS_ZSTD)
+#include <zstd.h>
+#endif
+
+namespace AM
+{
+namespace ChunkCodecs
+{
+/** Run-length control bytes below this value start a literal run of
+    (control + 1) bytes. Values at or above it start a repeated run of
+    (control - REPEAT_FLAG + MIN_REPEAT) copies of the next byte. */
+static constexpr Uint8 REPEAT_FLAG{128};
+
+/** The shortest run that's worth encoding as a repeat. */
+static constexpr std::size_t MIN_REPEAT{3};
+
+/** The longest literal or repeated run that a control byte can describe. */
+static constexpr std::size_t MAX_LITERAL{128};
+static constexpr std::size_t MAX_REPEAT{(255 - REPEAT_FLAG) + MIN_REPEAT};
+
+/** The zstd compression level. Chunks are small, so higher levels gain
+    little. */
+static constexpr int ZSTD_LEVEL{3};
+
+static void compressRunLength(const Uint8* data, std::size_t size,
+                              std::vector<Uint8>& outData)
+{
+    std::size_t literalStart{0};
+    std::size_t i{0};
+
+    // Writes any pending literal bytes, up to the given index.
+    auto flushLiterals = [&](std::size_t literalEnd) {
+        while (literalStart < literalEnd) {
+            std::size_t literalCount{
+                std::min((literalEnd - literalStart), MAX_LITERAL)};
+            outData.push_back(static_cast<Uint8>(literalCount - 1));
+            outData.insert(outData.end(), (data + literalStart),
+                           (data + literalStart + literalCount));
+            literalStart += literalCount;
+        }
+    };
+
+    while (i < size) {
+        // Measure the run of bytes matching this one.
+        std::size_t runLength{1};
+        while (((i + runLength) < size) && (runLength < MAX_REPEAT)
+               && (data[i + runLength] == data[i])) {
+            runLength++;
+        }
+
+        if (runLength >= MIN_REPEAT) {
+            flushLiterals(i);
+            outData.push_back(
+                static_cast<Uint8>(REPEAT_FLAG + (runLength - MIN_REPEAT)));
+            outData.push_back(data[i]);
+            i += runLength;
+            literalStart = i;
+        }
+        else {
+            i += runLength;
+        }
+    }
+
+    flushLiterals(size);
+}
+
+static bool decompressRunLength(const Uint8* data, std::size_t size,
+                                std::size_t decodedSize,
+                                std::vector<Uint8>& outData)
+{
+    outData.resize(decodedSize);
+    std::size_t readIndex{0};
+    std::size_t writeIndex{0};
+    while (readIndex < size) {
+        Uint8 control{data[readIndex++]};
+        if (control < REPEAT_FLAG) {
+            std::size_t literalCount{static_cast<std::size_t>(control) + 1};
+            if (((readIndex + literalCount) > size)
+                || ((writeIndex + literalCount) > decodedSize)) {
+                return false;
+            }
+            std::memcpy(&(outData[writeIndex]), (data + readIndex),
+                        literalCount);
+            readIndex += literalCount;
+            writeIndex += literalCount;
+        }
+        else {
+            std::size_t repeatCount{
+                static_cast<std::size_t>(control - REPEAT_FLAG) + MIN_REPEAT};
+            if ((readIndex >= size)
+                || ((writeIndex + repeatCount) > decodedSize)) {
+                return false;
+            }
+            std::memset(&(outData[writeIndex]), data[readIndex++],
+                        repeatCount);
+            writeIndex += repeatCount;
+        }
+    }
+
+    return (writeIndex == decodedSize);
+}
+
+bool isAvailable(ChunkCodec codec)
+{
+    switch (codec) {
+        case ChunkCodec::None:
+        case ChunkCodec::RunLength:
+            return true;
+        case ChunkCodec::LZ4:
+#if defined(MAPSTREAM_HAS_LZ4)
+            return true;
+#else
+            return false;
+#endif
+        case ChunkCodec::Zstd:
+#if defined(MAPSTREAM_HAS_ZSTD)
+            return true;
+#else
+            return false;
+#endif
+    }
+
+    return false;
+}
+
+const char* toString(ChunkCodec codec)
+{
+    switch (codec) {
+        case ChunkCodec::None:
+            return "none";
+        case ChunkCodec::RunLength:
+            return "rle";
+        case ChunkCodec::LZ4:
+            return "lz4";
+        case ChunkCodec::Zstd:
+            return "zstd";
+    }
+
+    return "unknown";
+}
+
+bool fromString(const std::string& codecName, ChunkCodec& outCodec)
+{
+    for (ChunkCodec codec : {ChunkCodec::None, ChunkCodec::RunLength,
+                             ChunkCodec::LZ4, ChunkCodec::Zstd}) {
+        if (codecName == toString(codec)) {
+            outCodec = codec;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool compress(ChunkCodec codec, const Uint8* data, std::size_t size,
+              std::vector<Uint8>& outData)
+{
+    outData.clear();
+    switch (codec) {
+        case ChunkCodec::None: {
+            outData.assign(data, (data + size));
+            return true;
+        }
+        case ChunkCodec::RunLength: {
+            compressRunLength(data, size, outData);
+            return true;
+        }
+        case ChunkCodec::LZ4: {
+#if defined(MAPSTREAM_HAS_LZ4)
+            // Note: LZ4 takes int sizes. Chunks are far smaller than this.
+            if (size > static_cast<std::size_t>(LZ4_MAX_INPUT_SIZE)) {
+                return false;
+            }
+            outData.resize(LZ4_compressBound(static_cast<int>(size)));
+            int compressedSize{LZ4_compress_default(
+                reinterpret_cast<const char*>(data),
+                reinterpret_cast<char*>(outData.data()),
+                static_cast<int>(size), static_cast<int>(outData.size()))};
+            if (compressedSize <= 0) {
+                outData.clear();
+                return false;
+            }
+            outData.resize(static_cast<std::size_t>(compressedSize));
+            return true;
+#else
+            return false;
+#endif
+        }
+        case ChunkCodec::Zstd: {
+#if defined(MAPSTREAM_HAS_ZSTD)
+            outData.resize(ZSTD_compressBound(size));
+            std::size_t compressedSize{ZSTD_compress(
+                outData.data(), outData.size(), data, size, ZSTD_LEVEL)};
+            if (ZSTD_isError(compressedSize)) {
+                outData.clear();
+                return false;
+            }
+            outData.resize(compressedSize);
+            return true;
+#else
+            return false;
+#endif
+        }
+    }
+
+    return false;
+}
+
+bool decompress(ChunkCodec codec, const Uint8* data, std::size_t size,
+                std::size_t decodedSize, std::vector<Uint8>& outData)
+{
+    switch (codec) {
+        case ChunkCodec::None: {
+            outData.assign(data, (data + size));
+            return (size == decodedSize);
+        }
+        case ChunkCodec::RunLength: {
+            return decompressRunLength(data, size, decodedSize, outData);
+        }
+        case ChunkCodec::LZ4: {
+#if defined(MAPSTREAM_HAS_LZ4)
+            outData.resize(decodedSize);
+            int result{LZ4_decompress_safe(
+                reinterpret_cast<const char*>(data),
+                reinterpret_cast<char*>(outData.data()),
+                static_cast<int>(size), static_cast<int>(decodedSize))};
+            return (result == static_cast<int>(decodedSize));
+#else
+            return false;
+#endif
+        }
+        case ChunkCodec::Zstd: {
+#if defined(MAPSTREAM_HAS_ZSTD)
+            outData.resize(decodedSize);
+            std::size_t result{ZSTD_decompress(outData.data(), decodedSize,
+                                               data, size)};
+            return !ZSTD_isError(result) && (result == decodedSize);
+#else
+            return false;
+#endif
+        }
+    }
+
+    return false;
+}
+
+} // namespace ChunkCodecs
+} // End namespace AM
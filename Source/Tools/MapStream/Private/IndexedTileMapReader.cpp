@@ -0,0 +1,256 @@
+#include "IndexedTileMapReader.h"
+#include "ChunkCodec.h"
+#include "bitsery/bitsery.h"
+#include "bitsery/adapter/buffer.h"
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <thread>
+
+namespace AM
+{
+IndexedTileMapReader::IndexedTileMapReader()
+: mappedFile{}
+, header{nullptr}
+, index{nullptr}
+, paletteTable{}
+, decodedChunks{}
+, scratchBuffer{}
+{
+}
+
+bool IndexedTileMapReader::open(const std::string& filePath)
+{
+    using namespace IndexedTileMapFormat;
+    header = nullptr;
+    index = nullptr;
+    paletteTable.entries.clear();
+    decodedChunks.clear();
+
+    if (!(mappedFile.open(filePath))
+        || (mappedFile.getSize() < sizeof(Header))) {
+        return false;
+    }
+
+    // Validate the header.
+    const auto* fileHeader{
+        reinterpret_cast<const Header*>(mappedFile.getData())};
+    if ((fileHeader->magic != MAGIC)
+        || (fileHeader->formatVersion != FORMAT_VERSION)) {
+        return false;
+    }
+
+    // Validate the index.
+    std::size_t indexEnd{sizeof(Header)
+                         + (fileHeader->chunkCount * sizeof(IndexEntry))};
+    std::size_t paletteTableOffset{fileHeader->paletteTableOffset};
+    if ((paletteTableOffset < indexEnd)
+        || (mappedFile.getSize() < paletteTableOffset)) {
+        return false;
+    }
+    const auto* fileIndex{reinterpret_cast<const IndexEntry*>(
+        mappedFile.getData() + sizeof(Header))};
+    for (std::size_t i{0}; i < fileHeader->chunkCount; ++i) {
+        const IndexEntry& entry{fileIndex[i]};
+        // Note: We check the size against the remaining space, so a huge
+        //       offset can't wrap around.
+        if ((entry.offset < indexEnd) || (entry.offset > paletteTableOffset)
+            || (entry.size > (paletteTableOffset - entry.offset))
+            || !ChunkCodecs::isAvailable(
+                static_cast<ChunkCodec>(entry.codec))) {
+            return false;
+        }
+    }
+
+    // Load the palette table.
+    using InputAdapter = bitsery::InputBufferAdapter<const Uint8*>;
+    auto state{bitsery::quickDeserialization(
+        InputAdapter{(mappedFile.getData() + paletteTableOffset),
+                     (mappedFile.getSize() - paletteTableOffset)},
+        paletteTable)};
+    if ((state.first != bitsery::ReaderError::NoError) || !(state.second)
+        || (paletteTable.entries.size() != fileHeader->paletteEntryCount)) {
+        paletteTable.entries.clear();
+        return false;
+    }
+
+    header = fileHeader;
+    index = fileIndex;
+    decodedChunks.resize(header->chunkCount);
+
+    return true;
+}
+
+bool IndexedTileMapReader::isIndexedMap(const std::string& filePath)
+{
+    std::ifstream file{filePath, std::ios::binary};
+    Uint32 magic{0};
+    file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+
+    return (file.gcount() == sizeof(magic))
+           && (magic == IndexedTileMapFormat::MAGIC);
+}
+
+const IndexedTileMapFormat::Header& IndexedTileMapReader::getHeader() const
+{
+    return *header;
+}
+
+std::span<const IndexedTileMapFormat::IndexEntry>
+    IndexedTileMapReader::getIndex() const
+{
+    return {index, header->chunkCount};
+}
+
+std::span<const ChunkSnapshot::PaletteEntry>
+    IndexedTileMapReader::getPaletteTable() const
+{
+    return paletteTable.entries;
+}
+
+std::ptrdiff_t
+    IndexedTileMapReader::findEntry(const ChunkPosition& chunkPosition) const
+{
+    IndexedTileMapFormat::IndexEntry target{};
+    target.x = chunkPosition.x;
+    target.y = chunkPosition.y;
+    target.z = chunkPosition.z;
+    std::span<const IndexedTileMapFormat::IndexEntry> entries{getIndex()};
+    auto it{std::lower_bound(entries.begin(), entries.end(), target,
+                             IndexedTileMapFormat::isOrderedBefore)};
+    if ((it == entries.end()) || (it->x != target.x) || (it->y != target.y)
+        || (it->z != target.z)) {
+        return -1;
+    }
+
+    return (it - entries.begin());
+}
+
+bool IndexedTileMapReader::decodeChunkTiles(
+    std::size_t entryIndex, ChunkSnapshot& outChunkSnapshot,
+    std::vector<Uint32>& outPaletteIndices,
+    std::vector<Uint8>& decompressBuffer) const
+{
+    const IndexedTileMapFormat::IndexEntry& entry{index[entryIndex]};
+    const Uint8* blockData{mappedFile.getData() + entry.offset};
+
+    // Read the palette references from the start of the block.
+    using InputAdapter = bitsery::InputBufferAdapter<const Uint8*>;
+    IndexedTileMapFormat::ChunkPaletteReferences references{};
+    bitsery::Deserializer<InputAdapter> deserializer{
+        InputAdapter{blockData, entry.size}};
+    deserializer.object(references);
+    if (deserializer.adapter().error() != bitsery::ReaderError::NoError) {
+        return false;
+    }
+    for (Uint32 paletteIndex : references.paletteIndices) {
+        if (paletteIndex >= paletteTable.entries.size()) {
+            return false;
+        }
+    }
+    outPaletteIndices = std::move(references.paletteIndices);
+
+    // The rest of the block is the chunk.
+    std::size_t referencesSize{deserializer.adapter().currentReadPos()};
+    const Uint8* serializedData{blockData + referencesSize};
+    std::size_t serializedSize{entry.size - referencesSize};
+
+    // If the chunk is compressed, decompress it into the given buffer.
+    // Otherwise, deserialize straight from the mapped file.
+    ChunkCodec codec{static_cast<ChunkCodec>(entry.codec)};
+    if (codec != ChunkCodec::None) {
+        if (!ChunkCodecs::decompress(codec, serializedData, serializedSize,
+                                     entry.decodedSize, decompressBuffer)) {
+            return false;
+        }
+        serializedData = decompressBuffer.data();
+        serializedSize = entry.decodedSize;
+    }
+
+    auto state{bitsery::quickDeserialization(
+        InputAdapter{serializedData, serializedSize}, outChunkSnapshot)};
+
+    return (state.first == bitsery::ReaderError::NoError) && state.second;
+}
+
+bool IndexedTileMapReader::decodeChunk(
+    std::size_t entryIndex, ChunkSnapshot& outChunkSnapshot,
+    std::vector<Uint8>& decompressBuffer) const
+{
+    std::vector<Uint32> paletteIndices{};
+    if (!decodeChunkTiles(entryIndex, outChunkSnapshot, paletteIndices,
+                          decompressBuffer)) {
+        return false;
+    }
+
+    // Fill the chunk's palette from the palette table.
+    outChunkSnapshot.palette.clear();
+    outChunkSnapshot.palette.reserve(paletteIndices.size());
+    for (Uint32 paletteIndex : paletteIndices) {
+        outChunkSnapshot.palette.push_back(paletteTable.entries[paletteIndex]);
+    }
+
+    return true;
+}
+
+bool IndexedTileMapReader::decodeAll(unsigned int threadCount)
+{
+    // Each thread claims the next entry until there are none left. Every
+    // entry has its own slot in decodedChunks, so no locking is needed.
+    std::atomic<std::size_t> nextEntryIndex{0};
+    std::atomic<bool> decodeFailed{false};
+    auto decodeEntries = [&]() {
+        std::vector<Uint8> decompressBuffer{};
+        std::size_t entryIndex{nextEntryIndex++};
+        while ((entryIndex < decodedChunks.size()) && !decodeFailed) {
+            std::unique_ptr<ChunkSnapshot>& decodedChunk{
+                decodedChunks[entryIndex]};
+            if (!decodedChunk) {
+                auto chunkSnapshot{std::make_unique<ChunkSnapshot>()};
+                if (!decodeChunk(entryIndex, *chunkSnapshot,
+                                 decompressBuffer)) {
+                    decodeFailed = true;
+                    break;
+                }
+                decodedChunk = std::move(chunkSnapshot);
+            }
+
+            entryIndex = nextEntryIndex++;
+        }
+    };
+
+    // Decode, using this thread as one of the workers.
+    std::vector<std::thread> workerThreads{};
+    for (unsigned int i{1}; i < threadCount; ++i) {
+        workerThreads.emplace_back(decodeEntries);
+    }
+    decodeEntries();
+    for (std::thread& workerThread : workerThreads) {
+        workerThread.join();
+    }
+
+    return !decodeFailed;
+}
+
+const ChunkSnapshot*
+    IndexedTileMapReader::getChunk(const ChunkPosition& chunkPosition)
+{
+    std::ptrdiff_t entryIndex{findEntry(chunkPosition)};
+    if (entryIndex < 0) {
+        return nullptr;
+    }
+
+    // If this is the first access, decode the chunk.
+    std::unique_ptr<ChunkSnapshot>& decodedChunk{decodedChunks[entryIndex]};
+    if (!decodedChunk) {
+        auto chunkSnapshot{std::make_unique<ChunkSnapshot>()};
+        if (!decodeChunk(entryIndex, *chunkSnapshot, scratchBuffer)) {
+            return nullptr;
+        }
+        decodedChunk = std::move(chunkSnapshot);
+    }
+
+    return decodedChunk.get();
+}
+
+} // End namespace AM
@@ -0,0 +1,206 @@
+#include "IndexedTileMapWriter.h"
+#include "bitsery/bitsery.h"
+#include "bitsery/adapter/buffer.h"
+#include <algorithm>
+#include <type_traits>
+
+namespace AM
+{
+IndexedTileMapWriter::IndexedTileMapWriter(
+    const std::string& filePath, Uint16 mapVersion, Uint16 xLengthChunks,
+    Uint16 yLengthChunks, Uint16 zLengthChunks, std::size_t chunkCount,
+    std::size_t inMaxBufferedEntries, ChunkCodec inCodec)
+: file{filePath, std::ios::binary}
+, header{}
+, codec{inCodec}
+, paletteTable{}
+, paletteIndices{}
+, paletteReferenceBuffer{}
+, index{}
+, nextBlockOffset{sizeof(IndexedTileMapFormat::Header)
+                  + (chunkCount * sizeof(IndexedTileMapFormat::IndexEntry))}
+, blockBuffer{inMaxBufferedEntries}
+, fileMutex{}
+{
+    header.mapVersion = mapVersion;
+    header.xLengthChunks = xLengthChunks;
+    header.yLengthChunks = yLengthChunks;
+    header.zLengthChunks = zLengthChunks;
+    header.chunkCount = static_cast<Uint32>(chunkCount);
+    index.reserve(chunkCount);
+
+    if (!(file.is_open())) {
+        return;
+    }
+
+    // Reserve space for the header and index. They're filled in by finish().
+    std::vector<char> placeholder(static_cast<std::size_t>(nextBlockOffset));
+    file.write(placeholder.data(), placeholder.size());
+}
+
+bool IndexedTileMapWriter::isOpen() const
+{
+    return file.is_open();
+}
+
+bool IndexedTileMapWriter::compactPalette(ChunkSnapshot& chunkSnapshot)
+{
+    // Find which entries are used by a tile layer.
+    std::vector<bool> isUsed(chunkSnapshot.palette.size(), false);
+    for (auto paletteIndex : chunkSnapshot.tileLayers) {
+        // If the chunk is corrupt, fail.
+        if (paletteIndex >= chunkSnapshot.palette.size()) {
+            return false;
+        }
+        isUsed[paletteIndex] = true;
+    }
+
+    // Move the used entries down, tracking where each one went.
+    using PaletteIndex
+        = std::decay_t<decltype(chunkSnapshot.tileLayers)>::value_type;
+    std::vector<PaletteIndex> newIndices(chunkSnapshot.palette.size(), 0);
+    std::size_t usedCount{0};
+    for (std::size_t i{0}; i < chunkSnapshot.palette.size(); ++i) {
+        if (isUsed[i]) {
+            newIndices[i] = static_cast<PaletteIndex>(usedCount);
+            if (i != usedCount) {
+                chunkSnapshot.palette[usedCount]
+                    = std::move(chunkSnapshot.palette[i]);
+            }
+            usedCount++;
+        }
+    }
+
+    if (usedCount < chunkSnapshot.palette.size()) {
+        chunkSnapshot.palette.resize(usedCount);
+        for (auto& paletteIndex : chunkSnapshot.tileLayers) {
+            paletteIndex = newIndices[paletteIndex];
+        }
+    }
+
+    return true;
+}
+
+bool IndexedTileMapWriter::encodeChunk(ChunkSnapshot& chunkSnapshot,
+                                       std::vector<Uint8>& serializationBuffer,
+                                       EncodedChunk& outEncodedChunk) const
+{
+    // Pull out the palette. It'll be stored in the palette table instead.
+    if (!compactPalette(chunkSnapshot)) {
+        return false;
+    }
+    outEncodedChunk.palette = std::move(chunkSnapshot.palette);
+    chunkSnapshot.palette.clear();
+
+    using OutputAdapter = bitsery::OutputBufferAdapter<std::vector<Uint8>>;
+    std::size_t serializedSize{bitsery::quickSerialization(
+        OutputAdapter{serializationBuffer}, chunkSnapshot)};
+
+    outEncodedChunk.decodedSize = serializedSize;
+    return ChunkCodecs::compress(codec, serializationBuffer.data(),
+                                 serializedSize, outEncodedChunk.blockData);
+}
+
+void IndexedTileMapWriter::writeChunk(std::size_t entryIndex,
+                                      const ChunkPosition& chunkPosition,
+                                      EncodedChunk encodedChunk)
+{
+    blockBuffer.push(entryIndex,
+                     BufferedBlock{chunkPosition, std::move(encodedChunk)},
+                     [&](BufferedBlock& block) { writeBlock(block); });
+}
+
+std::size_t IndexedTileMapWriter::getPaletteEntryCount()
+{
+    std::scoped_lock lock{fileMutex};
+    return paletteTable.entries.size();
+}
+
+bool IndexedTileMapWriter::finish()
+{
+    // Note: Every writeChunk() call must have returned before this is
+    //       called.
+    bool allBlocksWritten{blockBuffer.isEmpty()};
+
+    std::scoped_lock lock{fileMutex};
+    if (!(file.is_open()) || (index.size() != header.chunkCount)
+        || !allBlocksWritten) {
+        file.close();
+        return false;
+    }
+
+    // Write the palette table after the last block.
+    std::vector<Uint8> paletteTableBuffer{};
+    using OutputAdapter = bitsery::OutputBufferAdapter<std::vector<Uint8>>;
+    std::size_t paletteTableSize{bitsery::quickSerialization(
+        OutputAdapter{paletteTableBuffer}, paletteTable)};
+    file.write(reinterpret_cast<const char*>(paletteTableBuffer.data()),
+               paletteTableSize);
+    header.paletteEntryCount = static_cast<Uint32>(paletteTable.entries.size());
+    header.paletteTableOffset = nextBlockOffset;
+
+    // Sort the index so readers can binary search it.
+    std::sort(index.begin(), index.end(),
+              IndexedTileMapFormat::isOrderedBefore);
+
+    // Fill in the header and index.
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(index.data()),
+               (index.size() * sizeof(IndexedTileMapFormat::IndexEntry)));
+    file.close();
+
+    return !(file.fail());
+}
+
+void IndexedTileMapWriter::writeBlock(BufferedBlock& block)
+{
+    std::scoped_lock lock{fileMutex};
+
+    // Replace the chunk's palette with references to the palette table.
+    // Note: We do this here instead of in encodeChunk() so that the table's
+    //       order doesn't depend on thread timing.
+    IndexedTileMapFormat::ChunkPaletteReferences references{};
+    for (ChunkSnapshot::PaletteEntry& paletteEntry :
+         block.encodedChunk.palette) {
+        references.paletteIndices.push_back(internPaletteEntry(paletteEntry));
+    }
+
+    using OutputAdapter = bitsery::OutputBufferAdapter<std::vector<Uint8>>;
+    std::size_t referencesSize{bitsery::quickSerialization(
+        OutputAdapter{paletteReferenceBuffer}, references)};
+    file.write(reinterpret_cast<const char*>(paletteReferenceBuffer.data()),
+               referencesSize);
+
+    const std::vector<Uint8>& blockData{block.encodedChunk.blockData};
+    file.write(reinterpret_cast<const char*>(blockData.data()),
+               blockData.size());
+
+    IndexedTileMapFormat::IndexEntry entry{};
+    entry.x = block.chunkPosition.x;
+    entry.y = block.chunkPosition.y;
+    entry.z = block.chunkPosition.z;
+    entry.size = static_cast<Uint32>(referencesSize + blockData.size());
+    entry.offset = nextBlockOffset;
+    entry.decodedSize = static_cast<Uint32>(block.encodedChunk.decodedSize);
+    entry.codec = static_cast<Uint8>(codec);
+    index.push_back(entry);
+
+    nextBlockOffset += entry.size;
+}
+
+Uint32 IndexedTileMapWriter::internPaletteEntry(
+    ChunkSnapshot::PaletteEntry& paletteEntry)
+{
+    auto [it, wasInserted]{paletteIndices.try_emplace(
+        {static_cast<Uint8>(paletteEntry.layerType), paletteEntry.graphicSetID,
+         paletteEntry.graphicValue},
+        static_cast<Uint32>(paletteTable.entries.size()))};
+    if (wasInserted) {
+        paletteTable.entries.push_back(std::move(paletteEntry));
+    }
+
+    return it->second;
+}
+
+} // End namespace AM
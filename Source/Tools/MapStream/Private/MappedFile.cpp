@@ -0,0 +1,124 @@
+#include "MappedFile.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace AM
+{
+MappedFile::MappedFile()
+: data{nullptr}
+, size{0}
+#if defined(_WIN32)
+, fileHandle{nullptr}
+, mappingHandle{nullptr}
+#endif
+{
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+bool MappedFile::open(const std::string& filePath)
+{
+    close();
+
+#if defined(_WIN32)
+    HANDLE file{CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                            nullptr)};
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(file, &fileSize) || (fileSize.QuadPart == 0)) {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping{
+        CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr)};
+    if (mapping == nullptr) {
+        CloseHandle(file);
+        return false;
+    }
+
+    void* view{MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)};
+    if (view == nullptr) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    fileHandle = file;
+    mappingHandle = mapping;
+    data = static_cast<const Uint8*>(view);
+    size = static_cast<std::size_t>(fileSize.QuadPart);
+#else
+    int file{::open(filePath.c_str(), O_RDONLY)};
+    if (file < 0) {
+        return false;
+    }
+
+    struct stat fileStats{};
+    if ((fstat(file, &fileStats) != 0) || (fileStats.st_size == 0)) {
+        ::close(file);
+        return false;
+    }
+
+    void* view{mmap(nullptr, static_cast<std::size_t>(fileStats.st_size),
+                    PROT_READ, MAP_PRIVATE, file, 0)};
+
+    // Note: The mapping stays valid after the descriptor is closed.
+    ::close(file);
+    if (view == MAP_FAILED) {
+        return false;
+    }
+
+    data = static_cast<const Uint8*>(view);
+    size = static_cast<std::size_t>(fileStats.st_size);
+#endif
+
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (data == nullptr) {
+        return;
+    }
+
+#if defined(_WIN32)
+    UnmapViewOfFile(data);
+    CloseHandle(mappingHandle);
+    CloseHandle(fileHandle);
+    fileHandle = nullptr;
+    mappingHandle = nullptr;
+#else
+    munmap(const_cast<Uint8*>(data), size);
+#endif
+
+    data = nullptr;
+    size = 0;
+}
+
+const Uint8* MappedFile::getData() const
+{
+    return data;
+}
+
+std::size_t MappedFile::getSize() const
+{
+    return size;
+}
+
+} // End namespace AM
@@ -0,0 +1,32 @@
+#include "TempFile.h"
+#include <filesystem>
+
+namespace AM
+{
+namespace TempFile
+{
+Result writeAndReplace(const std::string& outputPath,
+                       const std::function<bool(const std::string&)>& write,
+                       std::error_code& outErrorCode)
+{
+    // Write into a temporary file next to the output, so the rename doesn't
+    // cross file systems.
+    std::string tempPath{outputPath + ".tmp"};
+    if (!write(tempPath)) {
+        std::filesystem::remove(tempPath, outErrorCode);
+        return Result::WriteFailed;
+    }
+
+    // Replace the output.
+    std::filesystem::rename(tempPath, outputPath, outErrorCode);
+    if (outErrorCode) {
+        std::error_code removeErrorCode{};
+        std::filesystem::remove(tempPath, removeErrorCode);
+        return Result::ReplaceFailed;
+    }
+
+    return Result::Success;
+}
+
+} // namespace TempFile
+} // End namespace AM
@@ -0,0 +1,119 @@
+#include "TileMapStreamReader.h"
+#include "bitsery/bitsery.h"
+#include "bitsery/adapter/buffer.h"
+#include "bitsery/details/serialization_common.h"
+#include <type_traits>
+
+namespace AM
+{
+using InputAdapter = bitsery::InputBufferAdapter<const Uint8*>;
+
+TileMapStreamReader::TileMapStreamReader()
+: mappedFile{}
+, version{0}
+, xLengthChunks{0}
+, yLengthChunks{0}
+, zLengthChunks{0}
+, chunkCount{0}
+, readCount{0}
+, readOffset{0}
+, lastEntryOffset{0}
+{
+}
+
+bool TileMapStreamReader::open(const std::string& filePath)
+{
+    chunkCount = 0;
+    readCount = 0;
+    readOffset = 0;
+    lastEntryOffset = 0;
+    if (!(mappedFile.open(filePath))) {
+        return false;
+    }
+
+    // Read the header.
+    // Note: This must match serialize(TileMapSnapshot). See
+    //       TileMapStreamWriter.
+    bitsery::Deserializer<InputAdapter> deserializer{
+        InputAdapter{mappedFile.getData(), mappedFile.getSize()}};
+    deserializer.value2b(version);
+    deserializer.value2b(xLengthChunks);
+    deserializer.value2b(yLengthChunks);
+    deserializer.value2b(zLengthChunks);
+    bitsery::details::readSize(deserializer.adapter(), chunkCount,
+                               mappedFile.getSize(), std::true_type{});
+    if (deserializer.adapter().error() != bitsery::ReaderError::NoError) {
+        chunkCount = 0;
+        mappedFile.close();
+        return false;
+    }
+
+    readOffset = deserializer.adapter().currentReadPos();
+    lastEntryOffset = readOffset;
+    return true;
+}
+
+void TileMapStreamReader::close()
+{
+    mappedFile.close();
+}
+
+Uint16 TileMapStreamReader::getVersion() const
+{
+    return version;
+}
+
+Uint16 TileMapStreamReader::getXLengthChunks() const
+{
+    return xLengthChunks;
+}
+
+Uint16 TileMapStreamReader::getYLengthChunks() const
+{
+    return yLengthChunks;
+}
+
+Uint16 TileMapStreamReader::getZLengthChunks() const
+{
+    return zLengthChunks;
+}
+
+std::size_t TileMapStreamReader::getChunkCount() const
+{
+    return chunkCount;
+}
+
+bool TileMapStreamReader::readChunkEntry(ChunkPosition& outChunkPosition,
+                                         ChunkSnapshot& outChunkSnapshot)
+{
+    if (readCount >= chunkCount) {
+        return false;
+    }
+
+    bitsery::Deserializer<InputAdapter> deserializer{
+        InputAdapter{(mappedFile.getData() + readOffset),
+                     (mappedFile.getSize() - readOffset)}};
+    deserializer.object(outChunkPosition);
+    deserializer.object(outChunkSnapshot);
+    if (deserializer.adapter().error() != bitsery::ReaderError::NoError) {
+        return false;
+    }
+
+    lastEntryOffset = readOffset;
+    readOffset += deserializer.adapter().currentReadPos();
+    readCount++;
+    return true;
+}
+
+bool TileMapStreamReader::isAtEnd() const
+{
+    return (readCount == chunkCount);
+}
+
+std::span<const Uint8> TileMapStreamReader::getLastEntryData() const
+{
+    return {(mappedFile.getData() + lastEntryOffset),
+            (readOffset - lastEntryOffset)};
+}
+
+} // End namespace AM
@@ -0,0 +1,77 @@
+#include "TileMapStreamWriter.h"
+#include "bitsery/bitsery.h"
+#include "bitsery/adapter/buffer.h"
+#include "bitsery/details/serialization_common.h"
+
+namespace AM
+{
+using OutputAdapter = bitsery::OutputBufferAdapter<std::vector<Uint8>>;
+
+TileMapStreamWriter::TileMapStreamWriter(
+    const std::string& filePath, Uint16 version, Uint16 xLengthChunks,
+    Uint16 yLengthChunks, Uint16 zLengthChunks, std::size_t inChunkCount,
+    std::size_t inMaxBufferedEntries)
+: file{filePath, std::ios::binary}
+, chunkCount{inChunkCount}
+, entryBuffer{inMaxBufferedEntries}
+{
+    if (!(file.is_open())) {
+        return;
+    }
+
+    // Write the header.
+    // Note: This must match serialize(TileMapSnapshot). The chunk map's size
+    //       is written the same way that bitsery writes container sizes.
+    std::vector<Uint8> buffer{};
+    bitsery::Serializer<OutputAdapter> serializer{buffer};
+    serializer.value2b(version);
+    serializer.value2b(xLengthChunks);
+    serializer.value2b(yLengthChunks);
+    serializer.value2b(zLengthChunks);
+    bitsery::details::writeSize(serializer.adapter(), chunkCount);
+    serializer.adapter().flush();
+
+    file.write(reinterpret_cast<const char*>(buffer.data()),
+               serializer.adapter().writtenBytesCount());
+}
+
+bool TileMapStreamWriter::isOpen() const
+{
+    return file.is_open();
+}
+
+std::size_t TileMapStreamWriter::serializeChunkEntry(
+    ChunkPosition chunkPosition, ChunkSnapshot& chunkSnapshot,
+    std::vector<Uint8>& buffer)
+{
+    bitsery::Serializer<OutputAdapter> serializer{buffer};
+    serializer.object(chunkPosition);
+    serializer.object(chunkSnapshot);
+    serializer.adapter().flush();
+
+    return serializer.adapter().writtenBytesCount();
+}
+
+void TileMapStreamWriter::writeChunkEntry(std::size_t entryIndex,
+                                          std::vector<Uint8> entryData)
+{
+    // Note: The buffer only writes one entry at a time, so we don't need to
+    //       guard the file.
+    entryBuffer.push(entryIndex, std::move(entryData),
+                     [&](const std::vector<Uint8>& orderedEntryData) {
+        file.write(reinterpret_cast<const char*>(orderedEntryData.data()),
+                   orderedEntryData.size());
+    });
+}
+
+bool TileMapStreamWriter::finish()
+{
+    // Note: Every writeChunkEntry() call must have returned before this is
+    //       called.
+    file.close();
+
+    return !(file.fail()) && (entryBuffer.getWrittenCount() == chunkCount)
+           && entryBuffer.isEmpty();
+}
+
+} // End namespace AM
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <SDL_stdinc.h>
+#include <string>
+#include <vector>
+
+namespace AM
+{
+/**
+ * The compression codecs that an indexed map's chunk blocks may use.
+ *
+ * Note: These values are stored in map files, so don't reorder them.
+ */
+enum class ChunkCodec : Uint8 {
+    /** Stored as-is. */
+    None,
+    /** Byte-level run-length encoding. Always available. Generated maps
+        are mostly long runs of the same palette indices and layer counts,
+        so this alone removes most of their size. */
+    RunLength,
+    /** LZ4 block compression. Only available if MapStream was built with
+        LZ4 (MAPSTREAM_HAS_LZ4). */
+    LZ4,
+    /** Zstandard compression. Slower than LZ4, but smaller. Only available
+        if MapStream was built with zstd (MAPSTREAM_HAS_ZSTD). */
+    Zstd
+};
+
+namespace ChunkCodecs
+{
+/**
+ * Returns true if the given codec was compiled in.
+ */
+bool isAvailable(ChunkCodec codec);
+
+/**
+ * Returns the given codec's name, as used on the command line.
+ */
+const char* toString(ChunkCodec codec);
+
+/**
+ * Parses the given codec name.
+ * @return true if successful, else false.
+ */
+bool fromString(const std::string& codecName, ChunkCodec& outCodec);
+
+/**
+ * Compresses the given data, replacing the contents of outData.
+ * @return true if successful, else false.
+ */
+bool compress(ChunkCodec codec, const Uint8* data, std::size_t size,
+              std::vector<Uint8>& outData);
+
+/**
+ * Decompresses the given data, replacing the contents of outData.
+ *
+ * @param decodedSize The size of the original data.
+ * @return true if successful, else false.
+ */
+bool decompress(ChunkCodec codec, const Uint8* data, std::size_t size,
+                std::size_t decodedSize, std::vector<Uint8>& outData);
+
+} // namespace ChunkCodecs
+} // End namespace AM
@@ -0,0 +1,162 @@
+#pragma once
+
+#include "TileMapSnapshot.h"
+#include "bitsery/bitsery.h"
+#include "bitsery/ext/compact_value.h"
+#include "bitsery/traits/string.h"
+#include "bitsery/traits/vector.h"
+#include <SDL_stdinc.h>
+#include <type_traits>
+#include <vector>
+
+namespace AM
+{
+/**
+ * The layout of an indexed tile map file.
+ *
+ * Unlike TileMap.bin (a single serialized TileMapSnapshot), an indexed map
+ * starts with a fixed-size index of every chunk's location. A reader can
+ * map the file and decode individual chunks on first access, without
+ * touching the rest of the file.
+ *
+ * Layout:
+ *   Header
+ *   IndexEntry[header.chunkCount], sorted by (z, y, x)
+ *   Chunk blocks
+ *   Palette table (a serialized PaletteTable)
+ *
+ * Each chunk block is a serialized ChunkPaletteReferences, followed by the
+ * chunk's serialized ChunkSnapshot (with an empty palette), compressed with
+ * the codec in its index entry.
+ *
+ * Chunks don't store their own palette entries. Instead, each unique entry
+ * is stored once in the map-wide palette table, and chunks refer to them by
+ * index. This keeps repeated graphic set IDs out of the chunk blocks, and
+ * lets readers share one copy of each string.
+ *
+ * The header and index are stored as raw little-endian structs, so they can
+ * be used directly from the mapped file.
+ */
+namespace IndexedTileMapFormat
+{
+/** Identifies an indexed map file. */
+static constexpr Uint32 MAGIC{0x58494D41}; // "AMIX"
+
+/** The version of the indexed file layout.
+    1: Initial version.
+    2: Added per-chunk compression.
+    3: Added the map-wide palette table. */
+static constexpr Uint16 FORMAT_VERSION{3};
+
+/** The max length of a graphic set ID in the palette table. */
+static constexpr std::size_t MAX_GRAPHIC_SET_ID_LENGTH{255};
+
+struct Header {
+    Uint32 magic{MAGIC};
+    Uint16 formatVersion{FORMAT_VERSION};
+
+    /** The TileMapSnapshot version that the chunks were saved with. */
+    Uint16 mapVersion{0};
+
+    /** The map's lengths, in chunks. */
+    Uint16 xLengthChunks{0};
+    Uint16 yLengthChunks{0};
+    Uint16 zLengthChunks{0};
+
+    /** Pads the header so the index is 8-byte aligned. */
+    Uint16 padding{0};
+
+    /** The number of entries in the index. */
+    Uint32 chunkCount{0};
+
+    /** The number of entries in the palette table. */
+    Uint32 paletteEntryCount{0};
+
+    /** The offset, in bytes, from the start of the file to the palette
+        table. The table extends to the end of the file. */
+    Uint64 paletteTableOffset{0};
+};
+
+struct IndexEntry {
+    /** The chunk's position. */
+    Sint32 x{0};
+    Sint32 y{0};
+    Sint32 z{0};
+
+    /** The size, in bytes, of the chunk's block, including its palette
+        references. */
+    Uint32 size{0};
+
+    /** The offset, in bytes, from the start of the file to the chunk's
+        block. */
+    Uint64 offset{0};
+
+    /** The size, in bytes, of the chunk's serialized ChunkSnapshot after
+        it's decompressed. */
+    Uint32 decodedSize{0};
+
+    /** The ChunkCodec that the block was compressed with. */
+    Uint8 codec{0};
+
+    Uint8 padding[3]{};
+};
+
+/**
+ * The map-wide palette table. Every palette entry used by the map's chunks,
+ * without duplicates.
+ */
+struct PaletteTable {
+    std::vector<ChunkSnapshot::PaletteEntry> entries{};
+};
+
+template<typename S>
+void serialize(S& serializer, PaletteTable& paletteTable)
+{
+    serializer.container(paletteTable.entries, UINT32_MAX,
+                         [](S& serializer, ChunkSnapshot::PaletteEntry& entry) {
+                             serializer.value1b(entry.layerType);
+                             serializer.text1b(entry.graphicSetID,
+                                               MAX_GRAPHIC_SET_ID_LENGTH);
+                             serializer.value1b(entry.graphicValue);
+                         });
+}
+
+/**
+ * The start of each chunk block. Indices into the palette table, in the
+ * order of the chunk's palette.
+ */
+struct ChunkPaletteReferences {
+    std::vector<Uint32> paletteIndices{};
+};
+
+template<typename S>
+void serialize(S& serializer, ChunkPaletteReferences& references)
+{
+    serializer.container(references.paletteIndices, UINT32_MAX,
+                         [](S& serializer, Uint32& paletteIndex) {
+                             serializer.ext4b(paletteIndex,
+                                              bitsery::ext::CompactValue{});
+                         });
+}
+
+static_assert(sizeof(Header) == 32);
+static_assert(sizeof(IndexEntry) == 32);
+static_assert(std::is_trivially_copyable_v<Header>
+              && std::is_trivially_copyable_v<IndexEntry>);
+
+/**
+ * Returns true if entry a should come before entry b in the index.
+ */
+inline bool isOrderedBefore(const IndexEntry& a, const IndexEntry& b)
+{
+    if (a.z != b.z) {
+        return a.z < b.z;
+    }
+    else if (a.y != b.y) {
+        return a.y < b.y;
+    }
+    return a.x < b.x;
+}
+
+} // namespace IndexedTileMapFormat
+} // End namespace AM
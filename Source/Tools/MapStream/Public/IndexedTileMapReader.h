@@ -0,0 +1,133 @@
+#pragma once
+
+#include "IndexedTileMapFormat.h"
+#include "MappedFile.h"
+#include "ChunkPosition.h"
+#include "TileMapSnapshot.h"
+#include <SDL_stdinc.h>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace AM
+{
+/**
+ * Reads an indexed tile map file (see IndexedTileMapFormat.h).
+ *
+ * The file is memory-mapped, and only the header, index, and palette table
+ * are read when it's opened. Chunks are decoded on first access, so opening
+ * is fast and untouched chunks never use any memory.
+ */
+class IndexedTileMapReader
+{
+public:
+    IndexedTileMapReader();
+
+    /**
+     * Maps the file at the given path, validates its header and index, and
+     * loads its palette table.
+     *
+     * Fails if any chunk uses a codec that isn't available in this build.
+     *
+     * @return true if successful, else false.
+     */
+    bool open(const std::string& filePath);
+
+    /**
+     * Returns true if the file at the given path is an indexed map.
+     */
+    static bool isIndexedMap(const std::string& filePath);
+
+    const IndexedTileMapFormat::Header& getHeader() const;
+
+    /**
+     * Returns the index, sorted by (z, y, x).
+     */
+    std::span<const IndexedTileMapFormat::IndexEntry> getIndex() const;
+
+    /**
+     * Returns the map-wide palette table. Each unique palette entry is
+     * stored once, and chunks refer to them by index.
+     */
+    std::span<const ChunkSnapshot::PaletteEntry> getPaletteTable() const;
+
+    /**
+     * Returns the index of the given chunk's entry, or -1 if the map doesn't
+     * contain it.
+     */
+    std::ptrdiff_t findEntry(const ChunkPosition& chunkPosition) const;
+
+    /**
+     * Decodes the given entry's chunk into the given snapshot, without
+     * filling its palette. Instead, outPaletteIndices is filled with the
+     * palette's indices into getPaletteTable().
+     *
+     * This avoids copying any graphic set IDs, so it's preferable when the
+     * full snapshot isn't needed.
+     *
+     * Thread-safe. Doesn't cache the result.
+     *
+     * @param decompressBuffer See decodeChunk().
+     * @return true if successful, else false.
+     */
+    bool decodeChunkTiles(std::size_t entryIndex,
+                          ChunkSnapshot& outChunkSnapshot,
+                          std::vector<Uint32>& outPaletteIndices,
+                          std::vector<Uint8>& decompressBuffer) const;
+
+    /**
+     * Decodes the given entry's chunk into the given snapshot.
+     *
+     * Thread-safe. Doesn't cache the result.
+     *
+     * @param decompressBuffer If the chunk is compressed, it's decompressed
+     *                         into this buffer. Reusing it across calls
+     *                         avoids reallocating.
+     * @return true if successful, else false.
+     */
+    bool decodeChunk(std::size_t entryIndex, ChunkSnapshot& outChunkSnapshot,
+                     std::vector<Uint8>& decompressBuffer) const;
+
+    /**
+     * Decodes every chunk that hasn't been accessed yet, split across the
+     * given number of threads. Afterwards, getChunk() won't need to decode.
+     *
+     * Not thread-safe.
+     *
+     * @return true if every chunk decoded successfully, else false.
+     */
+    bool decodeAll(unsigned int threadCount);
+
+    /**
+     * Returns the given chunk, decoding it if this is the first access.
+     *
+     * Not thread-safe. Use decodeAll() or decodeChunk() to decode on
+     * multiple threads.
+     *
+     * @return The chunk if the map contains it and it decoded successfully,
+     *         else nullptr.
+     */
+    const ChunkSnapshot* getChunk(const ChunkPosition& chunkPosition);
+
+private:
+    MappedFile mappedFile;
+
+    /** Points into mappedFile. */
+    const IndexedTileMapFormat::Header* header;
+
+    /** Points into mappedFile. */
+    const IndexedTileMapFormat::IndexEntry* index;
+
+    /** The map-wide palette table. */
+    IndexedTileMapFormat::PaletteTable paletteTable;
+
+    /** Chunks that have been accessed through getChunk(). Index-matched with
+        the file's index. */
+    std::vector<std::unique_ptr<ChunkSnapshot>> decodedChunks;
+
+    /** Used by getChunk() to decompress chunks. */
+    std::vector<Uint8> scratchBuffer;
+};
+
+} // End namespace AM
@@ -0,0 +1,162 @@
+#pragma once
+
+#include "IndexedTileMapFormat.h"
+#include "ChunkCodec.h"
+#include "ChunkPosition.h"
+#include "TileMapSnapshot.h"
+#include "OrderedWriteBuffer.h"
+#include <SDL_stdinc.h>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <tuple>
+#include <mutex>
+
+namespace AM
+{
+/**
+ * Writes an indexed tile map file (see IndexedTileMapFormat.h) one chunk at
+ * a time.
+ *
+ * Like TileMapStreamWriter, chunks may be encoded on multiple threads and
+ * are written in entry order, with a bounded number buffered. Space for the
+ * index is reserved up front and filled in by finish().
+ */
+class IndexedTileMapWriter
+{
+public:
+    /**
+     * A chunk that's been serialized and compressed, ready to be written.
+     */
+    struct EncodedChunk {
+        /** The chunk's palette. Replaced with references to the palette
+            table when the chunk is written. */
+        std::vector<ChunkSnapshot::PaletteEntry> palette{};
+
+        /** The compressed chunk, without its palette. */
+        std::vector<Uint8> blockData{};
+
+        /** The size of the serialized chunk, before compression. */
+        std::size_t decodedSize{0};
+    };
+
+    /**
+     * Opens the given file and reserves space for the header and index.
+     *
+     * @param chunkCount The number of chunks that will be written.
+     * @param maxBufferedEntries How many chunks may be waiting to be written
+     *                           before threads block.
+     * @param codec The codec to compress chunks with. Must be available.
+     */
+    IndexedTileMapWriter(const std::string& filePath, Uint16 mapVersion,
+                         Uint16 xLengthChunks, Uint16 yLengthChunks,
+                         Uint16 zLengthChunks, std::size_t chunkCount,
+                         std::size_t maxBufferedEntries, ChunkCodec codec);
+
+    /**
+     * Returns true if the file was successfully opened.
+     */
+    bool isOpen() const;
+
+    /**
+     * Removes any palette entries that the given chunk's tiles don't use.
+     * @return true if successful. false if a tile layer refers to a palette
+     *         entry that doesn't exist, in which case the chunk is left
+     *         unchanged.
+     */
+    static bool compactPalette(ChunkSnapshot& chunkSnapshot);
+
+    /**
+     * Compacts the given chunk's palette and moves it out of the chunk, then
+     * serializes the rest of the chunk (using the given buffer) and
+     * compresses it with our codec.
+     *
+     * Thread-safe.
+     *
+     * @return true if successful. false if the chunk's palette couldn't be
+     *         compacted or the chunk couldn't be compressed.
+     */
+    bool encodeChunk(ChunkSnapshot& chunkSnapshot,
+                     std::vector<Uint8>& serializationBuffer,
+                     EncodedChunk& outEncodedChunk) const;
+
+    /**
+     * Writes the given chunk block.
+     *
+     * If earlier entries haven't been written yet, this block will be
+     * buffered until they are. If too many blocks are buffered, blocks until
+     * there's room.
+     *
+     * Thread-safe.
+     *
+     * @param entryIndex This chunk's index, in [0, chunkCount).
+     */
+    void writeChunk(std::size_t entryIndex, const ChunkPosition& chunkPosition,
+                    EncodedChunk encodedChunk);
+
+    /**
+     * Returns the number of unique palette entries in the chunks that have
+     * been written so far.
+     */
+    std::size_t getPaletteEntryCount();
+
+    /**
+     * Writes the palette table, header, and index, then closes the file.
+     * @return true if every chunk was written successfully, else false.
+     */
+    bool finish();
+
+private:
+    /**
+     * Returns the given entry's index in the palette table, adding it if
+     * necessary. If added, the entry is moved from.
+     */
+    Uint32 internPaletteEntry(ChunkSnapshot::PaletteEntry& paletteEntry);
+
+    /**
+     * A chunk block that's waiting for earlier blocks to be written.
+     */
+    struct BufferedBlock {
+        ChunkPosition chunkPosition{};
+        EncodedChunk encodedChunk{};
+    };
+
+    /**
+     * Writes the given block to the file, at nextBlockOffset.
+     * Called by blockBuffer, in entry order.
+     */
+    void writeBlock(BufferedBlock& block);
+
+    std::ofstream file;
+
+    IndexedTileMapFormat::Header header;
+
+    /** The codec to compress chunks with. */
+    ChunkCodec codec;
+
+    /** The palette entries used by the blocks that have been written, in
+        the order they were first used. */
+    IndexedTileMapFormat::PaletteTable paletteTable;
+
+    /** Maps palette entries to their index in paletteTable. */
+    std::map<std::tuple<Uint8, std::string, Uint8>, Uint32> paletteIndices;
+
+    /** Used for serializing palette references. */
+    std::vector<Uint8> paletteReferenceBuffer;
+
+    /** The index entries of the blocks that have been written. */
+    std::vector<IndexedTileMapFormat::IndexEntry> index;
+
+    /** The file offset that the next block will be written at. */
+    Uint64 nextBlockOffset;
+
+    /** Puts blocks back in order before they're written to the file. */
+    OrderedWriteBuffer<BufferedBlock> blockBuffer;
+
+    /** Guards the file, paletteTable, and index, since
+        getPaletteEntryCount() may be called while blocks are written. */
+    std::mutex fileMutex;
+};
+
+} // End namespace AM
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <SDL_stdinc.h>
+#include <string>
+
+namespace AM
+{
+/**
+ * A read-only memory-mapped file.
+ *
+ * Pages are only read from disk when they're first touched, so mapping a
+ * large file is close to free until its data is accessed.
+ */
+class MappedFile
+{
+public:
+    MappedFile();
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * Maps the file at the given path, unmapping any previous file.
+     * @return true if successful, else false.
+     */
+    bool open(const std::string& filePath);
+
+    /**
+     * Unmaps the current file, if one is mapped.
+     */
+    void close();
+
+    const Uint8* getData() const;
+
+    std::size_t getSize() const;
+
+private:
+    /** The start of the mapped file. */
+    const Uint8* data;
+
+    /** The size of the mapped file, in bytes. */
+    std::size_t size;
+
+#if defined(_WIN32)
+    /** The file and mapping handles. */
+    void* fileHandle;
+    void* mappingHandle;
+#endif
+};
+
+} // End namespace AM
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <condition_variable>
+#include <utility>
+
+namespace AM
+{
+/**
+ * Puts items that are produced out of order (e.g. by multiple threads) back
+ * into index order before they're written.
+ *
+ * Threads that get too far ahead of the oldest unwritten item will block, so
+ * memory use stays flat regardless of how many items there are.
+ *
+ * Used by the map writers, so their output doesn't depend on thread timing.
+ */
+template<typename T>
+class OrderedWriteBuffer
+{
+public:
+    /**
+     * @param inMaxBufferedItems How many items may be waiting to be written
+     *                           before threads block.
+     */
+    explicit OrderedWriteBuffer(std::size_t inMaxBufferedItems)
+    : maxBufferedItems{inMaxBufferedItems}
+    , nextIndex{0}
+    , bufferedItems{}
+    , bufferMutex{}
+    , bufferCondition{}
+    {
+    }
+
+    /**
+     * Buffers the given item, then passes every buffered item that's now in
+     * order to writeItem.
+     *
+     * If too many items are buffered, blocks until there's room.
+     *
+     * Thread-safe. writeItem is only called by one thread at a time.
+     *
+     * @param index This item's index. Each index must be pushed once.
+     * @param writeItem A callable that takes a T&.
+     */
+    template<typename WriteFunction>
+    void push(std::size_t index, T item, WriteFunction&& writeItem)
+    {
+        std::unique_lock lock{bufferMutex};
+
+        // If we're too far ahead of the oldest unwritten item, wait for it.
+        bufferCondition.wait(
+            lock, [&] { return index < (nextIndex + maxBufferedItems); });
+
+        bufferedItems.emplace(index, std::move(item));
+
+        // Write every item that's now in order.
+        bool wroteItem{false};
+        for (auto it{bufferedItems.begin()};
+             (it != bufferedItems.end()) && (it->first == nextIndex);
+             it = bufferedItems.erase(it)) {
+            writeItem(it->second);
+            nextIndex++;
+            wroteItem = true;
+        }
+
+        if (wroteItem) {
+            lock.unlock();
+            bufferCondition.notify_all();
+        }
+    }
+
+    /**
+     * Returns the number of items that have been written.
+     */
+    std::size_t getWrittenCount()
+    {
+        std::scoped_lock lock{bufferMutex};
+        return nextIndex;
+    }
+
+    /**
+     * Returns true if no items are waiting to be written.
+     */
+    bool isEmpty()
+    {
+        std::scoped_lock lock{bufferMutex};
+        return bufferedItems.empty();
+    }
+
+private:
+    /** How many items may be buffered before push() blocks. */
+    std::size_t maxBufferedItems;
+
+    /** The index of the next item to write. */
+    std::size_t nextIndex;
+
+    /** Items that are waiting for earlier items to be written. */
+    std::map<std::size_t, T> bufferedItems;
+
+    std::mutex bufferMutex;
+
+    /** Used to wake threads that are waiting for room in the buffer. */
+    std::condition_variable bufferCondition;
+};
+
+} // End namespace AM
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <system_error>
+
+namespace AM
+{
+namespace TempFile
+{
+/**
+ * The result of writeAndReplace().
+ */
+enum class Result {
+    Success,
+    /** The write function returned false. */
+    WriteFailed,
+    /** The temporary file couldn't be renamed over the output. */
+    ReplaceFailed
+};
+
+/**
+ * Writes a file with the given function, then moves it to the given path.
+ *
+ * The function is given a temporary path next to outputPath to write to.
+ * If it succeeds, the temporary file is renamed over outputPath, so
+ * outputPath is never left partially written. Otherwise, the temporary file
+ * is removed and outputPath is left untouched.
+ *
+ * @param outErrorCode If the rename fails, set to the reason.
+ */
+Result writeAndReplace(const std::string& outputPath,
+                       const std::function<bool(const std::string&)>& write,
+                       std::error_code& outErrorCode);
+
+} // namespace TempFile
+} // End namespace AM
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "MappedFile.h"
+#include "ChunkPosition.h"
+#include "TileMapSnapshot.h"
+#include <SDL_stdinc.h>
+#include <span>
+#include <string>
+
+namespace AM
+{
+/**
+ * Reads a tile map file one chunk at a time, without holding the whole
+ * TileMapSnapshot in memory.
+ *
+ * The counterpart to TileMapStreamWriter. The file is memory-mapped, so
+ * only the pages around the chunk being read are resident.
+ */
+class TileMapStreamReader
+{
+public:
+    TileMapStreamReader();
+
+    /**
+     * Maps the file at the given path and reads the map header.
+     * @return true if successful, else false.
+     */
+    bool open(const std::string& filePath);
+
+    /**
+     * Unmaps the file. Must be called before the file is replaced.
+     */
+    void close();
+
+    Uint16 getVersion() const;
+    Uint16 getXLengthChunks() const;
+    Uint16 getYLengthChunks() const;
+    Uint16 getZLengthChunks() const;
+
+    /**
+     * Returns the number of chunk entries in the file.
+     */
+    std::size_t getChunkCount() const;
+
+    /**
+     * Deserializes the next chunk entry.
+     *
+     * Not thread-safe.
+     *
+     * @return true if successful. false if there are no entries left, or the
+     *         entry failed to deserialize.
+     */
+    bool readChunkEntry(ChunkPosition& outChunkPosition,
+                        ChunkSnapshot& outChunkSnapshot);
+
+    /**
+     * Returns true if every entry has been read.
+     */
+    bool isAtEnd() const;
+
+    /**
+     * Returns the serialized data of the last entry that was read, as it
+     * appears in the file. Useful for copying unmodified entries.
+     *
+     * Invalidated when the file is closed.
+     */
+    std::span<const Uint8> getLastEntryData() const;
+
+private:
+    MappedFile mappedFile;
+
+    Uint16 version;
+    Uint16 xLengthChunks;
+    Uint16 yLengthChunks;
+    Uint16 zLengthChunks;
+    std::size_t chunkCount;
+
+    /** The number of entries that have been read. */
+    std::size_t readCount;
+
+    /** The file offset of the next entry. */
+    std::size_t readOffset;
+
+    /** The file offset of the last entry that was read. */
+    std::size_t lastEntryOffset;
+};
+
+} // End namespace AM
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "ChunkPosition.h"
+#include "TileMapSnapshot.h"
+#include "OrderedWriteBuffer.h"
+#include <SDL_stdinc.h>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace AM
+{
+/**
+ * Writes a tile map file one chunk at a time, without holding the whole
+ * TileMapSnapshot in memory.
+ *
+ * The output is byte-identical to serializing the equivalent
+ * TileMapSnapshot, so the engine can load it as usual.
+ *
+ * Chunks may be generated on multiple threads. Each thread serializes its
+ * chunk into its own buffer, then hands it to writeChunkEntry(). Entries are
+ * written in index order, so the output doesn't depend on thread timing.
+ * Threads that get too far ahead of the oldest unwritten entry will block, so
+ * memory use stays flat regardless of the map size.
+ */
+class TileMapStreamWriter
+{
+public:
+    /**
+     * Opens the given file and writes the map header.
+     *
+     * @param chunkCount The number of chunks that will be written. Must be
+     *                   known up front, since it precedes the chunks.
+     * @param maxBufferedEntries How many entries may be waiting to be
+     *                           written before threads block.
+     */
+    TileMapStreamWriter(const std::string& filePath, Uint16 version,
+                        Uint16 xLengthChunks, Uint16 yLengthChunks,
+                        Uint16 zLengthChunks, std::size_t chunkCount,
+                        std::size_t maxBufferedEntries);
+
+    /**
+     * Returns true if the file was successfully opened.
+     */
+    bool isOpen() const;
+
+    /**
+     * Serializes the given chunk and its position into the given buffer, in
+     * the same format as a TileMapSnapshot chunk entry.
+     * @return The number of bytes written.
+     */
+    static std::size_t serializeChunkEntry(ChunkPosition chunkPosition,
+                                           ChunkSnapshot& chunkSnapshot,
+                                           std::vector<Uint8>& buffer);
+
+    /**
+     * Writes the given serialized chunk entry.
+     *
+     * If earlier entries haven't been written yet, this entry will be
+     * buffered until they are. If too many entries are buffered, blocks until
+     * there's room.
+     *
+     * Thread-safe.
+     *
+     * @param entryIndex This entry's index, in [0, chunkCount).
+     */
+    void writeChunkEntry(std::size_t entryIndex,
+                         std::vector<Uint8> entryData);
+
+    /**
+     * Flushes and closes the file.
+     * @return true if every chunk was written successfully, else false.
+     */
+    bool finish();
+
+private:
+    std::ofstream file;
+
+    /** The number of chunks that we expect to be written. */
+    std::size_t chunkCount;
+
+    /** Puts entries back in order before they're written to the file. */
+    OrderedWriteBuffer<std::vector<Uint8>> entryBuffer;
+};
+
+} // End namespace AM
@@ -0,0 +1,162 @@
+#pragma once
+
+#include "PersistedDuration.h"
+#include "bitsery/bitsery.h"
+#include "bitsery/adapter/buffer.h"
+#include "bitsery/traits/vector.h"
+#include "bitsery/ext/std_variant.h"
+#include <SDL_stdinc.h>
+#include <variant>
+#include <vector>
+
+/**
+ * Mirrors of each version of the project's persisted component encoding.
+ *
+ * The real components pull in server engine headers, and only ever match the
+ * latest version. These mirrors only hold the persisted fields, so we can
+ * decode an old version and re-encode it as the new one.
+ *
+ * Note: The variant type order must match ProjectPersistedComponentTypes for
+ *       each version.
+ */
+namespace AM
+{
+namespace MPC
+{
+
+/** The number of component types in each version's type list. */
+static constexpr std::size_t COMPONENT_TYPE_COUNT{2};
+
+//-----------------------------------------------------------------------------
+// Version 0
+//-----------------------------------------------------------------------------
+namespace V0
+{
+struct RandomWalkerAI {
+    double timeToWalk{};
+    double timeToWait{};
+    double timeTillDirectionChange{};
+};
+
+template<typename S>
+void serialize(S& serializer, RandomWalkerAI& randomWalkerAI)
+{
+    serializer.value8b(randomWalkerAI.timeToWalk);
+    serializer.value8b(randomWalkerAI.timeToWait);
+    serializer.value8b(randomWalkerAI.timeTillDirectionChange);
+}
+
+struct NoEdit {
+};
+
+template<typename S>
+void serialize(S&, NoEdit&)
+{
+}
+
+using Component = std::variant<RandomWalkerAI, NoEdit>;
+
+template<typename S>
+void serialize(S& serializer, std::vector<Component>& components)
+{
+    serializer.enableBitPacking([&](typename S::BPEnabledType& sbp) {
+        sbp.container(components, COMPONENT_TYPE_COUNT,
+                      [](typename S::BPEnabledType& serializer,
+                         Component& component) {
+                          serializer.ext(component, bitsery::ext::StdVariant{});
+                      });
+    });
+}
+} // namespace V0
+
+//-----------------------------------------------------------------------------
+// Version 1
+//-----------------------------------------------------------------------------
+namespace V1
+{
+struct RandomWalkerAI {
+    double timeToWalk{};
+    double timeToWait{};
+    double timeTillDirectionChange{};
+};
+
+template<typename S>
+void serialize(S& serializer, RandomWalkerAI& randomWalkerAI)
+{
+    Server::serializePersistedDuration(serializer, randomWalkerAI.timeToWalk);
+    Server::serializePersistedDuration(serializer, randomWalkerAI.timeToWait);
+    Server::serializePersistedDuration(serializer,
+                                       randomWalkerAI.timeTillDirectionChange);
+}
+
+struct NoEdit {
+};
+
+template<typename S>
+void serialize(S&, NoEdit&)
+{
+}
+
+using Component = std::variant<RandomWalkerAI, NoEdit>;
+
+template<typename S>
+void serialize(S& serializer, std::vector<Component>& components)
+{
+    serializer.enableBitPacking([&](typename S::BPEnabledType& sbp) {
+        sbp.container(components, COMPONENT_TYPE_COUNT,
+                      [](typename S::BPEnabledType& serializer,
+                         Component& component) {
+                          serializer.ext(component, bitsery::ext::StdVariant{});
+                      });
+    });
+}
+
+/**
+ * Converts the given version 0 components to version 1.
+ */
+inline std::vector<Component>
+    fromV0(const std::vector<V0::Component>& oldComponents)
+{
+    std::vector<Component> components{};
+    for (const V0::Component& oldComponent : oldComponents) {
+        if (const auto* randomWalkerAI{
+                std::get_if<V0::RandomWalkerAI>(&oldComponent)}) {
+            components.emplace_back(RandomWalkerAI{
+                randomWalkerAI->timeToWalk, randomWalkerAI->timeToWait,
+                randomWalkerAI->timeTillDirectionChange});
+        }
+        else {
+            components.emplace_back(NoEdit{});
+        }
+    }
+
+    return components;
+}
+} // namespace V1
+
+/**
+ * Serializes the given components into the given buffer.
+ * @return The number of bytes written.
+ */
+template<typename T>
+std::size_t encode(std::vector<T>& components, std::vector<Uint8>& buffer)
+{
+    using OutputAdapter = bitsery::OutputBufferAdapter<std::vector<Uint8>>;
+    return bitsery::quickSerialization(OutputAdapter{buffer}, components);
+}
+
+/**
+ * Deserializes the given data into the given components.
+ * @return true if successful, else false.
+ */
+template<typename T>
+bool decode(const Uint8* data, std::size_t size, std::vector<T>& components)
+{
+    using InputAdapter = bitsery::InputBufferAdapter<const Uint8*>;
+    auto state{bitsery::quickDeserialization(InputAdapter{data, size},
+                                             components)};
+    return (state.first == bitsery::ReaderError::NoError) && state.second;
+}
+
+} // namespace MPC
+} // namespace AM
@@ -0,0 +1,354 @@
+#include "ComponentEncodings.h"
+#include "Timer.h"
+#include "Log.h"
+#include "SQLiteCpp/Database.h"
+#include "SQLiteCpp/Statement.h"
+#include "SQLiteCpp/Transaction.h"
+
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace AM;
+using namespace AM::MPC;
+
+/** The version that this tool migrates from. */
+static constexpr int SOURCE_VERSION{0};
+
+/** The version that this tool migrates to. */
+static constexpr int TARGET_VERSION{1};
+
+/**
+ * Size and decode time totals for a set of entities, in both encodings.
+ */
+struct EncodingStats {
+    std::size_t entityCount{0};
+    std::size_t oldBytes{0};
+    std::size_t newBytes{0};
+    double oldDecodeTime{0};
+    double newDecodeTime{0};
+};
+
+/**
+ * Database file size and load time for a set of entities, in both encodings.
+ */
+struct DatabaseStats {
+    std::uintmax_t oldFileSize{0};
+    std::uintmax_t newFileSize{0};
+    double oldLoadTime{0};
+    double newLoadTime{0};
+};
+
+void printUsage()
+{
+    std::printf("Usage: MigrateProjectComponents.exe <DatabasePath>\n"
+                "  Migrates the database's persisted project components from "
+                "version %d to version %d.\n"
+                "Usage: MigrateProjectComponents.exe --benchmark <NpcCount>\n"
+                "  Compares the blob size, database size, decode time, and "
+                "database load time of both versions on generated NPC "
+                "data.\n",
+                SOURCE_VERSION, TARGET_VERSION);
+    std::fflush(stdout);
+}
+
+void printStats(const EncodingStats& stats)
+{
+    std::printf("Entities:      %zu\n", stats.entityCount);
+    std::printf("Version %d:     %zu bytes, %.3fms to decode\n",
+                SOURCE_VERSION, stats.oldBytes, (stats.oldDecodeTime * 1000.0));
+    std::printf("Version %d:     %zu bytes, %.3fms to decode\n",
+                TARGET_VERSION, stats.newBytes, (stats.newDecodeTime * 1000.0));
+    if (stats.oldBytes > 0) {
+        std::printf("Size ratio:    %.1f%%\n",
+                    (100.0 * stats.newBytes / stats.oldBytes));
+    }
+    std::fflush(stdout);
+}
+
+void printDatabaseStats(const DatabaseStats& stats)
+{
+    std::printf("Version %d DB:  %ju bytes, %.3fms to load\n", SOURCE_VERSION,
+                stats.oldFileSize, (stats.oldLoadTime * 1000.0));
+    std::printf("Version %d DB:  %ju bytes, %.3fms to load\n", TARGET_VERSION,
+                stats.newFileSize, (stats.newLoadTime * 1000.0));
+    if (stats.oldFileSize > 0) {
+        std::printf("DB size ratio: %.1f%%\n",
+                    (100.0 * stats.newFileSize / stats.oldFileSize));
+    }
+    std::fflush(stdout);
+}
+
+/**
+ * Writes the given blobs to a new database at the given path, in the same
+ * table layout that the engine uses.
+ * @return The database file's size, in bytes.
+ */
+std::uintmax_t
+    writeBenchmarkDatabase(const std::string& databasePath,
+                           const std::vector<std::vector<Uint8>>& blobs)
+{
+    std::filesystem::remove(databasePath);
+    {
+        SQLite::Database database{databasePath, (SQLite::OPEN_READWRITE
+                                                 | SQLite::OPEN_CREATE)};
+        database.exec("CREATE TABLE entities (id INTEGER PRIMARY KEY, "
+                      "serializedProjectComponents BLOB)");
+
+        SQLite::Transaction transaction{database};
+        SQLite::Statement insertQuery{
+            database, "INSERT INTO entities VALUES (?, ?)"};
+        for (std::size_t i{0}; i < blobs.size(); ++i) {
+            insertQuery.bind(1, static_cast<Sint64>(i));
+            insertQuery.bind(2, blobs[i].data(),
+                             static_cast<int>(blobs[i].size()));
+            insertQuery.exec();
+            insertQuery.reset();
+        }
+        transaction.commit();
+    }
+
+    return std::filesystem::file_size(databasePath);
+}
+
+/**
+ * Reads and decodes every entity's components from the database at the
+ * given path, like the engine does when it loads.
+ * @return The time that it took, in seconds.
+ */
+template<typename T>
+double loadBenchmarkDatabase(const std::string& databasePath)
+{
+    Timer timer{};
+    SQLite::Database database{databasePath, SQLite::OPEN_READONLY};
+    SQLite::Statement selectQuery{
+        database, "SELECT serializedProjectComponents FROM entities"};
+    std::vector<T> components{};
+    while (selectQuery.executeStep()) {
+        SQLite::Column blobColumn{selectQuery.getColumn(0)};
+        components.clear();
+        if (!decode(static_cast<const Uint8*>(blobColumn.getBlob()),
+                    static_cast<std::size_t>(blobColumn.getBytes()),
+                    components)) {
+            LOG_FATAL("Failed to decode benchmark components.");
+        }
+    }
+
+    return timer.getTime();
+}
+
+/**
+ * Re-encodes each of the given version 0 blobs as version 1, recording the
+ * sizes and decode times of both.
+ */
+void reencodeBlobs(const std::vector<std::vector<Uint8>>& oldBlobs,
+                   std::vector<std::vector<Uint8>>& newBlobs,
+                   EncodingStats& stats)
+{
+    // Decode all of the old blobs.
+    std::vector<std::vector<V0::Component>> oldComponents(oldBlobs.size());
+    Timer timer{};
+    for (std::size_t i{0}; i < oldBlobs.size(); ++i) {
+        if (!decode(oldBlobs[i].data(), oldBlobs[i].size(),
+                    oldComponents[i])) {
+            LOG_FATAL("Failed to decode version %d components.",
+                      SOURCE_VERSION);
+        }
+    }
+    stats.oldDecodeTime = timer.getTime();
+
+    // Re-encode them.
+    std::vector<Uint8> buffer{};
+    newBlobs.resize(oldBlobs.size());
+    for (std::size_t i{0}; i < oldBlobs.size(); ++i) {
+        std::vector<V1::Component> components{V1::fromV0(oldComponents[i])};
+        std::size_t size{encode(components, buffer)};
+        newBlobs[i].assign(buffer.begin(), (buffer.begin() + size));
+
+        stats.oldBytes += oldBlobs[i].size();
+        stats.newBytes += size;
+    }
+
+    // Decode the new blobs, to compare load times.
+    std::vector<V1::Component> newComponents{};
+    timer.reset();
+    for (const std::vector<Uint8>& newBlob : newBlobs) {
+        newComponents.clear();
+        if (!decode(newBlob.data(), newBlob.size(), newComponents)) {
+            LOG_FATAL("Failed to decode version %d components.",
+                      TARGET_VERSION);
+        }
+    }
+    stats.newDecodeTime = timer.getTime();
+    stats.entityCount = oldBlobs.size();
+}
+
+/**
+ * Generates the given number of NPCs with random walker timings, and prints
+ * how the two encodings compare.
+ */
+int runBenchmark(std::size_t npcCount)
+{
+    // Generate timings in the range that the project uses (whole
+    // milliseconds, under a minute).
+    std::mt19937 generator{0};
+    std::uniform_int_distribution<int> millisecondDistribution{100, 60000};
+
+    std::vector<std::vector<Uint8>> oldBlobs(npcCount);
+    std::vector<Uint8> buffer{};
+    for (std::vector<Uint8>& oldBlob : oldBlobs) {
+        std::vector<V0::Component> components{};
+        components.emplace_back(V0::RandomWalkerAI{
+            millisecondDistribution(generator) / 1000.0,
+            millisecondDistribution(generator) / 1000.0,
+            millisecondDistribution(generator) / 1000.0});
+        std::size_t size{encode(components, buffer)};
+        oldBlob.assign(buffer.begin(), (buffer.begin() + size));
+    }
+
+    std::vector<std::vector<Uint8>> newBlobs{};
+    EncodingStats stats{};
+    reencodeBlobs(oldBlobs, newBlobs, stats);
+    printStats(stats);
+
+    // Compare the database file sizes and load times.
+    std::filesystem::path tempDir{std::filesystem::temp_directory_path()};
+    std::string oldDatabasePath{
+        (tempDir / "MigrateProjectComponentsV0.db3").string()};
+    std::string newDatabasePath{
+        (tempDir / "MigrateProjectComponentsV1.db3").string()};
+    DatabaseStats databaseStats{};
+    try {
+        databaseStats.oldFileSize
+            = writeBenchmarkDatabase(oldDatabasePath, oldBlobs);
+        databaseStats.newFileSize
+            = writeBenchmarkDatabase(newDatabasePath, newBlobs);
+        databaseStats.oldLoadTime
+            = loadBenchmarkDatabase<V0::Component>(oldDatabasePath);
+        databaseStats.newLoadTime
+            = loadBenchmarkDatabase<V1::Component>(newDatabasePath);
+    } catch (SQLite::Exception& e) {
+        std::printf("Database benchmark failed: %s\n", e.what());
+        return 1;
+    }
+    std::filesystem::remove(oldDatabasePath);
+    std::filesystem::remove(newDatabasePath);
+    printDatabaseStats(databaseStats);
+
+    return 0;
+}
+
+/**
+ * Migrates the database at the given path from SOURCE_VERSION to
+ * TARGET_VERSION.
+ */
+int migrateDatabase(const std::string& databasePath)
+{
+    std::uintmax_t oldFileSize{std::filesystem::file_size(databasePath)};
+    EncodingStats stats{};
+    try {
+        SQLite::Database database{databasePath, SQLite::OPEN_READWRITE};
+
+        // Check that the database is at the version we migrate from.
+        int version{database
+                        .execAndGet(
+                            "SELECT projectComponentsVersion FROM versions")
+                        .getInt()};
+        if (version == TARGET_VERSION) {
+            std::printf("Database is already at version %d.\n",
+                        TARGET_VERSION);
+            return 0;
+        }
+        else if (version != SOURCE_VERSION) {
+            std::printf("Database is at version %d, expected %d.\n", version,
+                        SOURCE_VERSION);
+            return 1;
+        }
+
+        SQLite::Transaction transaction{database};
+
+        // Read every entity's components.
+        std::vector<Sint64> entityIDs{};
+        std::vector<std::vector<Uint8>> oldBlobs{};
+        SQLite::Statement selectQuery{
+            database, "SELECT id, serializedProjectComponents FROM entities"};
+        std::size_t skippedCount{0};
+        while (selectQuery.executeStep()) {
+            // Entities without any project components may have a NULL (or
+            // empty) blob. There's nothing to migrate, so skip them.
+            SQLite::Column blobColumn{selectQuery.getColumn(1)};
+            if (blobColumn.isNull() || (blobColumn.getBytes() == 0)) {
+                skippedCount++;
+                continue;
+            }
+
+            const Uint8* blob{static_cast<const Uint8*>(blobColumn.getBlob())};
+            entityIDs.push_back(selectQuery.getColumn(0).getInt64());
+            oldBlobs.emplace_back(blob, (blob + blobColumn.getBytes()));
+        }
+
+        if (skippedCount > 0) {
+            std::printf("Skipped %zu entities with no components.\n",
+                        skippedCount);
+        }
+
+        // Re-encode them.
+        std::vector<std::vector<Uint8>> newBlobs{};
+        reencodeBlobs(oldBlobs, newBlobs, stats);
+
+        // Write them back.
+        SQLite::Statement updateQuery{database,
+                                      "UPDATE entities SET "
+                                      "serializedProjectComponents = ? WHERE "
+                                      "id = ?"};
+        for (std::size_t i{0}; i < entityIDs.size(); ++i) {
+            updateQuery.bind(1, newBlobs[i].data(),
+                             static_cast<int>(newBlobs[i].size()));
+            updateQuery.bind(2, entityIDs[i]);
+            updateQuery.exec();
+            updateQuery.reset();
+        }
+
+        SQLite::Statement versionQuery{
+            database, "UPDATE versions SET projectComponentsVersion = ?"};
+        versionQuery.bind(1, TARGET_VERSION);
+        versionQuery.exec();
+
+        transaction.commit();
+
+        // Reclaim the freed space.
+        database.exec("VACUUM");
+    } catch (SQLite::Exception& e) {
+        std::printf("Migration failed: %s\n", e.what());
+        return 1;
+    }
+
+    std::printf("Migrated database to version %d.\n", TARGET_VERSION);
+    printStats(stats);
+    std::printf("Database file: %ju -> %ju bytes\n", oldFileSize,
+                std::filesystem::file_size(databasePath));
+
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    if ((argc == 3) && (std::string{argv[1]} == "--benchmark")) {
+        char* end;
+        long npcCount{std::strtol(argv[2], &end, 10)};
+        if ((*end != '\0') || (npcCount < 1)) {
+            std::printf("Invalid NPC count.\n");
+            printUsage();
+            return 1;
+        }
+
+        return runBenchmark(static_cast<std::size_t>(npcCount));
+    }
+    else if (argc == 2) {
+        return migrateDatabase(argv[1]);
+    }
+
+    printUsage();
+    return 1;
+}
@@ -0,0 +1,137 @@
+#include "MapRewriter.h"
+#include "TileMapStreamWriter.h"
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace AM
+{
+namespace RS
+{
+MapRewriter::MapRewriter(
+    const std::unordered_map<std::string, std::string>& inIDMapping,
+    unsigned int inThreadCount)
+: idMapping{inIDMapping}
+, threadCount{std::max(inThreadCount, 1U)}
+, reader{nullptr}
+, readerMutex{}
+, nextEntryIndex{0}
+, readFailed{false}
+, replacedCount{0}
+, rewrittenChunkCount{0}
+{
+}
+
+bool MapRewriter::rewrite(TileMapStreamReader& inReader,
+                          const std::string& outputPath)
+{
+    reader = &inReader;
+    nextEntryIndex = 0;
+    readFailed = false;
+    replacedCount = 0;
+    rewrittenChunkCount = 0;
+
+    TileMapStreamWriter writer{outputPath,
+                               reader->getVersion(),
+                               reader->getXLengthChunks(),
+                               reader->getYLengthChunks(),
+                               reader->getZLengthChunks(),
+                               reader->getChunkCount(),
+                               (threadCount * BUFFERED_CHUNKS_PER_THREAD)};
+    if (!(writer.isOpen())) {
+        return false;
+    }
+
+    // Rewrite the chunks, using this thread as one of the workers.
+    std::vector<std::thread> workerThreads{};
+    for (unsigned int i{1}; i < threadCount; ++i) {
+        workerThreads.emplace_back(&MapRewriter::rewriteChunks, this,
+                                   std::ref(writer));
+    }
+    rewriteChunks(writer);
+    for (std::thread& workerThread : workerThreads) {
+        workerThread.join();
+    }
+
+    reader = nullptr;
+    return writer.finish() && !readFailed;
+}
+
+std::size_t MapRewriter::getReplacedCount() const
+{
+    return replacedCount;
+}
+
+std::size_t MapRewriter::getRewrittenChunkCount() const
+{
+    return rewrittenChunkCount;
+}
+
+void MapRewriter::rewriteChunks(TileMapStreamWriter& writer)
+{
+    ChunkPosition chunkPosition{};
+    ChunkSnapshot chunkSnapshot{};
+    std::vector<Uint8> buffer{};
+    while (true) {
+        // Read the next entry.
+        // Note: Entries have to be read in order, since their sizes aren't
+        //       known until they're deserialized.
+        std::size_t entryIndex{0};
+        bool chunkWasRewritten{false};
+        {
+            std::scoped_lock lock{readerMutex};
+            if (readFailed || (nextEntryIndex == reader->getChunkCount())) {
+                return;
+            }
+
+            chunkSnapshot = ChunkSnapshot{};
+            if (!(reader->readChunkEntry(chunkPosition, chunkSnapshot))) {
+                readFailed = true;
+                return;
+            }
+            entryIndex = nextEntryIndex++;
+
+            // If nothing in this chunk needs to change, copy it as-is.
+            // Note: This is done under the lock, since the entry data is
+            //       only valid until the next read.
+            std::size_t chunkReplacedCount{rewritePalette(chunkSnapshot)};
+            chunkWasRewritten = (chunkReplacedCount > 0);
+            if (chunkWasRewritten) {
+                replacedCount += chunkReplacedCount;
+                rewrittenChunkCount++;
+            }
+            else {
+                std::span<const Uint8> entryData{reader->getLastEntryData()};
+                buffer.assign(entryData.begin(), entryData.end());
+            }
+        }
+
+        // If the chunk changed, re-serialize it.
+        std::size_t entrySize{buffer.size()};
+        if (chunkWasRewritten) {
+            entrySize = TileMapStreamWriter::serializeChunkEntry(
+                chunkPosition, chunkSnapshot, buffer);
+        }
+
+        writer.writeChunkEntry(
+            entryIndex, std::vector<Uint8>(buffer.begin(),
+                                           (buffer.begin() + entrySize)));
+    }
+}
+
+std::size_t MapRewriter::rewritePalette(ChunkSnapshot& chunkSnapshot) const
+{
+    std::size_t chunkReplacedCount{0};
+    for (ChunkSnapshot::PaletteEntry& paletteEntry : chunkSnapshot.palette) {
+        auto it{idMapping.find(paletteEntry.graphicSetID)};
+        if (it != idMapping.end()) {
+            paletteEntry.graphicSetID = it->second;
+            chunkReplacedCount++;
+        }
+    }
+
+    return chunkReplacedCount;
+}
+
+} // End namespace RS
+} // End namespace AM
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "TileMapStreamReader.h"
+#include "TileMapSnapshot.h"
+#include <SDL_stdinc.h>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace AM
+{
+class TileMapStreamWriter;
+
+namespace RS
+{
+/**
+ * Rewrites the graphic set IDs in a tile map's chunk palettes.
+ *
+ * Chunks are streamed from the input map, rewritten on multiple threads, and
+ * streamed to the output map, so the whole map is never held in memory.
+ */
+class MapRewriter
+{
+public:
+    /**
+     * @param inIDMapping Maps graphic set IDs to the IDs to replace them with.
+     */
+    MapRewriter(
+        const std::unordered_map<std::string, std::string>& inIDMapping,
+        unsigned int inThreadCount);
+
+    /**
+     * Rewrites every chunk in the given map and writes the result to the
+     * given path.
+     *
+     * @return true if successful, else false.
+     */
+    bool rewrite(TileMapStreamReader& inReader, const std::string& outputPath);
+
+    /**
+     * Returns the number of palette entries that were replaced by the last
+     * call to rewrite().
+     */
+    std::size_t getReplacedCount() const;
+
+    /**
+     * Returns the number of chunks that had at least one palette entry
+     * replaced by the last call to rewrite().
+     */
+    std::size_t getRewrittenChunkCount() const;
+
+private:
+    /** How many rewritten chunks each thread may have waiting to be written
+        before it blocks. */
+    static constexpr std::size_t BUFFERED_CHUNKS_PER_THREAD{4};
+
+    /**
+     * Thread function. Reads, rewrites, and writes chunks until there are
+     * none left.
+     */
+    void rewriteChunks(TileMapStreamWriter& writer);
+
+    /**
+     * Replaces any mapped IDs in the given chunk's palette.
+     * @return The number of entries that were replaced.
+     */
+    std::size_t rewritePalette(ChunkSnapshot& chunkSnapshot) const;
+
+    /** Maps graphic set IDs to the IDs to replace them with. */
+    const std::unordered_map<std::string, std::string>& idMapping;
+
+    /** The number of threads to rewrite chunks on. */
+    unsigned int threadCount;
+
+    /** The map that we're currently rewriting. */
+    TileMapStreamReader* reader;
+
+    /** Guards reader. Entries must be read in order. */
+    std::mutex readerMutex;
+
+    /** The index of the next entry to read. Guarded by readerMutex. */
+    std::size_t nextEntryIndex;
+
+    /** If true, an entry failed to read and the remaining entries will be
+        skipped. */
+    std::atomic<bool> readFailed;
+
+    std::atomic<std::size_t> replacedCount;
+    std::atomic<std::size_t> rewrittenChunkCount;
+};
+
+} // End namespace RS
+} // End namespace AM
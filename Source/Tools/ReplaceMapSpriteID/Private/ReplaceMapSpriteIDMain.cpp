@@ -1,66 +1,156 @@
-#include "TileMapSnapshot.h"
-#include "Serialize.h"
-#include "Deserialize.h"
-#include "Log.h"
+#include "MapRewriter.h"
+#include "TileMapStreamReader.h"
+#include "TempFile.h"
+#include "Timer.h"
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <unordered_map>
 
 using namespace AM;
+using namespace AM::RS;
 
-// TODO: Either delete this, or refactor it to work with the tile map changes.
 void printUsage()
 {
-    std::printf("Usage: ReplaceMapSpriteID.exe <TileMapPath> "
-                "<SpriteIDToReplace> <NewSpriteID>\n"
-                "  Finds all occurences of SpriteIDToReplace in the given map "
-                "and replaces them with NewSpriteID.\n");
+    std::printf(
+        "Usage: ReplaceMapSpriteID.exe <TileMapPath> <MappingFilePath> "
+        "[--threads <Count>] [--output <OutputPath>]\n"
+        "  Replaces graphic set IDs in every chunk palette of the given map.\n"
+        "  Each line of the mapping file is an old ID and the new ID to "
+        "replace it with, separated by whitespace. Blank lines and lines "
+        "starting with '#' are ignored.\n"
+        "  The map is rewritten in place unless an output path is given. If "
+        "any chunk fails to rewrite, the original map is kept.\n");
     std::fflush(stdout);
 }
 
-//int main(int argc, char** argv)
-int main(int, char**)
+/**
+ * Loads the old -> new graphic set ID mapping from the given file.
+ * @return true if successful, else false.
+ */
+bool loadIDMapping(const std::string& filePath,
+                   std::unordered_map<std::string, std::string>& outIDMapping)
 {
-    // if (argc != 4) {
-    //     std::printf("Too few arguments.\n");
-    //     printUsage();
-    //     return 1;
-    // }
+    std::ifstream file{filePath};
+    if (!(file.is_open())) {
+        std::printf("Failed to open mapping file: %s\n", filePath.c_str());
+        return false;
+    }
 
-    //// Try to deserialize the map file into a snapshot.
-    // TileMapSnapshot mapSnapshot;
-    // std::string filePath{argv[1]};
-    // if (!Deserialize::fromFile(filePath, mapSnapshot)) {
-    //     LOG_FATAL("Failed to deserialize map at path: %s", filePath.c_str());
-    // }
+    std::string line{};
+    int lineNumber{0};
+    while (std::getline(file, line)) {
+        lineNumber++;
 
-    //// Find and replace all occurrences.
-    // std::string spriteIDToReplace{argv[2]};
-    // std::string newSpriteID{argv[3]};
-    // int replaceCount{0};
-    // for (ChunkSnapshot& chunk : mapSnapshot.chunks) {
-    //     for (std::string& spriteID : chunk.palette) {
-    //         if (spriteID == spriteIDToReplace) {
-    //             spriteID = newSpriteID;
-    //             replaceCount++;
-    //         }
-    //     }
-    // }
+        // Skip blank lines and comments.
+        std::istringstream lineStream{line};
+        std::string oldID{};
+        std::string newID{};
+        std::string extra{};
+        if (!(lineStream >> oldID) || oldID.starts_with('#')) {
+            continue;
+        }
 
-    //// If we replaced any occurrences, try to save the map.
-    // if (replaceCount > 0) {
-    //     bool saveSuccessful{Serialize::toFile(filePath, mapSnapshot)};
-    //     if (saveSuccessful) {
-    //         LOG_INFO("Found and replaced the given ID in %d palettes.",
-    //                  replaceCount);
-    //     }
-    //     else {
-    //         LOG_INFO("Failed to serialize and save the map.");
-    //     }
-    // }
-    // else {
-    //     LOG_INFO("The given ID was not found in the given map.");
-    // }
+        if (!(lineStream >> newID) || (lineStream >> extra)) {
+            std::printf("Invalid mapping on line %d. Expected: <OldID> "
+                        "<NewID>\n",
+                        lineNumber);
+            return false;
+        }
+        else if (!(outIDMapping.try_emplace(oldID, newID).second)) {
+            std::printf("Duplicate mapping for \"%s\" on line %d.\n",
+                        oldID.c_str(), lineNumber);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3) {
+        printUsage();
+        return 1;
+    }
+
+    std::string mapPath{argv[1]};
+    std::string mappingPath{argv[2]};
+    std::string outputPath{mapPath};
+    unsigned int threadCount{
+        std::max(std::thread::hardware_concurrency(), 1U)};
+    for (int i{3}; i < argc; ++i) {
+        int remainingArgs{argc - i - 1};
+        if ((std::strcmp(argv[i], "--threads") == 0)
+            && (remainingArgs >= 1)) {
+            int count{std::atoi(argv[++i])};
+            if ((count < 1) || (count > 256)) {
+                std::printf("Invalid thread count.\n");
+                return 1;
+            }
+            threadCount = static_cast<unsigned int>(count);
+        }
+        else if ((std::strcmp(argv[i], "--output") == 0)
+                 && (remainingArgs >= 1)) {
+            outputPath = argv[++i];
+        }
+        else {
+            std::printf("Unknown or incomplete argument: %s\n", argv[i]);
+            printUsage();
+            return 1;
+        }
+    }
+
+    std::unordered_map<std::string, std::string> idMapping{};
+    if (!loadIDMapping(mappingPath, idMapping)) {
+        return 1;
+    }
+    else if (idMapping.empty()) {
+        std::printf("The mapping file is empty.\n");
+        return 1;
+    }
+
+    Timer timer{};
+    TileMapStreamReader reader{};
+    if (!(reader.open(mapPath))) {
+        std::printf("Failed to open map at path: %s\n", mapPath.c_str());
+        return 1;
+    }
+
+    // Rewrite the map, then swap it in over the output.
+    // Note: The reader is closed before the swap, since the output may be
+    //       the map that it has open.
+    MapRewriter mapRewriter{idMapping, threadCount};
+    std::error_code errorCode{};
+    TempFile::Result result{TempFile::writeAndReplace(
+        outputPath,
+        [&](const std::string& tempPath) {
+            bool rewriteSuccessful{mapRewriter.rewrite(reader, tempPath)};
+            reader.close();
+            return rewriteSuccessful;
+        },
+        errorCode)};
+    if (result == TempFile::Result::WriteFailed) {
+        std::printf("Failed to rewrite the map. It has not been modified.\n");
+        return 1;
+    }
+    else if (result == TempFile::Result::ReplaceFailed) {
+        std::printf("Failed to replace %s: %s\n", outputPath.c_str(),
+                    errorCode.message().c_str());
+        return 1;
+    }
+
+    std::printf("Replaced %zu palette entries in %zu of %zu chunks, on %u "
+                "threads, in %.3fs.\n",
+                mapRewriter.getReplacedCount(),
+                mapRewriter.getRewrittenChunkCount(), reader.getChunkCount(),
+                threadCount, timer.getTime());
+    std::fflush(stdout);
 
     return 0;
 }